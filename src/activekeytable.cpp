@@ -0,0 +1,302 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QMutexLocker>
+#include <QHashIterator>
+
+#include "activekeytable.h"
+
+// Codes below 0x10000 cover Windows virtual keys, uinput key codes and
+// the common X11 keysyms. The extra 256 entries hold the XF86 media
+// keysyms (0x1008FF00 - 0x1008FFFF).
+const unsigned int ActiveKeyTable::DEFAULTKEYTABLESIZE = 0x10000 + 0x100;
+const unsigned int ActiveKeyTable::DEFAULTMOUSETABLESIZE = 32;
+
+static const unsigned int XF86KEYSYMBASE = 0x1008FF00;
+static const unsigned int DIRECTCODELIMIT = 0x10000;
+
+ActiveKeyTable::ActiveKeyTable(unsigned int tableSize)
+{
+    this->tableSize = tableSize;
+    this->wordCount = (tableSize + 31) / 32;
+
+    counts = new QAtomicInt[tableSize];
+    aliases = new QAtomicInt[tableSize];
+    pressedBits = new QAtomicInt[wordCount];
+}
+
+ActiveKeyTable::~ActiveKeyTable()
+{
+    delete [] counts;
+    counts = 0;
+
+    delete [] aliases;
+    aliases = 0;
+
+    delete [] pressedBits;
+    pressedBits = 0;
+}
+
+int ActiveKeyTable::loadValue(QAtomicInt &value)
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    return value.load();
+#else
+    return value;
+#endif
+}
+
+/**
+ * @brief Find table index used for a native code.
+ * @param Native key code or mouse button code
+ * @return Table index or -1 if the code has to be stored in the
+ *     overflow hash.
+ */
+int ActiveKeyTable::indexForCode(unsigned int code)
+{
+    int result = -1;
+    if (code < DIRECTCODELIMIT)
+    {
+        if (code < tableSize)
+        {
+            result = static_cast<int>(code);
+        }
+    }
+    else if ((code & 0xFFFFFF00) == XF86KEYSYMBASE)
+    {
+        unsigned int temp = DIRECTCODELIMIT + (code & 0xFF);
+        if (temp < tableSize)
+        {
+            result = static_cast<int>(temp);
+        }
+    }
+
+    return result;
+}
+
+unsigned int ActiveKeyTable::codeForIndex(unsigned int index)
+{
+    unsigned int result = index;
+    if (index >= DIRECTCODELIMIT)
+    {
+        result = XF86KEYSYMBASE + (index - DIRECTCODELIMIT);
+    }
+
+    return result;
+}
+
+void ActiveKeyTable::setPressedBit(unsigned int index, bool pressed)
+{
+    QAtomicInt &word = pressedBits[index / 32];
+    int mask = static_cast<int>(1U << (index % 32));
+
+    bool done = false;
+    while (!done)
+    {
+        int oldvalue = loadValue(word);
+        int newvalue = pressed ? (oldvalue | mask) : (oldvalue & ~mask);
+        done = (oldvalue == newvalue) || word.testAndSetOrdered(oldvalue, newvalue);
+    }
+}
+
+/**
+ * @brief Add a reference to a code.
+ * @param Native key code or mouse button code
+ * @param Key alias used when the code was pressed
+ * @return Reference count after the increment
+ */
+int ActiveKeyTable::acquire(unsigned int code, unsigned int alias)
+{
+    int result = 0;
+    int index = indexForCode(code);
+    if (index >= 0)
+    {
+        result = counts[index].fetchAndAddOrdered(1) + 1;
+        if (result == 1)
+        {
+            aliases[index].fetchAndStoreRelaxed(static_cast<int>(alias));
+            setPressedBit(index, true);
+        }
+    }
+    else
+    {
+        QMutexLocker tempLocker(&overflowLock);
+        result = overflowCounts.value(code, 0) + 1;
+        overflowCounts.insert(code, result);
+        if (result == 1)
+        {
+            overflowAliases.insert(code, alias);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Remove a reference to a code. The count never goes below zero.
+ * @param Native key code or mouse button code
+ * @return Reference count remaining after the decrement. A value of zero
+ *     means that the release event should be sent.
+ */
+int ActiveKeyTable::release(unsigned int code)
+{
+    int result = 0;
+    int index = indexForCode(code);
+    if (index >= 0)
+    {
+        QAtomicInt &counter = counts[index];
+        bool done = false;
+        while (!done)
+        {
+            int oldvalue = loadValue(counter);
+            result = qMax(0, oldvalue - 1);
+            done = (oldvalue == result) || counter.testAndSetOrdered(oldvalue, result);
+        }
+
+        if (result == 0)
+        {
+            setPressedBit(index, false);
+        }
+    }
+    else
+    {
+        QMutexLocker tempLocker(&overflowLock);
+        result = overflowCounts.value(code, 1) - 1;
+        if (result <= 0)
+        {
+            result = 0;
+            overflowCounts.remove(code);
+            overflowAliases.remove(code);
+        }
+        else
+        {
+            overflowCounts.insert(code, result);
+        }
+    }
+
+    return result;
+}
+
+int ActiveKeyTable::count(unsigned int code)
+{
+    int result = 0;
+    int index = indexForCode(code);
+    if (index >= 0)
+    {
+        result = loadValue(counts[index]);
+    }
+    else
+    {
+        QMutexLocker tempLocker(&overflowLock);
+        result = overflowCounts.value(code, 0);
+    }
+
+    return result;
+}
+
+bool ActiveKeyTable::isPressed(unsigned int code)
+{
+    return count(code) > 0;
+}
+
+bool ActiveKeyTable::isEmpty()
+{
+    bool result = true;
+    for (unsigned int i=0; i < wordCount && result; i++)
+    {
+        if (loadValue(pressedBits[i]) != 0)
+        {
+            result = false;
+        }
+    }
+
+    if (result)
+    {
+        QMutexLocker tempLocker(&overflowLock);
+        result = overflowCounts.isEmpty();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Copy the pressed bitset. Codes stored in the overflow hash
+ *     are not part of the snapshot.
+ * @param Destination for the bitset words. Resized as needed.
+ */
+void ActiveKeyTable::snapshot(QVector<quint32> &bits)
+{
+    if (bits.size() != static_cast<int>(wordCount))
+    {
+        bits.resize(wordCount);
+    }
+
+    for (unsigned int i=0; i < wordCount; i++)
+    {
+        bits[i] = static_cast<quint32>(loadValue(pressedBits[i]));
+    }
+}
+
+/**
+ * @brief Clear every reference held in the table. Used to release any
+ *     outputs still held after all devices have been unloaded.
+ * @return Codes that were held along with the alias used to press them.
+ */
+QList<ActiveKeyTable::ActiveKeyEntry> ActiveKeyTable::takeAll()
+{
+    QList<ActiveKeyEntry> result;
+
+    for (unsigned int i=0; i < wordCount; i++)
+    {
+        quint32 word = static_cast<quint32>(pressedBits[i].fetchAndStoreOrdered(0));
+        while (word != 0)
+        {
+            unsigned int bit = 0;
+            while (((word >> bit) & 1U) == 0)
+            {
+                bit++;
+            }
+
+            word &= ~(1U << bit);
+
+            unsigned int index = (i * 32) + bit;
+            if (counts[index].fetchAndStoreOrdered(0) > 0)
+            {
+                ActiveKeyEntry entry;
+                entry.code = codeForIndex(index);
+                entry.alias = static_cast<unsigned int>(loadValue(aliases[index]));
+                result.append(entry);
+            }
+        }
+    }
+
+    QMutexLocker tempLocker(&overflowLock);
+    QHashIterator<unsigned int, int> iter(overflowCounts);
+    while (iter.hasNext())
+    {
+        iter.next();
+        ActiveKeyEntry entry;
+        entry.code = iter.key();
+        entry.alias = overflowAliases.value(iter.key(), 0);
+        result.append(entry);
+    }
+
+    overflowCounts.clear();
+    overflowAliases.clear();
+
+    return result;
+}
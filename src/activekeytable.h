@@ -0,0 +1,81 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACTIVEKEYTABLE_H
+#define ACTIVEKEYTABLE_H
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QVector>
+
+/**
+ * @brief Fixed size table of reference counts for native key and mouse
+ *     button codes that are currently held down by any button. Counters
+ *     are atomic so press and release can happen from any thread. A
+ *     pressed bit is kept for every code so the set of held outputs can
+ *     be snapshotted by scanning a few words.
+ */
+class ActiveKeyTable
+{
+public:
+    typedef struct _ActiveKeyEntry
+    {
+        unsigned int code;
+        unsigned int alias;
+    } ActiveKeyEntry;
+
+    explicit ActiveKeyTable(unsigned int tableSize);
+    ~ActiveKeyTable();
+
+    int acquire(unsigned int code, unsigned int alias=0);
+    int release(unsigned int code);
+    int count(unsigned int code);
+    bool isPressed(unsigned int code);
+    bool isEmpty();
+
+    void snapshot(QVector<quint32> &bits);
+    QList<ActiveKeyEntry> takeAll();
+
+    static const unsigned int DEFAULTKEYTABLESIZE;
+    static const unsigned int DEFAULTMOUSETABLESIZE;
+
+protected:
+    int indexForCode(unsigned int code);
+    unsigned int codeForIndex(unsigned int index);
+    void setPressedBit(unsigned int index, bool pressed);
+
+    static int loadValue(QAtomicInt &value);
+
+    unsigned int tableSize;
+    unsigned int wordCount;
+    QAtomicInt *counts;
+    QAtomicInt *aliases;
+    QAtomicInt *pressedBits;
+
+    // Codes that do not fit in the table. Should rarely be used.
+    QHash<unsigned int, int> overflowCounts;
+    QHash<unsigned int, unsigned int> overflowAliases;
+    QMutex overflowLock;
+
+private:
+    ActiveKeyTable(const ActiveKeyTable &other);
+    ActiveKeyTable& operator=(const ActiveKeyTable &other);
+};
+
+#endif // ACTIVEKEYTABLE_H
@@ -15,16 +15,49 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QEvent>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QMetaObject>
+#include <QHashIterator>
+
 #include "antimicrosettings.h"
 
 const bool AntiMicroSettings::defaultDisabledWinEnhanced = false;
 const bool AntiMicroSettings::defaultAssociateProfiles = true;
 const int AntiMicroSettings::defaultSpringScreen = -1;
 const unsigned int AntiMicroSettings::defaultSDLGamepadPollRate = 10;
+const int AntiMicroSettings::SYNCDELAY = 1000;
 
 AntiMicroSettings::AntiMicroSettings(const QString &fileName, Format format, QObject *parent) :
     QSettings(fileName, format, parent)
 {
+    syncTimer.setParent(this);
+    syncTimer.setSingleShot(true);
+    syncTimer.setInterval(SYNCDELAY);
+    connect(&syncTimer, SIGNAL(timeout()), this, SLOT(flushSettings()));
+
+    writerThread = new QThread();
+    writer = new SettingsWriter(this->fileName());
+    writer->moveToThread(writerThread);
+    connect(writerThread, SIGNAL(finished()), writer, SLOT(deleteLater()));
+    writerThread->start(QThread::LowPriority);
+
+    refreshCache();
+}
+
+AntiMicroSettings::~AntiMicroSettings()
+{
+    syncTimer.stop();
+
+    // Any snapshot that has not been written yet is superseded by the
+    // final sync done by QSettings on destruction.
+    writerThread->quit();
+    writerThread->wait();
+    writer = 0;
+
+    delete writerThread;
+    writerThread = 0;
 }
 
 /**
@@ -76,3 +109,136 @@ QMutex* AntiMicroSettings::getLock()
 {
     return &lock;
 }
+
+/**
+ * @brief Get a setting from the in-memory copy. Does not take the settings
+ *     lock so it is safe to use from the input thread. Changes made through
+ *     the QSettings interface become visible after the next flush.
+ * @param Full key path including any group
+ * @param Default value to use if key does not exist
+ * @return Stored value or the default value passed
+ */
+QVariant AntiMicroSettings::cachedValue(const QString &key, const QVariant &defaultValue)
+{
+    QReadLocker tempLocker(&cacheLock);
+    return cache.value(key, defaultValue);
+}
+
+bool AntiMicroSettings::cachedContains(const QString &key)
+{
+    QReadLocker tempLocker(&cacheLock);
+    return cache.contains(key);
+}
+
+/**
+ * @brief Get the keys stored in a group from the in-memory copy.
+ * @param Group name
+ * @return Keys relative to the group
+ */
+QStringList AntiMicroSettings::cachedGroupKeys(const QString &group)
+{
+    QStringList result;
+    QString prefix = QString(group).append("/");
+
+    QReadLocker tempLocker(&cacheLock);
+    QHashIterator<QString, QVariant> iter(cache);
+    while (iter.hasNext())
+    {
+        iter.next();
+        if (iter.key().startsWith(prefix))
+        {
+            result.append(iter.key().mid(prefix.length()));
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Rebuild the in-memory copy of the settings. The settings lock
+ *     must be held and no group can be active.
+ */
+void AntiMicroSettings::refreshCache()
+{
+    QHash<QString, QVariant> tempCache;
+    QStringList keys = allKeys();
+    QStringListIterator iter(keys);
+    while (iter.hasNext())
+    {
+        QString key = iter.next();
+        tempCache.insert(key, value(key));
+    }
+
+    QWriteLocker tempLocker(&cacheLock);
+    cache.swap(tempCache);
+}
+
+/**
+ * @brief Request that changed settings get written to disk. Multiple
+ *     requests made within SYNCDELAY ms are merged into one write.
+ */
+void AntiMicroSettings::scheduleSync()
+{
+    if (QThread::currentThread() != thread())
+    {
+        QMetaObject::invokeMethod(this, "scheduleSync", Qt::QueuedConnection);
+    }
+    else if (!syncTimer.isActive())
+    {
+        syncTimer.start();
+    }
+}
+
+/**
+ * @brief Update the in-memory copy and hand a snapshot to the writer
+ *     thread. Retried later if the settings are currently in use.
+ */
+void AntiMicroSettings::flushSettings()
+{
+    if (lock.tryLock())
+    {
+        if (group().isEmpty())
+        {
+            refreshCache();
+
+            QHash<QString, QVariant> snapshot;
+            cacheLock.lockForRead();
+            snapshot = cache;
+            cacheLock.unlock();
+
+            lock.unlock();
+
+            writer->queueSnapshot(snapshot);
+        }
+        else
+        {
+            lock.unlock();
+            syncTimer.start();
+        }
+    }
+    else
+    {
+        syncTimer.start();
+    }
+}
+
+/**
+ * @brief QSettings posts an update request to itself after a change in
+ *     order to write the file. Write through the debounced writer thread
+ *     instead.
+ */
+bool AntiMicroSettings::event(QEvent *event)
+{
+    bool result = false;
+    if (event->type() == QEvent::UpdateRequest)
+    {
+        scheduleSync();
+        result = true;
+    }
+    else
+    {
+        result = QSettings::event(event);
+    }
+
+    return result;
+}
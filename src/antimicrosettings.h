@@ -20,32 +20,57 @@
 
 #include <QSettings>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QHash>
+#include <QStringList>
+#include <QTimer>
+#include <QThread>
 
 #include "commandlineutility.h"
+#include "settingswriter.h"
 
 class AntiMicroSettings : public QSettings
 {
     Q_OBJECT
 public:
     explicit AntiMicroSettings(const QString &fileName, Format format, QObject *parent = 0);
+    ~AntiMicroSettings();
 
     QVariant runtimeValue(const QString &key, const QVariant &defaultValue = QVariant()) const;
     void importFromCommandLine(CommandLineUtility &cmdutility);
     QMutex* getLock();
 
+    QVariant cachedValue(const QString &key, const QVariant &defaultValue = QVariant());
+    bool cachedContains(const QString &key);
+    QStringList cachedGroupKeys(const QString &group);
+
     static const bool defaultDisabledWinEnhanced;
     static const bool defaultAssociateProfiles;
     static const int defaultSpringScreen;
     static const unsigned int defaultSDLGamepadPollRate;
+    static const int SYNCDELAY;
 
 protected:
+    virtual bool event(QEvent *event);
+    void refreshCache();
+
     QSettings cmdSettings;
     QMutex lock;
 
+    // Copy of every stored setting keyed by full key path. Read by the
+    // input thread without touching the QSettings object.
+    QHash<QString, QVariant> cache;
+    QReadWriteLock cacheLock;
+
+    QTimer syncTimer;
+    SettingsWriter *writer;
+    QThread *writerThread;
+
 signals:
 
 public slots:
-
+    void scheduleSync();
+    void flushSettings();
 };
 
 #endif // ANTIMICROSETTINGS_H
@@ -20,6 +20,7 @@
 #include <QDesktopWidget>
 
 #include "applaunchhelper.h"
+#include "eventhandlerfactory.h"
 
 #ifdef Q_OS_WIN
 #include <winextras.h>
@@ -42,6 +43,7 @@ void AppLaunchHelper::initRunMethods()
         changeMouseRefreshRate();
         changeSpringModeScreen();
         changeGamepadPollRate();
+        changeTextEntryKeyDelay();
 
 #ifdef Q_OS_WIN
         checkPointerPrecision();
@@ -87,6 +89,15 @@ void AppLaunchHelper::changeGamepadPollRate()
     }
 }
 
+void AppLaunchHelper::changeTextEntryKeyDelay()
+{
+    int keyDelay = settings->value("TextEntry/KeyDelay", 0).toInt();
+    if (keyDelay > 0)
+    {
+        BaseEventHandler::setTextEntryKeyDelay(keyDelay);
+    }
+}
+
 void AppLaunchHelper::printControllerList(QMap<SDL_JoystickID, InputDevice *> *joysticks)
 {
     QTextStream outstream(stdout);
@@ -135,7 +146,7 @@ void AppLaunchHelper::changeSpringModeScreen()
         springScreen = -1;
         settings->setValue("Mouse/SpringScreen",
                            AntiMicroSettings::defaultSpringScreen);
-        settings->sync();
+        settings->scheduleSync();
     }
 
     JoyButton::setSpringModeScreen(springScreen);
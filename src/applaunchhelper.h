@@ -41,6 +41,7 @@ protected:
     void changeMouseRefreshRate();
     void changeSpringModeScreen();
     void changeGamepadPollRate();
+    void changeTextEntryKeyDelay();
 #ifdef Q_OS_WIN
     void checkPointerPrecision();
 #endif
@@ -27,6 +27,7 @@
 #include "setjoystick.h"
 #include "inputdevice.h"
 #include "common.h"
+#include "inputstatesampler.h"
 
 AxisEditDialog::AxisEditDialog(JoyAxis *axis, QWidget *parent) :
     QDialog(parent, Qt::Window),
@@ -103,8 +104,9 @@ AxisEditDialog::AxisEditDialog(JoyAxis *axis, QWidget *parent) :
     ui->axisstatusBox->setMaxZone(axis->getMaxZoneValue());
     ui->axisstatusBox->setThrottle(axis->getThrottle());
 
-    ui->joyValueLabel->setText(QString::number(axis->getCurrentRawValue()));
-    ui->axisstatusBox->setValue(axis->getCurrentRawValue());
+    lastSampledValue = axis->getCurrentRawValue();
+    ui->joyValueLabel->setText(QString::number(lastSampledValue));
+    ui->axisstatusBox->setValue(lastSampledValue);
 
     if (!actAsTrigger)
     {
@@ -130,9 +132,6 @@ AxisEditDialog::AxisEditDialog(JoyAxis *axis, QWidget *parent) :
     connect(ui->comboBox_2, SIGNAL(currentIndexChanged(int)), this, SLOT(updateThrottleUi(int)));
     connect(ui->comboBox_2, SIGNAL(currentIndexChanged(int)), this, SLOT(presetForThrottleChange(int)));
 
-    connect(axis, SIGNAL(moved(int)), ui->axisstatusBox, SLOT(setValue(int)));
-    connect(axis, SIGNAL(moved(int)), this, SLOT(updateJoyValue(int)));
-
     connect(ui->lineEdit, SIGNAL(textEdited(QString)), this, SLOT(updateDeadZoneSlider(QString)));
     connect(ui->lineEdit_2, SIGNAL(textEdited(QString)), this, SLOT(updateMaxZoneSlider(QString)));
 
@@ -144,10 +143,14 @@ AxisEditDialog::AxisEditDialog(JoyAxis *axis, QWidget *parent) :
 
     connect(axis, SIGNAL(axisNameChanged()), this, SLOT(updateWindowTitleAxisName()));
     connect(this, SIGNAL(finished(int)), this, SLOT(checkFinalSettings()));
+
+    InputStateSampler::subscribe(this, SLOT(sampleAxisValue()));
 }
 
 AxisEditDialog::~AxisEditDialog()
 {
+    InputStateSampler::unsubscribe(this);
+
     delete ui;
 }
 
@@ -315,6 +318,21 @@ void AxisEditDialog::updateJoyValue(int value)
     ui->joyValueLabel->setText(QString::number(value));
 }
 
+/**
+ * @brief Check the raw value published by the input thread and update
+ *     the axis display if it changed. Called by the shared sample timer.
+ */
+void AxisEditDialog::sampleAxisValue()
+{
+    int value = axis->getPublishedRawValue();
+    if (value != lastSampledValue)
+    {
+        lastSampledValue = value;
+        ui->axisstatusBox->setValue(value);
+        updateJoyValue(value);
+    }
+}
+
 void AxisEditDialog::updateDeadZoneSlider(QString value)
 {
     int temp = value.toInt();
@@ -46,6 +46,7 @@ protected:
     JoyAxis *axis;
     SetAxisThrottleDialog *setAxisThrottleConfirm;
     int initialThrottleState;
+    int lastSampledValue;
 
 private:
     Ui::AxisEditDialog *ui;
@@ -60,6 +61,7 @@ private slots:
     void updateMaxZoneBox(int value);
     void updateThrottleUi(int index);
     void updateJoyValue(int value);
+    void sampleAxisValue();
     void updateDeadZoneSlider(QString value);
     void updateMaxZoneSlider(QString value);
     void openAdvancedPDialog();
@@ -17,10 +17,16 @@
 
 #include <QApplication>
 #include <QLibraryInfo>
+#include <QFile>
+#include <QFileInfo>
 #ifdef Q_OS_WIN
 #include <QStandardPaths>
 #endif
 
+#ifdef Q_OS_UNIX
+#include <stdio.h>
+#endif
+
 #include "common.h"
 
 namespace PadderCommon
@@ -172,6 +178,60 @@ namespace PadderCommon
         */
     }
 
+    /**
+     * @brief Move a fully written temporary file over its destination.
+     *     The replacement is atomic on Unix. Other platforms have to
+     *     remove the destination first.
+     * @param Path of the temporary file
+     * @param Destination path
+     * @return Whether the destination now holds the new file
+     */
+    bool replaceFile(const QString &tempFileName, const QString &fileName)
+    {
+        bool result = false;
+
+        // Keep the mode of the file that is replaced. A new file would
+        // otherwise get the default mode from the umask.
+        if (QFile::exists(fileName))
+        {
+            QFile::setPermissions(tempFileName, QFile::permissions(fileName));
+        }
+
+    #ifdef Q_OS_UNIX
+        result = rename(QFile::encodeName(tempFileName).constData(),
+                        QFile::encodeName(fileName).constData()) == 0;
+    #else
+        QFile::remove(fileName);
+        result = QFile::rename(tempFileName, fileName);
+    #endif
+
+        return result;
+    }
+
+    /**
+     * @brief Find the file that should be replaced when writing to a path.
+     *     Symbolic links are followed so that a replacement updates the
+     *     file they point to instead of replacing the link itself.
+     * @param Path that is written
+     * @return Path of the file to replace
+     */
+    QString resolveReplaceTarget(const QString &fileName)
+    {
+        QString result = fileName;
+        QFileInfo info(fileName);
+        if (info.isSymLink())
+        {
+            result = info.canonicalFilePath();
+            if (result.isEmpty())
+            {
+                // Dangling link. Create the file it points to.
+                result = info.symLinkTarget();
+            }
+        }
+
+        return result;
+    }
+
     QWaitCondition waitThisOut;
     QMutex sdlWaitMutex;
     QMutex inputDaemonMutex;
@@ -102,6 +102,7 @@ namespace PadderCommon
   }
 
   const QString configFileName = "antimicro_settings.ini";
+  const QString mappingDatabaseFileName = "gamecontrollerdb.txt";
   inline QString configFilePath() {
 #if defined(Q_OS_WIN) && defined(WIN_PORTABLE_PACKAGE)
     return QString(configPath()).append("/").append(configFileName);
@@ -149,6 +150,8 @@ namespace PadderCommon
                             QString language);
     void lockInputDevices();
     void unlockInputDevices();
+    bool replaceFile(const QString &tempFileName, const QString &fileName);
+    QString resolveReplaceTarget(const QString &fileName);
 
     /*!
      * \brief Returns the "human-readable" name of the given profile.
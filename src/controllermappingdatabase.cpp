@@ -0,0 +1,169 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QFileInfo>
+#include <string.h>
+
+#include "controllermappingdatabase.h"
+
+#if defined(Q_OS_WIN)
+const char* ControllerMappingDatabase::platformName = "Windows";
+#elif defined(Q_OS_MAC)
+const char* ControllerMappingDatabase::platformName = "Mac OS X";
+#else
+const char* ControllerMappingDatabase::platformName = "Linux";
+#endif
+
+static const char PLATFORMFIELD[] = "platform:";
+
+ControllerMappingDatabase::ControllerMappingDatabase(QString fileName) :
+    databaseFile(fileName)
+{
+    mappedData = 0;
+    mappedSize = 0;
+}
+
+ControllerMappingDatabase::~ControllerMappingDatabase()
+{
+    close();
+}
+
+void ControllerMappingDatabase::close()
+{
+    if (mappedData)
+    {
+        databaseFile.unmap(mappedData);
+        mappedData = 0;
+        mappedSize = 0;
+    }
+
+    if (databaseFile.isOpen())
+    {
+        databaseFile.close();
+    }
+}
+
+/**
+ * @brief Map the database file. The file is mapped again when it has
+ *     been changed since the last lookup.
+ * @return Whether the database is available
+ */
+bool ControllerMappingDatabase::ensureMapped()
+{
+    QFileInfo info(databaseFile.fileName());
+    if (!info.exists())
+    {
+        close();
+    }
+    else if (!mappedData || info.lastModified() != mappedModified ||
+             info.size() != mappedSize)
+    {
+        close();
+
+        if (info.size() > 0 && databaseFile.open(QFile::ReadOnly))
+        {
+            mappedData = databaseFile.map(0, databaseFile.size());
+            if (mappedData)
+            {
+                mappedSize = databaseFile.size();
+                mappedModified = info.lastModified();
+            }
+            else
+            {
+                databaseFile.close();
+            }
+        }
+    }
+
+    return mappedData != 0;
+}
+
+/**
+ * @brief Check when the database file was last changed without mapping it.
+ * @return Modification time or an invalid time if the file does not exist
+ */
+QDateTime ControllerMappingDatabase::lastModified()
+{
+    QFileInfo info(databaseFile.fileName());
+    return info.exists() ? info.lastModified() : QDateTime();
+}
+
+bool ControllerMappingDatabase::isPlatformMatch(const char *line, int length)
+{
+    bool result = true;
+    int fieldLength = sizeof(PLATFORMFIELD) - 1;
+    int nameLength = static_cast<int>(strlen(platformName));
+
+    for (int i=0; i <= length - fieldLength; i++)
+    {
+        if ((i == 0 || line[i-1] == ',') && memcmp(line + i, PLATFORMFIELD, fieldLength) == 0)
+        {
+            const char *value = line + i + fieldLength;
+            int valueLength = length - (i + fieldLength);
+            result = valueLength >= nameLength && memcmp(value, platformName, nameLength) == 0 &&
+                    (valueLength == nameLength || value[nameLength] == ',');
+            break;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Find the mapping line for a device GUID. Lines that belong to
+ *     a different platform are skipped.
+ * @param GUID string as returned by SDL_JoystickGetGUIDString
+ * @return Mapping string or an empty array if the GUID is not listed
+ */
+QByteArray ControllerMappingDatabase::findMapping(const QString &guid)
+{
+    QByteArray result;
+    QByteArray guidBytes = guid.toLatin1();
+
+    if (!guidBytes.isEmpty() && ensureMapped())
+    {
+        const char *data = reinterpret_cast<const char*>(mappedData);
+        const char *end = data + mappedSize;
+        const char *line = data;
+
+        while (line < end && result.isEmpty())
+        {
+            const char *lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+            if (!lineEnd)
+            {
+                lineEnd = end;
+            }
+
+            int length = static_cast<int>(lineEnd - line);
+            if (length > 0 && line[length-1] == '\r')
+            {
+                length--;
+            }
+
+            if (length > guidBytes.size() && line[guidBytes.size()] == ',' &&
+                memcmp(line, guidBytes.constData(), guidBytes.size()) == 0 &&
+                isPlatformMatch(line, length))
+            {
+                result = QByteArray(line, length);
+            }
+
+            line = lineEnd + 1;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,58 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONTROLLERMAPPINGDATABASE_H
+#define CONTROLLERMAPPINGDATABASE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QDateTime>
+
+/**
+ * @brief Read-only view of an SDL game controller mapping database in the
+ *     gamecontrollerdb.txt format. The file is memory mapped on the first
+ *     lookup and only the line for a requested GUID is copied, so the size
+ *     of the database does not affect startup time.
+ */
+class ControllerMappingDatabase
+{
+public:
+    explicit ControllerMappingDatabase(QString fileName);
+    ~ControllerMappingDatabase();
+
+    QByteArray findMapping(const QString &guid);
+    QDateTime lastModified();
+    void close();
+
+protected:
+    bool ensureMapped();
+    bool isPlatformMatch(const char *line, int length);
+
+    QFile databaseFile;
+    uchar *mappedData;
+    qint64 mappedSize;
+    QDateTime mappedModified;
+
+    static const char *platformName;
+
+private:
+    ControllerMappingDatabase(const ControllerMappingDatabase &other);
+    ControllerMappingDatabase& operator=(const ControllerMappingDatabase &other);
+};
+
+#endif // CONTROLLERMAPPINGDATABASE_H
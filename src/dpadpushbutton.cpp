@@ -56,15 +56,13 @@ QString DPadPushButton::generateLabel()
 
 void DPadPushButton::disableFlashes()
 {
-    disconnect(dpad, SIGNAL(active(int)), this, SLOT(flash()));
-    disconnect(dpad, SIGNAL(released(int)), this, SLOT(unflash()));
+    flashesEnabled = false;
     this->unflash();
 }
 
 void DPadPushButton::enableFlashes()
 {
-    connect(dpad, SIGNAL(active(int)), this, SLOT(flash()), Qt::QueuedConnection);
-    connect(dpad, SIGNAL(released(int)), this, SLOT(unflash()), Qt::QueuedConnection);
+    flashesEnabled = true;
 }
 
 void DPadPushButton::showContextMenu(const QPoint &point)
@@ -77,8 +75,13 @@ void DPadPushButton::showContextMenu(const QPoint &point)
 
 void DPadPushButton::tryFlash()
 {
-    if (dpad->getCurrentDirection() != static_cast<int>(JoyDPadButton::DpadCentered))
+    if (isInputActive())
     {
         flash();
     }
 }
+
+bool DPadPushButton::isInputActive()
+{
+    return dpad->getCurrentDirection() != static_cast<int>(JoyDPadButton::DpadCentered);
+}
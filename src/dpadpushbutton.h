@@ -35,6 +35,7 @@ public:
 
 protected:
     QString generateLabel();
+    virtual bool isInputActive();
 
     JoyDPad *dpad;
 
@@ -24,10 +24,10 @@
 #include <QStringList>
 #include <QCursor>
 #include <QDesktopWidget>
-#include <QProcess>
 
 #include "event.h"
 #include "eventhandlerfactory.h"
+#include "processlauncher.h"
 #include "joybutton.h"
 
 #if defined(Q_OS_UNIX)
@@ -124,6 +124,24 @@ void fakeAbsMouseCoordinates(double springX, double springY,
     finaly = (screenMidheight + (springY * destMidHeight) + deskRect.y());
 }
 
+/**
+ * @brief Have the active event handler compile the output of a slot ahead
+ *     of time when its codes do not depend on runtime state. Nothing is
+ *     done if an event handler has not been created yet.
+ * @param Slot to resolve
+ */
+void resolveSlotOutputCode(JoyButtonSlot *slot)
+{
+    if (EventHandlerFactory::hasInstance())
+    {
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+        if (handler)
+        {
+            handler->resolveNativeOutputCode(slot);
+        }
+    }
+}
+
 // Create the event used by the operating system.
 void sendevent(JoyButtonSlot *slot, bool pressed)
 {
@@ -140,21 +158,14 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
     }
     else if (device == JoyButtonSlot::JoyTextEntry && pressed && !slot->getTextData().isEmpty())
     {
-        EventHandlerFactory::getInstance()->handler()->sendTextEntryEvent(slot->getTextData());
+        EventHandlerFactory::getInstance()->handler()->sendTextEntrySlot(slot);
     }
     else if (device == JoyButtonSlot::JoyExecute && pressed && !slot->getTextData().isEmpty())
     {
-        QString execString = slot->getTextData();
-        if (slot->getExtraData().canConvert<QString>())
-        {
-            QString argumentsString = slot->getExtraData().toString();
-            QStringList argumentsTempList(PadderCommon::parseArgumentsString(argumentsString));
-            QProcess::startDetached(execString, argumentsTempList);
-        }
-        else
-        {
-            QProcess::startDetached(execString);
-        }
+        // Hand the launch off to the launcher thread. Arguments were
+        // parsed when the slot data was set.
+        ProcessLauncher::getInstance()->launch(slot->getTextData(),
+                                               slot->getExecuteArguments());
     }
 }
 
@@ -164,6 +175,29 @@ void sendevent(int code1, int code2)
     EventHandlerFactory::getInstance()->handler()->sendMouseEvent(code1, code2);
 }
 
+/**
+ * @brief Scroll the mouse wheel using high resolution units. Only valid
+ *     when hasHighResolutionWheel returns true.
+ * @param Vertical scroll in BaseEventHandler::WHEELDETENTUNITS per detent
+ * @param Horizontal scroll in BaseEventHandler::WHEELDETENTUNITS per detent
+ */
+void sendWheelEvent(int vertical, int horizontal)
+{
+    EventHandlerFactory::getInstance()->handler()->sendMouseWheelEvent(vertical, horizontal);
+}
+
+bool hasHighResolutionWheel()
+{
+    bool result = false;
+    if (EventHandlerFactory::hasInstance())
+    {
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+        result = handler && handler->hasHighResolutionWheel();
+    }
+
+    return result;
+}
+
 // TODO: Re-implement spring event generation to simplify the process
 // and reduce overhead. Refactor old function to only be used when an absmouse
 // position must be faked.
@@ -287,6 +321,63 @@ void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring,
     }
 }
 
+static bool hasAbsolutePointer()
+{
+    bool result = false;
+    if (EventHandlerFactory::hasInstance())
+    {
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+        result = handler && handler->hasAbsolutePointer();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Move the absolute pointer of the event handler straight to the
+ *     position of a full spring. Normalized coordinates are sent so the
+ *     current cursor position never has to be queried. Both spring axes
+ *     must have a displacement.
+ * @param Spring mode information
+ * @param Set to the X screen position of the pointer
+ * @param Set to the Y screen position of the pointer
+ */
+static void sendAbsoluteSpringEvent(PadderCommon::springModeInfo *fullSpring,
+                                    int* const mousePosX, int* const mousePosY)
+{
+    double springX = qBound(-1.0, fullSpring->displacementX, 1.0);
+    double springY = qBound(-1.0, fullSpring->displacementY, 1.0);
+
+    QRect deskRect = PadderCommon::mouseHelperObj.getDesktopWidget()->screenGeometry(-1);
+    int destSpringWidth = deskRect.width();
+    int destSpringHeight = deskRect.height();
+
+    // Shrink the spring area to the requested bounding box.
+    if (fullSpring->width >= 2 && fullSpring->height >= 2 &&
+        deskRect.width() > 0 && deskRect.height() > 0)
+    {
+        destSpringWidth = qMin(fullSpring->width, deskRect.width());
+        destSpringHeight = qMin(fullSpring->height, deskRect.height());
+        springX *= destSpringWidth / static_cast<double>(deskRect.width());
+        springY *= destSpringHeight / static_cast<double>(deskRect.height());
+    }
+
+    EventHandlerFactory::getInstance()->handler()->sendMouseSpringEvent(springX, springY);
+
+    // Report the position in screen pixels like the cursor based path.
+    if (mousePosX)
+    {
+        *mousePosX = (deskRect.width() / 2) + (fullSpring->displacementX * (destSpringWidth / 2)) +
+                deskRect.x();
+    }
+
+    if (mousePosY)
+    {
+        *mousePosY = (deskRect.height() / 2) + (fullSpring->displacementY * (destSpringHeight / 2)) +
+                deskRect.y();
+    }
+}
+
 // TODO: Change to only use this routine when using a relative mouse
 // pointer to fake absolute mouse moves. Otherwise, don't worry about
 // current position of the mouse and just send an absolute mouse pointer
@@ -297,7 +388,18 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring,
 {
     PadderCommon::mouseHelperObj.mouseTimer.stop();
 
-    if ((fullSpring->displacementX >= -2.0 && fullSpring->displacementX <= 1.0 &&
+    if (!relativeSpring && fullSpring->screen <= -1 &&
+        fullSpring->displacementX >= -1.0 && fullSpring->displacementX <= 1.0 &&
+        fullSpring->displacementY >= -1.0 && fullSpring->displacementY <= 1.0 &&
+        hasAbsolutePointer())
+    {
+        // Full springs on the whole desktop with both axes set do not
+        // depend on the current cursor position. Skip the cursor queries.
+        // An unset axis (-2.0) keeps the cursor position, so it still
+        // goes through the cursor based path below.
+        sendAbsoluteSpringEvent(fullSpring, mousePosX, mousePosY);
+    }
+    else if ((fullSpring->displacementX >= -2.0 && fullSpring->displacementX <= 1.0 &&
         fullSpring->displacementY >= -2.0 && fullSpring->displacementY <= 1.0) ||
         (relativeSpring && (relativeSpring->displacementX >= -2.0 && relativeSpring->displacementX <= 1.0 &&
         relativeSpring->displacementY >= -2.0 && relativeSpring->displacementY <= 1.0)))
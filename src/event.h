@@ -27,6 +27,8 @@
 
 void sendevent (JoyButtonSlot *slot, bool pressed=true);
 void sendevent(int code1, int code2);
+void sendWheelEvent(int vertical, int horizontal);
+bool hasHighResolutionWheel();
 void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring,
                         PadderCommon::springModeInfo *relativeSpring=0,
                         int* const mousePosX=0, int* const mousePos=0);
@@ -35,6 +37,8 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring,
                      PadderCommon::springModeInfo *relativeSpring=0,
                      int* const mousePosX=0, int* const mousePos=0);
 
+void resolveSlotOutputCode(JoyButtonSlot *slot);
+
 int X11KeySymToKeycode(QString key);
 QString keycodeToKeyString(int keycode, unsigned int alias=0);
 unsigned int X11KeyCodeToX11KeySym(unsigned int keycode);
@@ -96,6 +96,11 @@ EventHandlerFactory* EventHandlerFactory::getInstance(QString handler)
     return instance;
 }
 
+bool EventHandlerFactory::hasInstance()
+{
+    return instance != 0;
+}
+
 void EventHandlerFactory::deleteInstance()
 {
     if (instance)
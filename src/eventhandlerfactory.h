@@ -73,6 +73,7 @@ class EventHandlerFactory : public QObject
     Q_OBJECT
 public:
     static EventHandlerFactory* getInstance(QString handler = "");
+    static bool hasInstance();
     void deleteInstance();
     BaseEventHandler* handler();
     static QString fallBackIdentifier();
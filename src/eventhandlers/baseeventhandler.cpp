@@ -15,11 +15,22 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QMutexLocker>
+
 #include "baseeventhandler.h"
 
+const int BaseEventHandler::WHEELDETENTUNITS = 120;
+const int BaseEventHandler::DEFAULTABSPOINTERRESOLUTION = 32767;
+
+int BaseEventHandler::textEntryKeyDelay = 0;
+int BaseEventHandler::absPointerResolution = BaseEventHandler::DEFAULTABSPOINTERRESOLUTION;
+
 BaseEventHandler::BaseEventHandler(QObject *parent) :
     QObject(parent)
 {
+    pendingTextIndex = 0;
+    textEntryTimer.setSingleShot(false);
+    connect(&textEntryTimer, SIGNAL(timeout()), this, SLOT(sendPendingTextEntryChunk()));
 }
 
 QString BaseEventHandler::getErrorString()
@@ -27,6 +38,23 @@ QString BaseEventHandler::getErrorString()
     return lastErrorString;
 }
 
+/**
+ * @brief Compile the text of a text entry slot ahead of time. Child
+ *     classes whose compiled codes depend on state that can change at
+ *     runtime, like the keyboard layout, should not do this.
+ * @param Slot to resolve
+ */
+void BaseEventHandler::resolveNativeOutputCode(JoyButtonSlot *slot)
+{
+    if (slot->getSlotMode() == JoyButtonSlot::JoyTextEntry &&
+        !slot->getTextData().isEmpty())
+    {
+        QVector<int> events;
+        compileTextEntry(slot->getTextData(), events);
+        slot->setTextEntryEvents(events);
+    }
+}
+
 /**
  * @brief Do nothing by default. Allow child classes to specify text to output
  *     to a text stream.
@@ -65,16 +93,203 @@ void BaseEventHandler::sendMouseSpringEvent(unsigned int xDis, unsigned int yDis
 }
 
 /**
- * @brief Do nothing by default. Useful for child classes to define behavior.
- * @param Displacement of X coordinate
- * @param Displacement of Y coordinate
+ * @brief Do nothing by default. Child classes that provide an absolute
+ *     pointer device should move it to the normalized position.
+ * @param Normalized X position between -1.0 and 1.0
+ * @param Normalized Y position between -1.0 and 1.0
  */
-void BaseEventHandler::sendMouseSpringEvent(int xDis, int yDis)
+void BaseEventHandler::sendMouseSpringEvent(double xDis, double yDis)
 {
+    Q_UNUSED(xDis);
+    Q_UNUSED(yDis);
 
 }
 
+/**
+ * @brief Whether the handler can scroll by fractions of a wheel detent
+ *     using sendMouseWheelEvent. Not supported by default.
+ * @return Whether high resolution scrolling is supported
+ */
+bool BaseEventHandler::hasHighResolutionWheel()
+{
+    return false;
+}
+
+/**
+ * @brief Do nothing by default. Child classes that support high resolution
+ *     scrolling should override this method.
+ * @param Vertical scroll in WHEELDETENTUNITS per detent. Positive values
+ *     scroll up.
+ * @param Horizontal scroll in WHEELDETENTUNITS per detent. Positive values
+ *     scroll in the same direction as a MouseWheelLeft slot.
+ */
+void BaseEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    Q_UNUSED(vertical);
+    Q_UNUSED(horizontal);
+}
+
 void BaseEventHandler::sendTextEntryEvent(QString maintext)
 {
 
 }
+
+/**
+ * @brief Do nothing by default. Child classes that support compiled text
+ *     entry should translate the text into a sequence of key events.
+ *     Positive values are key presses, negative values are key releases
+ *     and a 0 ends the events needed to type one character.
+ * @param Text to compile
+ * @param Destination for the compiled events
+ */
+void BaseEventHandler::compileTextEntry(QString maintext, QVector<int> &events)
+{
+    Q_UNUSED(maintext);
+
+    events.clear();
+}
+
+/**
+ * @brief Do nothing by default. Send the key events for one character of
+ *     a compiled text entry.
+ * @param Pointer to the first event
+ * @param Number of events
+ */
+void BaseEventHandler::sendTextEntryChunk(const int *events, int count)
+{
+    Q_UNUSED(events);
+    Q_UNUSED(count);
+}
+
+/**
+ * @brief Send the text of a text entry slot. Uses the compiled key events
+ *     stored in the slot when the handler supports them. Otherwise the
+ *     text is compiled now and the result is not stored.
+ *     When a key delay is set, the events are queued and sent from
+ *     a timer so the calling thread is not blocked.
+ * @param Text entry slot
+ */
+void BaseEventHandler::sendTextEntrySlot(JoyButtonSlot *slot)
+{
+    QVector<int> events = slot->getTextEntryEvents();
+    if (events.isEmpty())
+    {
+        compileTextEntry(slot->getTextData(), events);
+    }
+
+    if (events.isEmpty())
+    {
+        sendTextEntryEvent(slot->getTextData());
+    }
+    else
+    {
+        QMutexLocker tempLocker(&pendingTextLock);
+        if (textEntryKeyDelay <= 0 && pendingTextEvents.isEmpty())
+        {
+            sendTextEntryChunks(events, 0);
+        }
+        else
+        {
+            bool wasIdle = pendingTextEvents.isEmpty();
+            pendingTextEvents += events;
+            if (wasIdle)
+            {
+                QMetaObject::invokeMethod(&textEntryTimer, "start",
+                                          Q_ARG(int, qMax(textEntryKeyDelay, 0)));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Send compiled text entry events one character at a time.
+ * @param Compiled events
+ * @param Index of the first event to send
+ * @param Maximum number of characters to send. -1 sends all characters.
+ * @return Index of the first event that was not sent.
+ */
+int BaseEventHandler::sendTextEntryChunks(const QVector<int> &events, int index,
+                                          int maxChunks)
+{
+    const int *data = events.constData();
+    int size = events.size();
+    int chunks = 0;
+
+    while (index < size && (maxChunks < 0 || chunks < maxChunks))
+    {
+        int end = index;
+        while (end < size && data[end] != 0)
+        {
+            end++;
+        }
+
+        if (end > index)
+        {
+            sendTextEntryChunk(data + index, end - index);
+        }
+
+        index = end + 1;
+        chunks++;
+    }
+
+    return qMin(index, size);
+}
+
+void BaseEventHandler::sendPendingTextEntryChunk()
+{
+    QMutexLocker tempLocker(&pendingTextLock);
+
+    pendingTextIndex = sendTextEntryChunks(pendingTextEvents, pendingTextIndex, 1);
+    if (pendingTextIndex >= pendingTextEvents.size())
+    {
+        textEntryTimer.stop();
+        pendingTextEvents.resize(0);
+        pendingTextIndex = 0;
+    }
+}
+
+/**
+ * @brief Set the delay used between characters of a text entry slot.
+ * @param Delay in ms. 0 sends all characters at once.
+ */
+void BaseEventHandler::setTextEntryKeyDelay(int delay)
+{
+    if (delay >= 0 && delay <= 1000)
+    {
+        textEntryKeyDelay = delay;
+    }
+}
+
+int BaseEventHandler::getTextEntryKeyDelay()
+{
+    return textEntryKeyDelay;
+}
+
+/**
+ * @brief Whether the handler can move an absolute pointer from normalized
+ *     coordinates without knowing the current cursor position.
+ * @return Whether sendMouseSpringEvent(double, double) is supported
+ */
+bool BaseEventHandler::hasAbsolutePointer()
+{
+    return false;
+}
+
+/**
+ * @brief Set the number of steps from the center to the edge of an
+ *     absolute pointer device. Has to be set before the event handler
+ *     is initialized.
+ * @param Resolution of each axis
+ */
+void BaseEventHandler::setAbsPointerResolution(int resolution)
+{
+    if (resolution > 0)
+    {
+        absPointerResolution = resolution;
+    }
+}
+
+int BaseEventHandler::getAbsPointerResolution()
+{
+    return absPointerResolution;
+}
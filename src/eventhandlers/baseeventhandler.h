@@ -20,6 +20,9 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
+#include <QTimer>
+#include <QMutex>
 
 #include <springmousemoveinfo.h>
 #include <joybuttonslot.h>
@@ -40,23 +43,55 @@ public:
 
     virtual void sendMouseSpringEvent(unsigned int xDis, unsigned int yDis,
                                       unsigned int width, unsigned int height);
-    virtual void sendMouseSpringEvent(int xDis, int yDis);
+    virtual void sendMouseSpringEvent(double xDis, double yDis);
+    virtual bool hasAbsolutePointer();
+
+    virtual bool hasHighResolutionWheel();
+    virtual void sendMouseWheelEvent(int vertical, int horizontal);
 
     virtual void sendTextEntryEvent(QString maintext);
+    void sendTextEntrySlot(JoyButtonSlot *slot);
+    virtual void compileTextEntry(QString maintext, QVector<int> &events);
+
+    virtual void resolveNativeOutputCode(JoyButtonSlot *slot);
 
     virtual QString getName() = 0;
     virtual QString getIdentifier() = 0;
     virtual void printPostMessages();
     QString getErrorString();
 
+    static void setTextEntryKeyDelay(int delay);
+    static int getTextEntryKeyDelay();
+
+    static void setAbsPointerResolution(int resolution);
+    static int getAbsPointerResolution();
+
+    // High resolution wheel units in one wheel detent.
+    static const int WHEELDETENTUNITS;
+    static const int DEFAULTABSPOINTERRESOLUTION;
 
 protected:
+    virtual void sendTextEntryChunk(const int *events, int count);
+    int sendTextEntryChunks(const QVector<int> &events, int index, int maxChunks=-1);
+
     QString lastErrorString;
 
+    // Compiled text entry events waiting to be sent when a key delay
+    // is in use.
+    QVector<int> pendingTextEvents;
+    int pendingTextIndex;
+    QMutex pendingTextLock;
+    QTimer textEntryTimer;
+
+    static int textEntryKeyDelay;
+    static int absPointerResolution;
+
 signals:
 
 public slots:
 
+protected slots:
+    void sendPendingTextEntryChunk();
 };
 
 #endif // BASEEVENTHANDLER_H
@@ -26,6 +26,7 @@
 #include <QStringListIterator>
 #include <QFileInfo>
 #include <QTimer>
+#include <QVarLengthArray>
 #include <antkeymapper.h>
 #include <logger.h>
 #include <common.h>
@@ -50,6 +51,8 @@ UInputEventHandler::UInputEventHandler(QObject *parent) :
     keyboardFileHandler = 0;
     mouseFileHandler = 0;
     springMouseFileHandler = 0;
+    wheelVerticalUnits = 0;
+    wheelHorizontalUnits = 0;
 }
 
 UInputEventHandler::~UInputEventHandler()
@@ -209,7 +212,7 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, 1);
+                sendMouseWheelEvent(WHEELDETENTUNITS, 0);
             }
 
         }
@@ -217,21 +220,21 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, -1);
+                sendMouseWheelEvent(-WHEELDETENTUNITS, 0);
             }
         }
         else if (code == 6)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, 1);
+                sendMouseWheelEvent(0, WHEELDETENTUNITS);
             }
         }
         else if (code == 7)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, -1);
+                sendMouseWheelEvent(0, -WHEELDETENTUNITS);
             }
         }
         else if (code == 8)
@@ -267,25 +270,96 @@ void UInputEventHandler::sendMouseSpringEvent(unsigned int xDis, unsigned int yD
         double midwidth = static_cast<double>(width) / 2.0;
         double midheight = static_cast<double>(height) / 2.0;
 
-        int fx = ceil(32767 * ((xDis - midwidth) / midwidth));
-        int fy = ceil(32767 * ((yDis - midheight) / midheight));
+        int fx = ceil(absPointerResolution * ((xDis - midwidth) / midwidth));
+        int fy = ceil(absPointerResolution * ((yDis - midheight) / midheight));
         sendMouseAbsEvent(fx, fy, -1);
         //write_uinput_event(springMouseFileHandler, EV_ABS, ABS_X, fx, false);
         //write_uinput_event(springMouseFileHandler, EV_ABS, ABS_Y, fy);
     }
 }
 
-void UInputEventHandler::sendMouseSpringEvent(int xDis, int yDis)
+/**
+ * @brief Move the absolute pointer device to a normalized position.
+ *     Position is sent straight to the device so the current cursor
+ *     position is never queried.
+ * @param Normalized X position between -1.0 and 1.0
+ * @param Normalized Y position between -1.0 and 1.0
+ */
+void UInputEventHandler::sendMouseSpringEvent(double xDis, double yDis)
 {
     if (xDis >= -1.0 && xDis <= 1.0 &&
         yDis >= -1.0 && yDis <= 1.0)
     {
-        int fx = ceil(32767 * xDis);
-        int fy = ceil(32767 * yDis);
+        int fx = qRound(absPointerResolution * xDis);
+        int fy = qRound(absPointerResolution * yDis);
         sendMouseAbsEvent(fx, fy, -1);
     }
 }
 
+bool UInputEventHandler::hasAbsolutePointer()
+{
+    return springMouseFileHandler > 0;
+}
+
+bool UInputEventHandler::hasHighResolutionWheel()
+{
+#ifdef REL_WHEEL_HI_RES
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Scroll the virtual mouse wheel. High resolution events are sent
+ *     when the kernel headers provide them. A legacy wheel event is sent
+ *     every time the accumulated units cross a full detent so clients
+ *     that only read REL_WHEEL still scroll.
+ * @param Vertical scroll in WHEELDETENTUNITS per detent
+ * @param Horizontal scroll in WHEELDETENTUNITS per detent
+ */
+void UInputEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    if (vertical != 0 || horizontal != 0)
+    {
+#ifdef REL_WHEEL_HI_RES
+        writeWheelAxis(REL_WHEEL, REL_WHEEL_HI_RES, vertical, wheelVerticalUnits);
+        writeWheelAxis(REL_HWHEEL, REL_HWHEEL_HI_RES, horizontal, wheelHorizontalUnits);
+#else
+        writeWheelAxis(REL_WHEEL, REL_WHEEL, vertical, wheelVerticalUnits);
+        writeWheelAxis(REL_HWHEEL, REL_HWHEEL, horizontal, wheelHorizontalUnits);
+#endif
+
+        write_uinput_event(mouseFileHandler, EV_SYN, SYN_REPORT, 0, false);
+    }
+}
+
+void UInputEventHandler::writeWheelAxis(unsigned int code, unsigned int hiResCode,
+                                        int units, int &pendingUnits)
+{
+    if (units != 0)
+    {
+        if (hiResCode != code)
+        {
+            write_uinput_event(mouseFileHandler, EV_REL, hiResCode, units, false);
+        }
+
+        // Drop units left over from scrolling in the other direction.
+        if ((pendingUnits < 0) != (units < 0))
+        {
+            pendingUnits = 0;
+        }
+
+        pendingUnits += units;
+        int detents = pendingUnits / WHEELDETENTUNITS;
+        if (detents != 0)
+        {
+            write_uinput_event(mouseFileHandler, EV_REL, code, detents, false);
+            pendingUnits -= detents * WHEELDETENTUNITS;
+        }
+    }
+}
+
 int UInputEventHandler::openUInputHandle()
 {
     int filehandle = -1;
@@ -352,6 +426,10 @@ void UInputEventHandler::setRelMouseEvents(int filehandle)
     result = ioctl(filehandle, UI_SET_RELBIT, REL_Y);
     result = ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL);
     result = ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL);
+#ifdef REL_WHEEL_HI_RES
+    result = ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+    result = ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
+#endif
 
     result = ioctl(filehandle, UI_SET_KEYBIT, BTN_LEFT);
     result = ioctl(filehandle, UI_SET_KEYBIT, BTN_RIGHT);
@@ -436,12 +514,12 @@ void UInputEventHandler::createUInputSpringMouseDevice(int filehandle)
     uidev.id.product = 0x0;
     uidev.id.version = 1;
 
-    uidev.absmin[ABS_X] = -32767;
-    uidev.absmax[ABS_X] = 32767;
+    uidev.absmin[ABS_X] = -absPointerResolution;
+    uidev.absmax[ABS_X] = absPointerResolution;
     uidev.absflat[ABS_X] = 0;
 
-    uidev.absmin[ABS_Y] = -32767;
-    uidev.absmax[ABS_Y] = 32767;
+    uidev.absmin[ABS_Y] = -absPointerResolution;
+    uidev.absmax[ABS_Y] = absPointerResolution;
     uidev.absflat[ABS_Y] = 0;
 
     int result = 0;
@@ -512,8 +590,16 @@ void UInputEventHandler::printPostMessages()
     }
 }
 
-void UInputEventHandler::sendTextEntryEvent(QString maintext)
+/**
+ * @brief Translate text into uinput key events. Modifiers needed for
+ *     a character are pressed before the key and released afterwards.
+ * @param Text to compile
+ * @param Destination for the compiled events
+ */
+void UInputEventHandler::compileTextEntry(QString maintext, QVector<int> &events)
 {
+    events.clear();
+
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
 
     if (mapper && mapper->getKeyMapper())
@@ -525,11 +611,12 @@ void UInputEventHandler::sendTextEntryEvent(QString maintext)
             nativeWinKeyMapper = static_cast<QtX11KeyMapper*>(mapper->getNativeKeyMapper());
         }
 
-        QList<unsigned int> tempList;
+        // Worst case is four modifiers plus the key being pressed and
+        // released followed by the end of character marker.
+        events.reserve(maintext.size() * 11);
+
         for (int i=0; i < maintext.size(); i++)
         {
-            tempList.clear();
-
             QtUInputKeyMapper::charKeyInformation temp;
             temp.virtualkey = 0;
             temp.modifiers = Qt::NoModifier;
@@ -556,48 +643,95 @@ void UInputEventHandler::sendTextEntryEvent(QString maintext)
 
             if (temp.virtualkey > KEY_RESERVED)
             {
-                if (temp.modifiers != Qt::NoModifier)
+                int modifierStart = events.size();
+
+                if (temp.modifiers.testFlag(Qt::ShiftModifier))
                 {
-                    if (temp.modifiers.testFlag(Qt::ShiftModifier))
-                    {
-                        tempList.append(KEY_LEFTSHIFT);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTSHIFT, 1, false);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::ControlModifier))
-                    {
-                        tempList.append(KEY_LEFTCTRL);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTCTRL, 1, false);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::AltModifier))
-                    {
-                        tempList.append(KEY_LEFTALT);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTALT, 1, false);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::MetaModifier))
-                    {
-                        tempList.append(KEY_LEFTMETA);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTMETA, 1, false);
-                    }
+                    events.append(KEY_LEFTSHIFT);
                 }
 
-                tempList.append(temp.virtualkey);
-                write_uinput_event(keyboardFileHandler, EV_KEY, temp.virtualkey, 1, true);
-            }
+                if (temp.modifiers.testFlag(Qt::ControlModifier))
+                {
+                    events.append(KEY_LEFTCTRL);
+                }
 
-            if (tempList.size() > 0)
-            {
-                QListIterator<unsigned int> tempiter(tempList);
-                tempiter.toBack();
-                while (tempiter.hasPrevious())
+                if (temp.modifiers.testFlag(Qt::AltModifier))
+                {
+                    events.append(KEY_LEFTALT);
+                }
+
+                if (temp.modifiers.testFlag(Qt::MetaModifier))
+                {
+                    events.append(KEY_LEFTMETA);
+                }
+
+                int modifierEnd = events.size();
+
+                events.append(temp.virtualkey);
+                events.append(-static_cast<int>(temp.virtualkey));
+
+                for (int j=modifierEnd - 1; j >= modifierStart; j--)
                 {
-                    unsigned int currentcode = tempiter.previous();
-                    bool sync = !tempiter.hasPrevious() ? true : false;
-                    write_uinput_event(keyboardFileHandler, EV_KEY, currentcode, 0, sync);
+                    events.append(-events.at(j));
                 }
+
+                events.append(0);
             }
         }
     }
 }
+
+/**
+ * @brief Write the events for one character with a single write call.
+ *     A SYN_REPORT is added after the key presses and after the key
+ *     releases.
+ * @param Pointer to the first event
+ * @param Number of events
+ */
+void UInputEventHandler::sendTextEntryChunk(const int *events, int count)
+{
+    // Room for every key event of the character plus both SYN_REPORT
+    // events. Only spills to the heap for sequences longer than a
+    // compiled character can be.
+    QVarLengthArray<struct input_event, MAXTEXTCHUNKEVENTS> buffer(count + 2);
+    memset(buffer.data(), 0, sizeof(struct input_event) * buffer.size());
+
+    struct timeval currentTime;
+    gettimeofday(&currentTime, 0);
+
+    int used = 0;
+    bool pressing = true;
+    for (int i=0; i < count; i++)
+    {
+        int value = events[i];
+        if (pressing && value < 0)
+        {
+            buffer[used].time = currentTime;
+            buffer[used].type = EV_SYN;
+            buffer[used].code = SYN_REPORT;
+            used++;
+            pressing = false;
+        }
+
+        buffer[used].time = currentTime;
+        buffer[used].type = EV_KEY;
+        buffer[used].code = static_cast<unsigned short>(qAbs(value));
+        buffer[used].value = value > 0 ? 1 : 0;
+        used++;
+    }
+
+    buffer[used].time = currentTime;
+    buffer[used].type = EV_SYN;
+    buffer[used].code = SYN_REPORT;
+    used++;
+
+    int result = write(keyboardFileHandler, buffer.constData(), sizeof(struct input_event) * used);
+    Q_UNUSED(result);
+}
+
+void UInputEventHandler::sendTextEntryEvent(QString maintext)
+{
+    QVector<int> events;
+    compileTextEntry(maintext, events);
+    sendTextEntryChunks(events, 0);
+}
@@ -40,15 +40,22 @@ public:
 
     virtual void sendMouseSpringEvent(unsigned int xDis, unsigned int yDis,
                                       unsigned int width, unsigned int height);
-    virtual void sendMouseSpringEvent(int xDis, int yDis);
+    virtual void sendMouseSpringEvent(double xDis, double yDis);
+    virtual bool hasAbsolutePointer();
+
+    virtual bool hasHighResolutionWheel();
+    virtual void sendMouseWheelEvent(int vertical, int horizontal);
 
     virtual QString getName();
     virtual QString getIdentifier();
     virtual void printPostMessages();
 
     virtual void sendTextEntryEvent(QString maintext);
+    virtual void compileTextEntry(QString maintext, QVector<int> &events);
 
 protected:
+    virtual void sendTextEntryChunk(const int *events, int count);
+
     int openUInputHandle();
     void setKeyboardEvents(int filehandle);
     void setRelMouseEvents(int filehandle);
@@ -60,12 +67,24 @@ protected:
     void closeUInputDevice(int filehandle);
     void write_uinput_event(int filehandle, unsigned int type,
                             unsigned int code, int value, bool syn=true);
+    void writeWheelAxis(unsigned int code, unsigned int hiResCode,
+                        int units, int &pendingUnits);
 
     int keyboardFileHandler;
     int mouseFileHandler;
     int springMouseFileHandler;
     QString uinputDeviceLocation;
 
+    // High resolution wheel units not yet reported as a legacy
+    // wheel event.
+    int wheelVerticalUnits;
+    int wheelHorizontalUnits;
+
+    // Worst case for one character: four modifiers and the key, each
+    // pressed and released, plus two SYN_REPORT events.
+    static const int MAXTEXTMODIFIERS = 4;
+    static const int MAXTEXTCHUNKEVENTS = ((MAXTEXTMODIFIERS + 1) * 2) + 2;
+
 signals:
 
 public slots:
@@ -42,6 +42,8 @@ void WinSendInputEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool press
     int code = slot->getSlotCode();
     INPUT temp[1] = {};
 
+    // The scan code depends on the active keyboard layout, which can
+    // change at runtime. Look it up on every press.
     unsigned int scancode = WinExtras::scancodeFromVirtualKey(code, slot->getSlotCodeAlias());
     int extended = (scancode & WinExtras::EXTENDED_FLAG) != 0;
     int tempflags = extended ? KEYEVENTF_EXTENDEDKEY : 0;
@@ -355,7 +355,16 @@ void WinVMultiEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool press
 
 void WinVMultiEventHandler::sendMouseEvent(int xDis, int yDis)
 {
-    vmulti_update_relative_mouse(vmulti, mouseButtons, xDis, yDis, 0);//, 0);
+    // Relative reports hold a signed byte per axis. Split larger
+    // movements across several reports.
+    do
+    {
+        int stepX = qBound(-127, xDis, 127);
+        int stepY = qBound(-127, yDis, 127);
+        vmulti_update_relative_mouse(vmulti, mouseButtons, stepX, stepY, 0);//, 0);
+        xDis -= stepX;
+        yDis -= stepY;
+    } while (xDis != 0 || yDis != 0);
 }
 
 void WinVMultiEventHandler::sendMouseSpringEvent(unsigned int xDis, unsigned int yDis,
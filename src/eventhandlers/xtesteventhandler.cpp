@@ -55,6 +55,8 @@ void XTestEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyKeyboard)
     {
+        // The keymap can change at runtime, so the keycode is looked up
+        // on every press.
         unsigned int tempcode = XKeysymToKeycode(display, code);
         if (tempcode > 0)
         {
@@ -64,6 +66,17 @@ void XTestEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
     }
 }
 
+/**
+ * @brief Do not compile anything ahead of time. X11 keycodes depend on the
+ *     current keymap, which can change at runtime (setxkbmap or a layout
+ *     switch). Text entry slots are compiled when they are sent.
+ * @param Slot to resolve
+ */
+void XTestEventHandler::resolveNativeOutputCode(JoyButtonSlot *slot)
+{
+    Q_UNUSED(slot);
+}
+
 void XTestEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
 {
     Display* display = X11Extras::getInstance()->display();
@@ -101,114 +114,118 @@ QString XTestEventHandler::getIdentifier()
     return QString("xtest");
 }
 
-void XTestEventHandler::sendTextEntryEvent(QString maintext)
+/**
+ * @brief Translate text into X11 keycode events. Modifiers needed for
+ *     a character are pressed before the key and released afterwards.
+ * @param Text to compile
+ * @param Destination for the compiled events
+ */
+void XTestEventHandler::compileTextEntry(QString maintext, QVector<int> &events)
 {
-    AntKeyMapper *mapper = AntKeyMapper::getInstance();
+    events.clear();
 
-    // Populated as needed.
-    unsigned int shiftcode = 0;
-    unsigned int controlcode = 0;
-    unsigned int metacode = 0;
-    unsigned int altcode = 0;
+    AntKeyMapper *mapper = AntKeyMapper::getInstance();
 
     if (mapper && mapper->getKeyMapper())
     {
-        //Qt::KeyboardModifiers originalModifiers = Qt::KeyboardModifiers(QApplication::keyboardModifiers());
-        //Qt::KeyboardModifiers currentModifiers = Qt::KeyboardModifiers(QApplication::keyboardModifiers());
         Display* display = X11Extras::getInstance()->display();
         QtX11KeyMapper *keymapper = static_cast<QtX11KeyMapper*>(mapper->getKeyMapper());
 
+        // Populated as needed.
+        unsigned int shiftcode = 0;
+        unsigned int controlcode = 0;
+        unsigned int metacode = 0;
+        unsigned int altcode = 0;
+
+        // Worst case is four modifiers plus the key being pressed and
+        // released followed by the end of character marker.
+        events.reserve(maintext.size() * 11);
+
         for (int i=0; i < maintext.size(); i++)
         {
             QtX11KeyMapper::charKeyInformation temp = keymapper->getCharKeyInformation(maintext.at(i));
             unsigned int tempcode = XKeysymToKeycode(display, temp.virtualkey);
             if (tempcode > 0)
             {
-                QList<unsigned int> tempList;
+                int modifierStart = events.size();
 
-                if (temp.modifiers != Qt::NoModifier)
+                if (temp.modifiers.testFlag(Qt::ShiftModifier))
                 {
-                    if (temp.modifiers.testFlag(Qt::ShiftModifier))
+                    if (shiftcode == 0)
                     {
-                        if (shiftcode == 0)
-                        {
-                            shiftcode = XKeysymToKeycode(display, XK_Shift_L);
-                        }
-
-                        unsigned int modifiercode = shiftcode;
-                        XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                        //currentModifiers |= Qt::ShiftModifier;
-                        tempList.append(modifiercode);
+                        shiftcode = XKeysymToKeycode(display, XK_Shift_L);
                     }
 
-                    if (temp.modifiers.testFlag(Qt::ControlModifier))
+                    events.append(shiftcode);
+                }
+
+                if (temp.modifiers.testFlag(Qt::ControlModifier))
+                {
+                    if (controlcode == 0)
                     {
-                        if (controlcode == 0)
-                        {
-                            controlcode = XKeysymToKeycode(display, XK_Control_L);
-                        }
-
-                        unsigned int modifiercode = controlcode;
-                        XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                        //currentModifiers |= Qt::ControlModifier;
-                        tempList.append(modifiercode);
+                        controlcode = XKeysymToKeycode(display, XK_Control_L);
                     }
 
-                    if (temp.modifiers.testFlag(Qt::AltModifier))
+                    events.append(controlcode);
+                }
+
+                if (temp.modifiers.testFlag(Qt::AltModifier))
+                {
+                    if (altcode == 0)
                     {
-                        if (altcode == 0)
-                        {
-                            altcode = XKeysymToKeycode(display, XK_Alt_L);
-                        }
-
-                        unsigned int modifiercode = altcode;
-                        XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                        //currentModifiers |= Qt::AltModifier;
-                        tempList.append(modifiercode);
+                        altcode = XKeysymToKeycode(display, XK_Alt_L);
                     }
 
-                    if (temp.modifiers.testFlag(Qt::MetaModifier))
+                    events.append(altcode);
+                }
+
+                if (temp.modifiers.testFlag(Qt::MetaModifier))
+                {
+                    if (metacode == 0)
                     {
-                        if (metacode == 0)
-                        {
-                            metacode = XKeysymToKeycode(display, XK_Meta_L);
-                        }
-
-                        unsigned int modifiercode = metacode;
-                        XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                        //currentModifiers |= Qt::MetaModifier;
-                        tempList.append(modifiercode);
+                        metacode = XKeysymToKeycode(display, XK_Meta_L);
                     }
+
+                    events.append(metacode);
                 }
 
-                XTestFakeKeyEvent(display, tempcode, 1, 0);
-                tempList.append(tempcode);
+                int modifierEnd = events.size();
 
-                XFlush(display);
+                events.append(tempcode);
+                events.append(-static_cast<int>(tempcode));
 
-                if (tempList.size() > 0)
+                for (int j=modifierEnd - 1; j >= modifierStart; j--)
                 {
-                    QListIterator<unsigned int> tempiter(tempList);
-                    tempiter.toBack();
-                    while (tempiter.hasPrevious())
-                    {
-                        unsigned int currentcode = tempiter.previous();
-                        XTestFakeKeyEvent(display, currentcode, 0, 0);
-                    }
-
-                    XFlush(display);
+                    events.append(-events.at(j));
                 }
+
+                events.append(0);
             }
         }
+    }
+}
 
-        // Perform a flush at the end.
-        //XFlush(display);
-
-        // Restore modifiers in place
-        /*if (originalModifiers != currentModifiers)
-        {
+/**
+ * @brief Send the events for one character and flush the display once.
+ * @param Pointer to the first event
+ * @param Number of events
+ */
+void XTestEventHandler::sendTextEntryChunk(const int *events, int count)
+{
+    Display* display = X11Extras::getInstance()->display();
 
-        }
-        */
+    for (int i=0; i < count; i++)
+    {
+        int value = events[i];
+        XTestFakeKeyEvent(display, qAbs(value), value > 0, 0);
     }
+
+    XFlush(display);
+}
+
+void XTestEventHandler::sendTextEntryEvent(QString maintext)
+{
+    QVector<int> events;
+    compileTextEntry(maintext, events);
+    sendTextEntryChunks(events, 0);
 }
@@ -39,6 +39,12 @@ public:
     virtual QString getIdentifier();
 
     virtual void sendTextEntryEvent(QString maintext);
+    virtual void compileTextEntry(QString maintext, QVector<int> &events);
+
+    virtual void resolveNativeOutputCode(JoyButtonSlot *slot);
+
+protected:
+    virtual void sendTextEntryChunk(const int *events, int count);
 
 signals:
 
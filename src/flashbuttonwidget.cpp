@@ -18,9 +18,9 @@
 //#include <QDebug>
 #include <QStyle>
 #include <QFontMetrics>
-#include <QPainter>
 
 #include "flashbuttonwidget.h"
+#include "inputstatesampler.h"
 
 FlashButtonWidget::FlashButtonWidget(QWidget *parent) :
     QPushButton(parent)
@@ -28,6 +28,10 @@ FlashButtonWidget::FlashButtonWidget(QWidget *parent) :
     isflashing = false;
     displayNames = false;
     leftAlignText = false;
+    flashesEnabled = false;
+    lastActiveZoneVersion = 0;
+    fittedWidth = -1;
+    sampling = false;
 }
 
 FlashButtonWidget::FlashButtonWidget(bool displayNames, QWidget *parent) :
@@ -36,6 +40,97 @@ FlashButtonWidget::FlashButtonWidget(bool displayNames, QWidget *parent) :
     isflashing = false;
     this->displayNames = displayNames;
     leftAlignText = false;
+    flashesEnabled = false;
+    lastActiveZoneVersion = 0;
+    fittedWidth = -1;
+    sampling = false;
+}
+
+FlashButtonWidget::~FlashButtonWidget()
+{
+    if (sampling)
+    {
+        InputStateSampler::unsubscribe(this);
+    }
+}
+
+/**
+ * @brief Only sample input state while the widget is shown so the shared
+ *     sample timer stops when no window is open.
+ * @param Show event
+ */
+void FlashButtonWidget::showEvent(QShowEvent *event)
+{
+    QPushButton::showEvent(event);
+
+    if (!sampling)
+    {
+        InputStateSampler::subscribe(this, SLOT(checkLabelRefresh()));
+        sampling = true;
+        checkLabelRefresh();
+    }
+}
+
+void FlashButtonWidget::hideEvent(QHideEvent *event)
+{
+    if (sampling)
+    {
+        InputStateSampler::unsubscribe(this);
+        sampling = false;
+    }
+
+    QPushButton::hideEvent(event);
+}
+
+/**
+ * @brief Get a value that changes whenever the label of the widget
+ *     could have changed. Child classes that display an active zone
+ *     summary should return the version of the associated buttons.
+ * @return Active zone version
+ */
+int FlashButtonWidget::getActiveZoneVersion()
+{
+    return lastActiveZoneVersion;
+}
+
+/**
+ * @brief Check if the associated input is currently active. Used to
+ *     decide if the widget should be flashing.
+ * @return Whether the input is active
+ */
+bool FlashButtonWidget::isInputActive()
+{
+    return false;
+}
+
+/**
+ * @brief Called by the shared sample timer. Update the flash state and
+ *     the label of a visible widget if the associated input has changed.
+ */
+void FlashButtonWidget::checkLabelRefresh()
+{
+    if (isVisible())
+    {
+        if (flashesEnabled)
+        {
+            bool inputActive = isInputActive();
+            if (inputActive && !isflashing)
+            {
+                flash();
+            }
+            else if (!inputActive && isflashing)
+            {
+                unflash();
+            }
+        }
+
+        int version = getActiveZoneVersion();
+        if (version != lastActiveZoneVersion)
+        {
+            lastActiveZoneVersion = version;
+            refreshLabel();
+        }
+    }
 }
 
 void FlashButtonWidget::flash()
@@ -60,7 +155,12 @@ void FlashButtonWidget::unflash()
 
 void FlashButtonWidget::refreshLabel()
 {
-    setText(generateLabel());
+    QString label = generateLabel();
+    if (label != text())
+    {
+        setText(label);
+        updateTextFit();
+    }
 }
 
 bool FlashButtonWidget::isButtonFlashing()
@@ -84,46 +184,65 @@ bool FlashButtonWidget::isDisplayingNames()
     return displayNames;
 }
 
-void FlashButtonWidget::paintEvent(QPaintEvent *event)
+void FlashButtonWidget::resizeEvent(QResizeEvent *event)
 {
-    QPainter painter(this);
-
-    QFont tempScaledFont = painter.font();
-    QFont temp;
-    tempScaledFont.setPointSize(temp.pointSize());
-    QFontMetrics fm(tempScaledFont);
+    QPushButton::resizeEvent(event);
 
-    bool reduce = false;
-    while ((this->width() < fm.width(text())) && tempScaledFont.pointSize() >= 7)
+    if (event->size().width() != event->oldSize().width())
     {
-        tempScaledFont.setPointSize(tempScaledFont.pointSize()-1);
-        painter.setFont(tempScaledFont);
-        fm = painter.fontMetrics();
-        reduce = true;
+        updateTextFit();
     }
+}
+
+/**
+ * @brief Shrink the font until the label fits in the width of the widget.
+ *     The result is cached so painting never has to measure text. Only
+ *     recalculated when the label or the width of the widget changes.
+ */
+void FlashButtonWidget::updateTextFit()
+{
+    QString currentText = text();
+    int currentWidth = this->width();
 
-    bool changeFontSize = this->font().pointSize() != tempScaledFont.pointSize();
-    if (changeFontSize)
+    if (currentText != fittedText || currentWidth != fittedWidth)
     {
-        if (reduce && !leftAlignText)
+        fittedText = currentText;
+        fittedWidth = currentWidth;
+
+        QFont tempScaledFont = this->font();
+        QFont temp;
+        tempScaledFont.setPointSize(temp.pointSize());
+        QFontMetrics fm(tempScaledFont);
+
+        bool reduce = false;
+        while ((currentWidth < fm.width(currentText)) && tempScaledFont.pointSize() >= 7)
         {
-            leftAlignText = !leftAlignText;
-            setStyleSheet("text-align: left;");
-            this->style()->unpolish(this);
-            this->style()->polish(this);
+            tempScaledFont.setPointSize(tempScaledFont.pointSize()-1);
+            fm = QFontMetrics(tempScaledFont);
+            reduce = true;
         }
-        else if (!reduce && leftAlignText)
+
+        bool changeFontSize = this->font().pointSize() != tempScaledFont.pointSize();
+        if (changeFontSize)
         {
-            leftAlignText = !leftAlignText;
-            setStyleSheet("text-align: center;");
-            this->style()->unpolish(this);
-            this->style()->polish(this);
+            if (reduce && !leftAlignText)
+            {
+                leftAlignText = !leftAlignText;
+                setStyleSheet("text-align: left;");
+                this->style()->unpolish(this);
+                this->style()->polish(this);
+            }
+            else if (!reduce && leftAlignText)
+            {
+                leftAlignText = !leftAlignText;
+                setStyleSheet("text-align: center;");
+                this->style()->unpolish(this);
+                this->style()->polish(this);
+            }
+
+            this->setFont(tempScaledFont);
         }
-
-        this->setFont(tempScaledFont);
     }
-
-    QPushButton::paintEvent(event);
 }
 
 void FlashButtonWidget::retranslateUi()
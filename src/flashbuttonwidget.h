@@ -19,7 +19,10 @@
 #define FLASHBUTTONWIDGET_H
 
 #include <QPushButton>
-#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QString>
 
 class FlashButtonWidget : public QPushButton
 {
@@ -29,19 +32,34 @@ class FlashButtonWidget : public QPushButton
 public:
     explicit FlashButtonWidget(QWidget *parent = 0);
     explicit FlashButtonWidget(bool displayNames, QWidget *parent = 0);
+    ~FlashButtonWidget();
 
     bool isButtonFlashing();
     void setDisplayNames(bool display);
     bool isDisplayingNames();
 
 protected:
-    virtual void paintEvent(QPaintEvent *event);
+    virtual void resizeEvent(QResizeEvent *event);
+    virtual void showEvent(QShowEvent *event);
+    virtual void hideEvent(QHideEvent *event);
+    void updateTextFit();
     virtual QString generateLabel() = 0;
     virtual void retranslateUi();
+    virtual int getActiveZoneVersion();
+    virtual bool isInputActive();
 
     bool isflashing;
     bool displayNames;
     bool leftAlignText;
+    bool flashesEnabled;
+    int lastActiveZoneVersion;
+
+    // Text and width used for the last font fit. The fit is only
+    // recalculated when either changes.
+    QString fittedText;
+    int fittedWidth;
+    // Subscribed to the shared sample timer while the widget is shown.
+    bool sampling;
 
 signals:
     void flashed(bool flashing);
@@ -55,6 +73,7 @@ public slots:
 protected slots:
     void flash();
     void unflash();
+    void checkLabelRefresh();
 };
 
 #endif // FLASHBUTTONWIDGET_H
@@ -344,11 +344,14 @@ void GameControllerMappingDialog::saveChanges()
 
     settings->setValue(QString("Mappings/").append(device->getGUIDString()), mappingString);
     settings->setValue(QString("Mappings/%1%2").arg(device->getGUIDString()).arg("Disable"), "0");
-    settings->sync();
 
     bool displayMapping = settings->runtimeValue("DisplaySDLMapping", false).toBool();
     settings->getLock()->unlock();
 
+    // Mapping has to be visible to the input thread before the device
+    // gets opened again.
+    settings->flushSettings();
+
     if (displayMapping)
     {
         QTextStream out(stdout);
@@ -476,9 +479,9 @@ void GameControllerMappingDialog::removeControllerMapping()
     settings->remove(device->getGUIDString());
     settings->remove(QString("%1Disable").arg(device->getGUIDString()));
     settings->endGroup();
-    settings->sync();
 
     settings->getLock()->unlock();
+    settings->flushSettings();
 }
 
 void GameControllerMappingDialog::enableDeviceConnections()
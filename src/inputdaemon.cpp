@@ -20,6 +20,7 @@
 #include <QTimer>
 #include <QEventLoop>
 #include <QMapIterator>
+#include <QVarLengthArray>
 
 #include "inputdaemon.h"
 #include "logger.h"
@@ -29,6 +30,35 @@
 #define USE_NEW_REFRESH
 
 const int InputDaemon::GAMECONTROLLERTRIGGERRELEASE = 16384;
+const int InputDaemon::EVENTBUFFERSIZE = 256;
+
+// Devices that received events in a single poll. More devices than this
+// spill to the heap.
+static const int MAXACTIVEDEVICES = 16;
+typedef QVarLengthArray<InputDevice*, MAXACTIVEDEVICES> ActiveDeviceList;
+
+static void markActiveDevice(ActiveDeviceList &activeDevices, InputDevice *device)
+{
+    bool found = false;
+    for (int i=0; i < activeDevices.size() && !found; i++)
+    {
+        found = activeDevices.at(i) == device;
+    }
+
+    if (!found)
+    {
+        activeDevices.append(device);
+    }
+}
+
+static void activateDeviceEvents(InputDevice *device)
+{
+    device->activatePossibleControlStickEvents();
+    device->activatePossibleAxisEvents();
+    device->activatePossibleDPadEvents();
+    device->activatePossibleVDPadEvents();
+    device->activatePossibleButtonEvents();
+}
 
 InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks,
                          AntiMicroSettings *settings,
@@ -40,6 +70,16 @@ InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks,
     this->stopped = false;
     this->graphical = graphical;
     this->settings = settings;
+    this->pollStamp = 0;
+    this->eventCount = 0;
+    this->perDeviceDispatch = settings->cachedValue("PerDeviceDispatch", false).toBool();
+    eventBuffer.resize(EVENTBUFFERSIZE);
+
+#ifdef USE_SDL_2
+    mappingDatabase = new ControllerMappingDatabase(
+                QString(PadderCommon::configPath()).append("/")
+                .append(PadderCommon::mappingDatabaseFileName));
+#endif
 
     eventWorker = new SDLEventReader(joysticks, settings);
     refreshJoysticks();
@@ -93,6 +133,13 @@ InputDaemon::~InputDaemon()
         delete sdlWorkerThread;
         sdlWorkerThread = 0;
     }
+
+    clearBitArrayStatusInstances();
+
+#ifdef USE_SDL_2
+    delete mappingDatabase;
+    mappingDatabase = 0;
+#endif
 }
 
 void InputDaemon::startWorker()
@@ -115,18 +162,7 @@ void InputDaemon::run ()
     {
         //Logger::LogInfo(QString("Gamepad Poll %1").arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
         JoyButton::resetActiveButtonMouseDistances();
-
-        QQueue<SDL_Event> sdlEventQueue;
-
-        firstInputPass(&sdlEventQueue);
-
-#ifdef USE_SDL_2
-        modifyUnplugEvents(&sdlEventQueue);
-#endif
-
-        secondInputPass(&sdlEventQueue);
-
-        clearBitArrayStatusInstances();
+        processPendingEvents();
     }
 
     if (stopped)
@@ -147,6 +183,33 @@ void InputDaemon::run ()
     PadderCommon::inputDaemonMutex.unlock();
 }
 
+/**
+ * @brief Read all events waiting in SDL and pass them to the devices.
+ *     Events are handled in batches of at most EVENTBUFFERSIZE. A full
+ *     buffer means more events may still be waiting in SDL. Does not
+ *     allocate once the status entries of the active devices exist.
+ */
+void InputDaemon::processPendingEvents()
+{
+    bool moreEvents = true;
+    while (moreEvents && !stopped)
+    {
+        // Status entries touched with an older stamp are refilled on
+        // first use during this batch.
+        pollStamp++;
+
+        int readCount = firstInputPass();
+
+#ifdef USE_SDL_2
+        modifyUnplugEvents();
+#endif
+
+        secondInputPass();
+
+        moreEvents = readCount == eventBuffer.size();
+    }
+}
+
 void InputDaemon::refreshJoysticks()
 {
     QMapIterator<SDL_JoystickID, InputDevice*> iter(*joysticks);
@@ -162,17 +225,20 @@ void InputDaemon::refreshJoysticks()
     }
 
     joysticks->clear();
+    clearBitArrayStatusInstances();
+    JoyButton::releaseAllActiveKeys();
+
 #ifdef USE_SDL_2
     trackjoysticks.clear();
     trackcontrollers.clear();
-
-    settings->getLock()->lock();
-    settings->beginGroup("Mappings");
+    deviceMappings.clear();
 #endif
 
     for (int i=0; i < SDL_NumJoysticks(); i++)
     {
 #ifdef USE_SDL_2
+        QByteArray mapping = registerDeviceMapping(i);
+
 #ifdef USE_NEW_REFRESH
         int index = i;
 
@@ -197,7 +263,7 @@ void InputDaemon::refreshJoysticks()
                     SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
                     temp = QString(guidString);
 
-                    bool disableGameController = settings->value(QString("%1Disable").arg(temp), false).toBool();
+                    bool disableGameController = settings->cachedValue(QString("Mappings/%1Disable").arg(temp), false).toBool();
 
                     //settings->endGroup();
                     //settings->getLock()->unlock();
@@ -275,7 +341,7 @@ void InputDaemon::refreshJoysticks()
             SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
             temp = QString(guidString);
 
-            bool disableGameController = settings->value(QString("%1Disable").arg(temp), false).toBool();
+            bool disableGameController = settings->cachedValue(QString("Mappings/%1Disable").arg(temp), false).toBool();
 
             if (SDL_IsGameController(i) && !disableGameController)
             {
@@ -298,6 +364,8 @@ void InputDaemon::refreshJoysticks()
         }
 #endif
 
+        rememberDeviceMapping(i, mapping);
+
 #else
         SDL_Joystick *joystick = SDL_JoystickOpen(i);
         if (joystick)
@@ -310,11 +378,6 @@ void InputDaemon::refreshJoysticks()
 #endif
     }
 
-#ifdef USE_SDL_2
-    settings->endGroup();
-    settings->getLock()->unlock();
-#endif
-
     emit joysticksRefreshed(joysticks);
 }
 
@@ -333,10 +396,15 @@ void InputDaemon::deleteJoysticks()
     }
 
     joysticks->clear();
+    clearBitArrayStatusInstances();
 #ifdef USE_SDL_2
     trackjoysticks.clear();
     trackcontrollers.clear();
+    deviceMappings.clear();
 #endif
+
+    // Make sure no output is left held once every device is gone.
+    JoyButton::releaseAllActiveKeys();
 }
 
 void InputDaemon::stop()
@@ -347,6 +415,12 @@ void InputDaemon::stop()
 
 void InputDaemon::refresh()
 {
+#ifdef USE_SDL_2
+    // SDL 2 reports device changes. Only open and close the devices that
+    // changed instead of restarting SDL and rebuilding every device.
+    Logger::LogInfo("Refreshing joystick list");
+    refreshDevicesIncremental();
+#else
     stop();
 
     Logger::LogInfo("Refreshing joystick list");
@@ -374,6 +448,7 @@ void InputDaemon::refresh()
     QTimer::singleShot(100, eventWorker, SLOT(performWork()));
 
     stopped = false;
+#endif
 }
 
 void InputDaemon::refreshJoystick(InputDevice *joystick)
@@ -423,6 +498,11 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
         {
             found = true;
 
+            RegisteredMapping entry;
+            entry.mapping = mapping.toUtf8();
+            entry.fromDatabase = false;
+            registeredMappings.insert(device->getGUIDString(), entry);
+
             if (SDL_IsGameController(i))
             {
                 // Mapping string updated. Perform basic refresh
@@ -442,6 +522,7 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     device->closeSDLDevice();
                     trackjoysticks.remove(joystickID);
                     joysticks->remove(joystickID);
+                    removeBitStatusEntries(device);
 
                     SDL_GameController *controller = SDL_GameControllerOpen(i);
                     GameController *damncontroller = new GameController(controller, i, settings, this);
@@ -453,6 +534,8 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     emit deviceUpdated(i, damncontroller);
                 }
             }
+
+            deviceMappings.insert(joystickID, entry.mapping);
         }
 
         // Make sure to decrement reference count
@@ -469,6 +552,8 @@ void InputDaemon::removeDevice(InputDevice *device)
         joysticks->remove(deviceID);
         trackjoysticks.remove(deviceID);
         trackcontrollers.remove(deviceID);
+        deviceMappings.remove(deviceID);
+        removeBitStatusEntries(device);
 
         refreshIndexes();
 
@@ -476,6 +561,87 @@ void InputDaemon::removeDevice(InputDevice *device)
     }
 }
 
+/**
+ * @brief Compare the devices reported by SDL with the tracked devices.
+ *     Devices that are gone are removed and new devices are opened.
+ *     Devices that stay connected keep their state and loaded profile
+ *     unless their mapping or Disable setting changed. Those devices
+ *     are opened again. The SDL joystick subsystem is never restarted.
+ */
+void InputDaemon::refreshDevicesIncremental()
+{
+    QList<SDL_JoystickID> connectedIDs;
+    QList<int> newDeviceIndexes;
+    QList<InputDevice*> outdatedDevices;
+    QList<int> outdatedDeviceIndexes;
+
+    for (int i = 0; i < SDL_NumJoysticks(); i++)
+    {
+        SDL_Joystick *joystick = SDL_JoystickOpen(i);
+        if (joystick)
+        {
+            SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
+            connectedIDs.append(joystickID);
+            if (!joysticks->contains(joystickID))
+            {
+                newDeviceIndexes.append(i);
+            }
+            else if (isDeviceOutdated(i, joysticks->value(joystickID)))
+            {
+                outdatedDevices.append(joysticks->value(joystickID));
+                outdatedDeviceIndexes.append(i);
+            }
+
+            // Make sure to decrement reference count
+            SDL_JoystickClose(joystick);
+        }
+    }
+
+    QList<InputDevice*> removedDevices;
+    QMapIterator<SDL_JoystickID, InputDevice*> iter(*joysticks);
+    while (iter.hasNext())
+    {
+        iter.next();
+        if (!connectedIDs.contains(iter.key()))
+        {
+            removedDevices.append(iter.value());
+        }
+    }
+
+    QListIterator<InputDevice*> removeIter(removedDevices);
+    while (removeIter.hasNext())
+    {
+        InputDevice *device = removeIter.next();
+        Logger::LogInfo(QString("Removing joystick #%1 [%2]")
+                        .arg(device->getRealJoyNumber())
+                        .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
+
+        removeDevice(device);
+    }
+
+    for (int i = 0; i < outdatedDevices.size(); i++)
+    {
+        InputDevice *device = outdatedDevices.at(i);
+        Logger::LogInfo(QString("Reopening joystick #%1 after a mapping change [%2]")
+                        .arg(device->getRealJoyNumber())
+                        .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
+
+        // Release held outputs. The device is closed by the GUI once its
+        // tab is gone.
+        device->getActiveSetJoystick()->release();
+        activateDeviceEvents(device);
+
+        removeDevice(device);
+        addInputDevice(outdatedDeviceIndexes.at(i));
+    }
+
+    QListIterator<int> addIter(newDeviceIndexes);
+    while (addIter.hasNext())
+    {
+        addInputDevice(addIter.next());
+    }
+}
+
 void InputDaemon::refreshIndexes()
 {
     for (int i = 0; i < SDL_NumJoysticks(); i++)
@@ -495,6 +661,8 @@ void InputDaemon::refreshIndexes()
 
 void InputDaemon::addInputDevice(int index)
 {
+    QByteArray mapping = registerDeviceMapping(index);
+
   #ifdef USE_NEW_ADD
     // Check if device is considered a Game Controller at the start.
     if (SDL_IsGameController(index))
@@ -508,19 +676,13 @@ void InputDaemon::addInputDevice(int index)
             // Check if device has already been grabbed.
             if (!joysticks->contains(tempJoystickID))
             {
-                settings->getLock()->lock();
-                settings->beginGroup("Mappings");
-
                 QString temp;
                 SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(sdlStick);
                 char guidString[65] = {'0'};
                 SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
                 temp = QString(guidString);
 
-                bool disableGameController = settings->value(QString("%1Disable").arg(temp), false).toBool();
-
-                settings->endGroup();
-                settings->getLock()->unlock();
+                bool disableGameController = settings->cachedValue(QString("Mappings/%1Disable").arg(temp), false).toBool();
 
                 // Check if user has designated device Joystick mode.
                 if (!disableGameController)
@@ -603,16 +765,13 @@ void InputDaemon::addInputDevice(int index)
 
         if (!joysticks->contains(tempJoystickID))
         {
-            settings->getLock()->lock();
-            settings->beginGroup("Mappings");
-
             QString temp;
             SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joystick);
             char guidString[65] = {'0'};
             SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
             temp = QString(guidString);
 
-            bool disableGameController = settings->value(QString("%1Disable").arg(temp), false).toBool();
+            bool disableGameController = settings->cachedValue(QString("Mappings/%1Disable").arg(temp), false).toBool();
 
             if (SDL_IsGameController(index) && !disableGameController)
             {
@@ -631,17 +790,9 @@ void InputDaemon::addInputDevice(int index)
                         joysticks->insert(tempJoystickID, damncontroller);
                         trackcontrollers.insert(tempJoystickID, damncontroller);
 
-                        settings->endGroup();
-                        settings->getLock()->unlock();
-
                         emit deviceAdded(damncontroller);
                     }
                 }
-                else
-                {
-                    settings->endGroup();
-                    settings->getLock()->unlock();
-                }
             }
             else
             {
@@ -649,9 +800,6 @@ void InputDaemon::addInputDevice(int index)
                 joysticks->insert(tempJoystickID, curJoystick);
                 trackjoysticks.insert(tempJoystickID, curJoystick);
 
-                settings->endGroup();
-                settings->getLock()->unlock();
-
                 emit deviceAdded(curJoystick);
             }
         }
@@ -662,6 +810,8 @@ void InputDaemon::addInputDevice(int index)
         }
     }
 #endif
+
+    rememberDeviceMapping(index, mapping);
 }
 
 Joystick *InputDaemon::openJoystickDevice(int index)
@@ -682,33 +832,191 @@ Joystick *InputDaemon::openJoystickDevice(int index)
     return curJoystick;
 }
 
+/**
+ * @brief Hand the mapping for a device to SDL before the device is
+ *     checked for game controller support. A mapping stored in the
+ *     settings takes precedence over the mapping database. A GUID is
+ *     looked up again when its mapping setting differs from the mapping
+ *     handed to SDL or when the database file has changed.
+ * @param SDL device index
+ * @return Mapping registered for the device or an empty array if the
+ *     device has no mapping
+ */
+QByteArray InputDaemon::registerDeviceMapping(int index)
+{
+    SDL_JoystickGUID tempGUID = SDL_JoystickGetDeviceGUID(index);
+    char guidString[65] = {'0'};
+    SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
+    QString guid(guidString);
+
+    QByteArray mapping = settings->cachedValue(QString("Mappings/%1").arg(guid),
+                                               QString()).toString().toUtf8();
+    bool fromDatabase = mapping.isEmpty();
+    QDateTime databaseModified;
+    if (fromDatabase)
+    {
+        databaseModified = mappingDatabase->lastModified();
+    }
+
+    bool current = false;
+    if (registeredMappings.contains(guid))
+    {
+        RegisteredMapping entry = registeredMappings.value(guid);
+        if (fromDatabase)
+        {
+            current = entry.fromDatabase && entry.databaseModified == databaseModified;
+        }
+        else
+        {
+            current = !entry.fromDatabase && entry.mapping == mapping;
+        }
+    }
+
+    if (!current)
+    {
+        if (fromDatabase)
+        {
+            mapping = mappingDatabase->findMapping(guid);
+        }
+
+        if (!mapping.isEmpty())
+        {
+            RegisteredMapping entry;
+            entry.mapping = mapping;
+            entry.fromDatabase = fromDatabase;
+            entry.databaseModified = databaseModified;
+            registeredMappings.insert(guid, entry);
+
+            SDL_GameControllerAddMapping(mapping.constData()); // Let SDL take care of validation
+        }
+        else
+        {
+            registeredMappings.remove(guid);
+        }
+    }
+
+    return registeredMappings.value(guid).mapping;
+}
+
+/**
+ * @brief Store the mapping an opened device was checked with so a later
+ *     refresh can tell whether the device has to be opened again.
+ * @param SDL device index
+ * @param Mapping returned by registerDeviceMapping
+ */
+void InputDaemon::rememberDeviceMapping(int index, const QByteArray &mapping)
+{
+    SDL_Joystick *joystick = SDL_JoystickOpen(index);
+    if (joystick)
+    {
+        SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
+        if (joysticks->contains(joystickID))
+        {
+            deviceMappings.insert(joystickID, mapping);
+        }
+
+        // Make sure to decrement reference count
+        SDL_JoystickClose(joystick);
+    }
+}
+
+/**
+ * @brief Check whether a connected device has to be opened again because
+ *     its mapping or its Disable setting changed since it was opened.
+ *     SDL has no way to drop a mapping. A removed mapping without a
+ *     database entry stays active in SDL until the program is restarted.
+ * @param SDL device index
+ * @param Device opened for the index
+ * @return Whether the device is outdated
+ */
+bool InputDaemon::isDeviceOutdated(int index, InputDevice *device)
+{
+    SDL_JoystickID joystickID = device->getSDLJoystickID();
+    QByteArray openedMapping = deviceMappings.value(joystickID);
+    QByteArray mapping = registerDeviceMapping(index);
+
+    if (mapping.isEmpty() && !openedMapping.isEmpty())
+    {
+        Logger::LogInfo(QString("Mapping of joystick #%1 was removed. SDL keeps using it "
+                                "until antimicro is restarted.")
+                        .arg(device->getRealJoyNumber()));
+
+        // Only report the removal once.
+        deviceMappings.insert(joystickID, mapping);
+        openedMapping = mapping;
+    }
+
+    bool disableGameController = settings->cachedValue(
+                QString("Mappings/%1Disable").arg(device->getGUIDString()), false).toBool();
+    bool openedAsController = trackcontrollers.contains(joystickID);
+    bool useController = SDL_IsGameController(index) && !disableGameController;
+
+    bool result = openedAsController != useController ||
+            (useController && mapping != openedMapping);
+    return result;
+}
+
 #endif
 
+/**
+ * @brief Grab the status entry for a device. Entries are allocated once
+ *     per device and refilled the first time they are used in a poll.
+ * @param Hash holding the entries
+ * @param Device to check
+ * @param Whether a refilled entry should read the current state of the
+ *     active set
+ * @return Status entry for the device
+ */
 InputDeviceBitArrayStatus*
 InputDaemon::createOrGrabBitStatusEntry(QHash<InputDevice *, InputDeviceBitArrayStatus *> *statusHash,
                                         InputDevice *device, bool readCurrent)
 {
-    InputDeviceBitArrayStatus *bitArrayStatus = 0;
+    InputDeviceBitArrayStatus *bitArrayStatus = statusHash->value(device, 0);
 
-    if (!statusHash->contains(device))
+    if (!bitArrayStatus)
     {
-        bitArrayStatus = new InputDeviceBitArrayStatus(device, readCurrent);
+        bitArrayStatus = new InputDeviceBitArrayStatus();
         statusHash->insert(device, bitArrayStatus);
     }
-    else
+
+    if (bitArrayStatus->getPollStamp() != pollStamp)
     {
-        bitArrayStatus = statusHash->value(device);
+        bitArrayStatus->reset(device, readCurrent);
+        bitArrayStatus->setPollStamp(pollStamp);
     }
 
     return bitArrayStatus;
 }
 
-void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
+/**
+ * @brief Read pending SDL events into the event buffer in bulk. Events
+ *     that will not be handled are dropped from the buffer.
+ * @return Number of events read from SDL
+ */
+int InputDaemon::firstInputPass()
 {
-    SDL_Event event;
+    int readCount = 0;
+    eventCount = 0;
 
-    while (SDL_PollEvent(&event) > 0)
+    SDL_PumpEvents();
+#ifdef USE_SDL_2
+    readCount = SDL_PeepEvents(eventBuffer.data(), eventBuffer.size(),
+                               SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+#else
+    readCount = SDL_PeepEvents(eventBuffer.data(), eventBuffer.size(),
+                               SDL_GETEVENT, 0xFFFF);
+#endif
+
+    if (readCount < 0)
+    {
+        Logger::LogError(QString("SDL Error: %1").arg(QString(SDL_GetError())));
+        readCount = 0;
+    }
+
+    for (int i=0; i < readCount; i++)
     {
+        SDL_Event event = eventBuffer.at(i);
+
         switch (event.type)
         {
             case SDL_JOYBUTTONDOWN:
@@ -732,13 +1040,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeButtonStatus(event.jbutton.button,
                                                   event.type == SDL_JOYBUTTONDOWN ? true : false);
-                        sdlEventQueue->append(event);
+                        eventBuffer[eventCount++] = event;
                     }
                 }
 #ifdef USE_SDL_2
                 else
                 {
-                    sdlEventQueue->append(event);
+                    eventBuffer[eventCount++] = event;
                 }
 #endif
 
@@ -763,13 +1071,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeAxesStatus(event.jaxis.axis, !axis->inDeadZone(event.jaxis.value));
-                        sdlEventQueue->append(event);
+                        eventBuffer[eventCount++] = event;
                     }
                 }
 #ifdef USE_SDL_2
                 else
                 {
-                    sdlEventQueue->append(event);
+                    eventBuffer[eventCount++] = event;
                 }
 #endif
 
@@ -794,13 +1102,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeHatStatus(event.jhat.hat, event.jhat.value != 0 ? true : false);
-                        sdlEventQueue->append(event);
+                        eventBuffer[eventCount++] = event;
                     }
                 }
 #ifdef USE_SDL_2
                 else
                 {
-                    sdlEventQueue->append(event);
+                    eventBuffer[eventCount++] = event;
                 }
 #endif
 
@@ -830,7 +1138,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeAxesStatus(event.caxis.axis, !axis->inDeadZone(event.caxis.value));
-                        sdlEventQueue->append(event);
+                        eventBuffer[eventCount++] = event;
                     }
                 }
                 break;
@@ -853,7 +1161,7 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeButtonStatus(event.cbutton.button,
                                                   event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
-                        sdlEventQueue->append(event);
+                        eventBuffer[eventCount++] = event;
                     }
                 }
 
@@ -862,21 +1170,23 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
             case SDL_JOYDEVICEREMOVED:
             case SDL_JOYDEVICEADDED:
             {
-                sdlEventQueue->append(event);
+                eventBuffer[eventCount++] = event;
                 break;
             }
 #endif
             case SDL_QUIT:
             {
-                sdlEventQueue->append(event);
+                eventBuffer[eventCount++] = event;
                 break;
             }
         }
     }
+
+    return readCount;
 }
 
 #ifdef USE_SDL_2
-void InputDaemon::modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue)
+void InputDaemon::modifyUnplugEvents()
 {
     QHashIterator<InputDevice*, InputDeviceBitArrayStatus*> genIter(releaseEventsGenerated);
     while (genIter.hasNext())
@@ -884,43 +1194,32 @@ void InputDaemon::modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue)
         genIter.next();
         InputDevice *device = genIter.key();
         InputDeviceBitArrayStatus *generatedTemp = genIter.value();
-        QBitArray tempBitArray = generatedTemp->generateFinalBitArray();
-        //qDebug() << "ARRAY: " << tempBitArray;
 
-        unsigned int bitArraySize = tempBitArray.size();
-        //qDebug() << "ARRAY SIZE: " << bitArraySize;
+        // Entry was not used during the current poll.
+        if (generatedTemp->getPollStamp() != pollStamp)
+        {
+            continue;
+        }
 
-        if (bitArraySize > 0 && tempBitArray.count(true) == device->getNumberAxes())
+        if (generatedTemp->size() > 0 && generatedTemp->countActive() == device->getNumberAxes())
         {
-            if (pendingEventValues.contains(device))
+            InputDeviceBitArrayStatus *pendingTemp = pendingEventValues.value(device, 0);
+            if (pendingTemp && pendingTemp->getPollStamp() == pollStamp)
             {
-                InputDeviceBitArrayStatus *pendingTemp = pendingEventValues.value(device);
-                QBitArray pendingBitArray = pendingTemp->generateFinalBitArray();
-                QBitArray unplugBitArray = createUnplugEventBitArray(device);
-                unsigned int pendingBitArraySize = pendingBitArray.size();
+                InputDeviceBitArrayStatus *unplugTemp = createUnplugEventBitArray(device);
 
-                if (bitArraySize == pendingBitArraySize &&
-                    pendingBitArray == unplugBitArray)
+                if (generatedTemp->size() == pendingTemp->size() &&
+                    pendingTemp->hasSameStatus(unplugTemp))
                 {
-                    QQueue<SDL_Event> tempQueue;
-                    while (!sdlEventQueue->isEmpty())
+                    // Replace the release values for the device in place.
+                    for (int i=0; i < eventCount; i++)
                     {
-                        SDL_Event event = sdlEventQueue->dequeue();
+                        SDL_Event &event = eventBuffer[i];
                         switch (event.type)
                         {
-                            case SDL_JOYBUTTONDOWN:
-                            case SDL_JOYBUTTONUP:
-                            {
-                                tempQueue.enqueue(event);
-                                break;
-                            }
                             case SDL_JOYAXISMOTION:
                             {
-                                if (event.jaxis.which != device->getSDLJoystickID())
-                                {
-                                    tempQueue.enqueue(event);
-                                }
-                                else
+                                if (event.jaxis.which == device->getSDLJoystickID())
                                 {
                                     InputDevice *joy = trackjoysticks.value(event.jaxis.which);
 
@@ -935,24 +1234,13 @@ void InputDaemon::modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue)
                                             }
                                         }
                                     }
-
-                                    tempQueue.enqueue(event);
                                 }
 
                                 break;
                             }
-                            case SDL_JOYHATMOTION:
-                            {
-                                tempQueue.enqueue(event);
-                                break;
-                            }
                             case SDL_CONTROLLERAXISMOTION:
                             {
-                                if (event.caxis.which != device->getSDLJoystickID())
-                                {
-                                    tempQueue.enqueue(event);
-                                }
-                                else
+                                if (event.caxis.which == device->getSDLJoystickID())
                                 {
                                     InputDevice *joy = trackcontrollers.value(event.caxis.which);
                                     if (joy)
@@ -968,33 +1256,16 @@ void InputDaemon::modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue)
                                             }
                                         }
                                     }
-
-                                    tempQueue.enqueue(event);
                                 }
 
                                 break;
                             }
-                            case SDL_CONTROLLERBUTTONDOWN:
-                            case SDL_CONTROLLERBUTTONUP:
-                            {
-
-                                tempQueue.enqueue(event);
-                                break;
-                            }
-                            case SDL_JOYDEVICEREMOVED:
-                            case SDL_JOYDEVICEADDED:
-                            {
-                                tempQueue.enqueue(event);
-                                break;
-                            }
                             default:
                             {
-                                tempQueue.enqueue(event);
+                                break;
                             }
                         }
                     }
-
-                    sdlEventQueue->swap(tempQueue);
                 }
             }
         }
@@ -1003,31 +1274,39 @@ void InputDaemon::modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue)
 #endif
 
 #ifdef USE_SDL_2
-QBitArray InputDaemon::createUnplugEventBitArray(InputDevice *device)
+/**
+ * @brief Fill the status expected when a device is unplugged. The same
+ *     instance is reused for every check.
+ * @param Device to check
+ * @return Status with only the axes that use a throttle marked
+ */
+InputDeviceBitArrayStatus* InputDaemon::createUnplugEventBitArray(InputDevice *device)
 {
-    InputDeviceBitArrayStatus tempStatus(device, false);
+    unplugEventValues.reset(device, false);
 
     for (int i=0; i < device->getNumberRawAxes(); i++)
     {
         JoyAxis *axis = device->getActiveSetJoystick()->getJoyAxis(i);
         if (axis && axis->getThrottle() != JoyAxis::NormalThrottle)
         {
-            tempStatus.changeAxesStatus(i, true);
+            unplugEventValues.changeAxesStatus(i, true);
         }
     }
 
-    QBitArray unplugBitArray = tempStatus.generateFinalBitArray();
-    return unplugBitArray;
+    return &unplugEventValues;
 }
 #endif
 
-void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
+void InputDaemon::secondInputPass()
 {
-    QHash<SDL_JoystickID, InputDevice*> activeDevices;
+    ActiveDeviceList activeDevices;
+    // Device whose run of events is being queued in per-device dispatch.
+    InputDevice *dispatchDevice = 0;
 
-    while (!sdlEventQueue->isEmpty())
+    for (int i=0; i < eventCount; i++)
     {
-        SDL_Event event = sdlEventQueue->dequeue();
+        SDL_Event event = eventBuffer.at(i);
+        InputDevice *eventDevice = 0;
 
         switch (event.type)
         {
@@ -1047,13 +1326,18 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (button)
                     {
+                        // Apply the earlier change of the button first so
+                        // a press and release in one batch are both seen.
+                        if (perDeviceDispatch && button->hasPendingEvent())
+                        {
+                            activateDeviceEvents(joy);
+                        }
+
                         //button->joyEvent(event.type == SDL_JOYBUTTONDOWN ? true : false);
                         button->queuePendingEvent(event.type == SDL_JOYBUTTONDOWN ? true : false);
 
-                        if (!activeDevices.contains(event.jbutton.which))
-                        {
-                            activeDevices.insert(event.jbutton.which, joy);
-                        }
+                        markActiveDevice(activeDevices, joy);
+                        eventDevice = joy;
                     }
                 }
 #ifdef USE_SDL_2
@@ -1080,13 +1364,18 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                     JoyAxis *axis = set->getJoyAxis(event.jaxis.axis);
                     if (axis)
                     {
+                        // Do not overwrite a queued value that activates,
+                        // releases or reverses the axis.
+                        if (perDeviceDispatch && axis->hasPendingStateChange())
+                        {
+                            activateDeviceEvents(joy);
+                        }
+
                         //axis->joyEvent(event.jaxis.value);
                         axis->queuePendingEvent(event.jaxis.value);
 
-                        if (!activeDevices.contains(event.jaxis.which))
-                        {
-                            activeDevices.insert(event.jaxis.which, joy);
-                        }
+                        markActiveDevice(activeDevices, joy);
+                        eventDevice = joy;
                     }
 
                     joy->rawAxisEvent(event.jaxis.which, event.jaxis.value);
@@ -1115,13 +1404,24 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                     JoyDPad *dpad = set->getJoyDPad(event.jhat.hat);
                     if (dpad)
                     {
+                        if (perDeviceDispatch)
+                        {
+                            // The hat is applied immediately. Activate the
+                            // events queued before it so they keep their order.
+                            if (dispatchDevice && dispatchDevice != joy)
+                            {
+                                activateDeviceEvents(dispatchDevice);
+                            }
+
+                            activateDeviceEvents(joy);
+                            dispatchDevice = joy;
+                        }
+
                         //dpad->joyEvent(event.jhat.value);
                         dpad->joyEvent(event.jhat.value);
 
-                        if (!activeDevices.contains(event.jhat.which))
-                        {
-                            activeDevices.insert(event.jhat.which, joy);
-                        }
+                        markActiveDevice(activeDevices, joy);
+                        eventDevice = joy;
                     }
                 }
 #ifdef USE_SDL_2
@@ -1147,13 +1447,16 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                     {
                         //qDebug() << QTime::currentTime() << ": " << "Axis " << event.caxis.axis+1
                         //         << ": " << event.caxis.value;
+                        if (perDeviceDispatch && axis->hasPendingStateChange())
+                        {
+                            activateDeviceEvents(joy);
+                        }
+
                         //axis->joyEvent(event.caxis.value);
                         axis->queuePendingEvent(event.caxis.value);
 
-                        if (!activeDevices.contains(event.caxis.which))
-                        {
-                            activeDevices.insert(event.caxis.which, joy);
-                        }
+                        markActiveDevice(activeDevices, joy);
+                        eventDevice = joy;
                     }
                 }
                 break;
@@ -1170,13 +1473,16 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (button)
                     {
+                        if (perDeviceDispatch && button->hasPendingEvent())
+                        {
+                            activateDeviceEvents(joy);
+                        }
+
                         //button->joyEvent(event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
                         button->queuePendingEvent(event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
 
-                        if (!activeDevices.contains(event.cbutton.which))
-                        {
-                            activeDevices.insert(event.cbutton.which, joy);
-                        }
+                        markActiveDevice(activeDevices, joy);
+                        eventDevice = joy;
                     }
                 }
 
@@ -1216,21 +1522,44 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                 break;
         }
 
-        // Active possible queued events.
-        QHashIterator<SDL_JoystickID, InputDevice*> activeDevIter(activeDevices);
-        while (activeDevIter.hasNext())
+        if (!perDeviceDispatch)
         {
-            InputDevice *tempDevice = activeDevIter.next().value();
-            tempDevice->activatePossibleControlStickEvents();
-            tempDevice->activatePossibleAxisEvents();
-            tempDevice->activatePossibleDPadEvents();
-            tempDevice->activatePossibleVDPadEvents();
-            tempDevice->activatePossibleButtonEvents();
+            // Active possible queued events.
+            for (int j=0; j < activeDevices.size(); j++)
+            {
+                activateDeviceEvents(activeDevices.at(j));
+            }
+
+            if (JoyButton::shouldInvokeMouseEvents())
+            {
+                // Do not wait for next event loop run. Execute immediately.
+                JoyButton::invokeMouseEvents();
+            }
+        }
+        else if (eventDevice && eventDevice != dispatchDevice)
+        {
+            // The run of events of the previous device ended. Activate it
+            // before the events of the next device are applied. A burst
+            // from one device costs a single activation pass of that
+            // device only.
+            if (dispatchDevice)
+            {
+                activateDeviceEvents(dispatchDevice);
+            }
+
+            dispatchDevice = eventDevice;
+        }
+    }
+
+    if (perDeviceDispatch)
+    {
+        if (dispatchDevice)
+        {
+            activateDeviceEvents(dispatchDevice);
         }
 
         if (JoyButton::shouldInvokeMouseEvents())
         {
-            // Do not wait for next event loop run. Execute immediately.
             JoyButton::invokeMouseEvents();
         }
     }
@@ -1265,6 +1594,23 @@ void InputDaemon::clearBitArrayStatusInstances()
     pendingEventValues.clear();
 }
 
+void InputDaemon::removeBitStatusEntries(InputDevice *device)
+{
+    InputDeviceBitArrayStatus *temp = releaseEventsGenerated.take(device);
+    if (temp)
+    {
+        delete temp;
+        temp = 0;
+    }
+
+    temp = pendingEventValues.take(device);
+    if (temp)
+    {
+        delete temp;
+        temp = 0;
+    }
+}
+
 void InputDaemon::resetActiveButtonMouseDistances()
 {
     pollResetTimer.stop();
@@ -21,12 +21,13 @@
 #include <QHash>
 #include <QMap>
 #include <QThread>
-#include <QQueue>
+#include <QVector>
 
 #ifdef USE_SDL_2
 #include <SDL2/SDL_joystick.h>
 #include <SDL2/SDL_events.h>
 #include "gamecontroller/gamecontroller.h"
+#include "controllermappingdatabase.h"
 
 #else
 #include <SDL/SDL_joystick.h>
@@ -54,15 +55,20 @@ protected:
             QHash<InputDevice*, InputDeviceBitArrayStatus*> *statusHash,
             InputDevice *device, bool readCurrent=true);
 
-    void firstInputPass(QQueue<SDL_Event> *sdlEventQueue);
-    void secondInputPass(QQueue<SDL_Event> *sdlEventQueue);
+    void processPendingEvents();
+    int firstInputPass();
+    void secondInputPass();
 #ifdef USE_SDL_2
-    void modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue);
-    QBitArray createUnplugEventBitArray(InputDevice *device);
+    void modifyUnplugEvents();
+    InputDeviceBitArrayStatus* createUnplugEventBitArray(InputDevice *device);
     Joystick* openJoystickDevice(int index);
+    QByteArray registerDeviceMapping(int index);
+    void rememberDeviceMapping(int index, const QByteArray &mapping);
+    bool isDeviceOutdated(int index, InputDevice *device);
 #endif
 
     void clearBitArrayStatusInstances();
+    void removeBitStatusEntries(InputDevice *device);
 
     QMap<SDL_JoystickID, InputDevice*> *joysticks;
 
@@ -70,13 +76,36 @@ protected:
     QHash<SDL_JoystickID, Joystick*> trackjoysticks;
     QHash<SDL_JoystickID, GameController*> trackcontrollers;
 
+    typedef struct _RegisteredMapping
+    {
+        QByteArray mapping;
+        bool fromDatabase;
+        QDateTime databaseModified;
+    } RegisteredMapping;
+
+    ControllerMappingDatabase *mappingDatabase;
+    // Mappings handed to SDL by device GUID. GUIDs without a mapping are
+    // not kept. Only used from the thread of the daemon.
+    QHash<QString, RegisteredMapping> registeredMappings;
+    // Mapping each open device was checked with when it was opened.
+    QHash<SDL_JoystickID, QByteArray> deviceMappings;
+
 #endif
 
     QHash<InputDevice*, InputDeviceBitArrayStatus*> releaseEventsGenerated;
     QHash<InputDevice*, InputDeviceBitArrayStatus*> pendingEventValues;
+    InputDeviceBitArrayStatus unplugEventValues;
+    unsigned int pollStamp;
+
+    // Preallocated buffer filled with SDL_PeepEvents on every poll.
+    QVector<SDL_Event> eventBuffer;
+    int eventCount;
 
     bool stopped;
     bool graphical;
+    // Activate the queued events of a device when its run of events in a
+    // batch ends instead of activating every device after each event.
+    bool perDeviceDispatch;
 
     SDLEventReader *eventWorker;
     QThread *sdlWorkerThread;
@@ -84,6 +113,7 @@ protected:
     QTimer pollResetTimer;
 
     static const int GAMECONTROLLERTRIGGERRELEASE;
+    static const int EVENTBUFFERSIZE;
 
 signals:
     void joystickRefreshed (InputDevice *joystick);
@@ -111,6 +141,7 @@ public slots:
     void removeDevice(InputDevice *device);
     void addInputDevice(int index);
     void refreshIndexes();
+    void refreshDevicesIncremental();
 
 #endif
 
@@ -17,8 +17,11 @@
 
 //#include <QDebug>
 #include <typeinfo>
+#include <QElapsedTimer>
+#include <QHashIterator>
 
 #include "inputdevice.h"
+#include "logger.h"
 
 const int InputDevice::NUMBER_JOYSETS = 8;
 const int InputDevice::DEFAULTKEYPRESSTIME = 100;
@@ -161,66 +164,237 @@ void InputDevice::reInitButtons()
     dpadstates.clear();
 }
 
+/**
+ * @brief Find the direction buttons of a stick that are active for a
+ *     stick direction. Diagonals in standard mode activate two buttons.
+ * @param Stick
+ * @param Current stick direction
+ * @param Array that will hold the active directions
+ * @return Number of active directions
+ */
+static int activeStickDirections(JoyControlStick *stick,
+                                 JoyControlStick::JoyStickDirections value,
+                                 JoyControlStick::JoyStickDirections directions[2])
+{
+    int count = 0;
+    if (value && stick->getJoyMode() == JoyControlStick::StandardMode)
+    {
+        count = 2;
+        switch (value)
+        {
+            case JoyControlStick::StickRightUp:
+            {
+                directions[0] = JoyControlStick::StickUp;
+                directions[1] = JoyControlStick::StickRight;
+                break;
+            }
+            case JoyControlStick::StickRightDown:
+            {
+                directions[0] = JoyControlStick::StickRight;
+                directions[1] = JoyControlStick::StickDown;
+                break;
+            }
+            case JoyControlStick::StickLeftDown:
+            {
+                directions[0] = JoyControlStick::StickDown;
+                directions[1] = JoyControlStick::StickLeft;
+                break;
+            }
+            case JoyControlStick::StickLeftUp:
+            {
+                directions[0] = JoyControlStick::StickLeft;
+                directions[1] = JoyControlStick::StickUp;
+                break;
+            }
+            default:
+            {
+                directions[0] = value;
+                count = 1;
+            }
+        }
+    }
+    else if (value)
+    {
+        directions[0] = value;
+        count = 1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Find the direction buttons of a dpad that are active for a
+ *     dpad direction. Diagonals in standard mode activate two buttons.
+ * @param DPad
+ * @param Current dpad direction
+ * @param Array that will hold the active directions
+ * @return Number of active directions
+ */
+static int activeDPadDirections(JoyDPad *dpad, int value, int directions[2])
+{
+    int count = 0;
+    if (value && dpad->getJoyMode() == JoyDPad::StandardMode)
+    {
+        count = 2;
+        switch (value)
+        {
+            case JoyDPadButton::DpadRightUp:
+            {
+                directions[0] = JoyDPadButton::DpadUp;
+                directions[1] = JoyDPadButton::DpadRight;
+                break;
+            }
+            case JoyDPadButton::DpadRightDown:
+            {
+                directions[0] = JoyDPadButton::DpadRight;
+                directions[1] = JoyDPadButton::DpadDown;
+                break;
+            }
+            case JoyDPadButton::DpadLeftDown:
+            {
+                directions[0] = JoyDPadButton::DpadDown;
+                directions[1] = JoyDPadButton::DpadLeft;
+                break;
+            }
+            case JoyDPadButton::DpadLeftUp:
+            {
+                directions[0] = JoyDPadButton::DpadLeft;
+                directions[1] = JoyDPadButton::DpadUp;
+                break;
+            }
+            default:
+            {
+                directions[0] = value;
+                count = 1;
+            }
+        }
+    }
+    else if (value)
+    {
+        directions[0] = value;
+        count = 1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Carry over the while held status of a button from the old set
+ *     so set changes are done in the proper order.
+ * @param Button in the new set
+ * @param Matching button in the old set
+ */
+static void carryWhileHeldStatus(JoyButton *button, JoyButton *oldButton)
+{
+    if (button && oldButton &&
+        button->getChangeSetCondition() == JoyButton::SetChangeWhileHeld &&
+        oldButton->getChangeSetCondition() == JoyButton::SetChangeWhileHeld &&
+        oldButton->getWhileHeldStatus())
+    {
+        // Button from old set involved in a while held set
+        // change. Carry over to new set button to ensure
+        // set changes are done in the proper order.
+        button->setWhileHeldStatus(true);
+    }
+}
+
+static void transferDPadWhileHeldStatus(JoyDPad *dpad, JoyDPad *oldDPad, int value)
+{
+    int directions[2];
+    int count = activeDPadDirections(dpad, value, directions);
+
+    QHashIterator<int, JoyDPadButton*> iter(*dpad->getJoyButtons());
+    while (iter.hasNext())
+    {
+        // Ensure that set change events are performed if needed.
+        iter.next();
+        bool active = (count > 0 && iter.key() == directions[0]) ||
+                      (count > 1 && iter.key() == directions[1]);
+        if (!active)
+        {
+            iter.value()->setWhileHeldStatus(false);
+        }
+    }
+
+    for (int j=0; j < count; j++)
+    {
+        carryWhileHeldStatus(dpad->getJoyButton(directions[j]),
+                             oldDPad->getJoyButton(directions[j]));
+    }
+}
+
 void InputDevice::setActiveSetNumber(int index)
 {
     if ((index >= 0 && index < NUMBER_JOYSETS) && (index != active_set))
     {
-        QList<bool> buttonstates;
-        QList<int> axesstates;
-        QList<int> dpadstates;
-        QList<JoyControlStick::JoyStickDirections> stickstates;
-        QList<int> vdpadstates;
+        QElapsedTimer switchTimer;
+        switchTimer.start();
 
-        // Grab current states for all elements in old set
+        // Grab current states for all elements in old set. Storage is
+        // kept between set changes so a set change does not allocate.
         SetJoystick *current_set = joystick_sets.value(active_set);
         SetJoystick *old_set = current_set;
         SetJoystick *tempSet = joystick_sets.value(index);
 
-        for (int i = 0; i < current_set->getNumberButtons(); i++)
+        int numButtons = current_set->getNumberButtons();
+        int numAxes = current_set->getNumberAxes();
+        int numHats = current_set->getNumberHats();
+        int numSticks = current_set->getNumberSticks();
+        int numVDPads = current_set->getNumberVDPads();
+
+        switchButtonStates.resize(numButtons);
+        switchAxesStates.resize(numAxes);
+        switchDPadStates.resize(numHats);
+        switchStickStates.resize(numSticks);
+        switchVDPadStates.resize(numVDPads);
+
+        for (int i = 0; i < numButtons; i++)
         {
             JoyButton *button = current_set->getJoyButton(i);
-            buttonstates.append(button->getButtonState());
-            tempSet->getJoyButton(i)->copyLastMouseDistanceFromDeadZone(button);
-            tempSet->getJoyButton(i)->copyLastAccelerationDistance(button);
-            tempSet->getJoyButton(i)->setUpdateInitAccel(false);
+            JoyButton *tempButton = tempSet->getJoyButton(i);
+            switchButtonStates[i] = button->getButtonState();
+            tempButton->copyLastMouseDistanceFromDeadZone(button);
+            tempButton->copyLastAccelerationDistance(button);
+            tempButton->setUpdateInitAccel(false);
         }
 
-        for (int i = 0; i < current_set->getNumberAxes(); i++)
+        for (int i = 0; i < numAxes; i++)
         {
             JoyAxis *axis = current_set->getJoyAxis(i);
-            axesstates.append(axis->getCurrentRawValue());
-            tempSet->getJoyAxis(i)->copyRawValues(axis);
-            tempSet->getJoyAxis(i)->copyThrottledValues(axis);
-            JoyAxisButton *button = tempSet->getJoyAxis(i)->getAxisButtonByValue(axis->getCurrentRawValue());
+            JoyAxis *tempAxis = tempSet->getJoyAxis(i);
+            switchAxesStates[i] = axis->getCurrentRawValue();
+            tempAxis->copyRawValues(axis);
+            tempAxis->copyThrottledValues(axis);
+            JoyAxisButton *button = tempAxis->getAxisButtonByValue(axis->getCurrentRawValue());
             if (button)
             {
                 button->setUpdateInitAccel(false);
             }
         }
 
-        for (int i = 0; i < current_set->getNumberHats(); i++)
+        for (int i = 0; i < numHats; i++)
         {
             JoyDPad *dpad = current_set->getJoyDPad(i);
-            dpadstates.append(dpad->getCurrentDirection());
+            switchDPadStates[i] = dpad->getCurrentDirection();
             JoyDPadButton::JoyDPadDirections tempDir =
                     static_cast<JoyDPadButton::JoyDPadDirections>(dpad->getCurrentDirection());
             tempSet->getJoyDPad(i)->setDirButtonsUpdateInitAccel(tempDir, false);
             tempSet->getJoyDPad(i)->copyLastDistanceValues(dpad);
         }
 
-        for (int i=0; i < current_set->getNumberSticks(); i++)
+        for (int i=0; i < numSticks; i++)
         {
             // Last distances for elements are taken from associated axes.
             // Copying is not required here.
             JoyControlStick *stick = current_set->getJoyStick(i);
-            stickstates.append(stick->getCurrentDirection());
+            switchStickStates[i] = stick->getCurrentDirection();
             tempSet->getJoyStick(i)->setDirButtonsUpdateInitAccel(stick->getCurrentDirection(), false);
         }
 
-        for (int i = 0; i < current_set->getNumberVDPads(); i++)
+        for (int i = 0; i < numVDPads; i++)
         {
             JoyDPad *dpad = current_set->getVDPad(i);
-            vdpadstates.append(dpad->getCurrentDirection());
+            switchVDPadStates[i] = dpad->getCurrentDirection();
             JoyDPadButton::JoyDPadDirections tempDir =
                     static_cast<JoyDPadButton::JoyDPadDirections>(dpad->getCurrentDirection());
             tempSet->getVDPad(i)->setDirButtonsUpdateInitAccel(tempDir, false);
@@ -234,386 +408,89 @@ void InputDevice::setActiveSetNumber(int index)
         // Activate all buttons in the switched set
         current_set = joystick_sets.value(active_set);
 
-        for (int i=0; i < current_set->getNumberSticks(); i++)
+        for (int i=0; i < numSticks; i++)
         {
-            JoyControlStick::JoyStickDirections value = stickstates.at(i);
-            //bool tempignore = true;
-            bool tempignore = false;
-            QList<JoyControlStickButton*> buttonList;
-            QList<JoyControlStickButton*> oldButtonList;
             JoyControlStick *stick = current_set->getJoyStick(i);
             JoyControlStick *oldStick = old_set->getJoyStick(i);
-
-            if (stick->getJoyMode() == JoyControlStick::StandardMode && value)
-            {
-                switch (value)
-                {
-                    case JoyControlStick::StickRightUp:
-                    {
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickUp));
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickRight));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickUp));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickRight));
-                        break;
-                    }
-                    case JoyControlStick::StickRightDown:
-                    {
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickRight));
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickDown));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickRight));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickDown));
-                        break;
-                    }
-                    case JoyControlStick::StickLeftDown:
-                    {
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickDown));
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickLeft));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickDown));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickLeft));
-                        break;
-                    }
-                    case JoyControlStick::StickLeftUp:
-                    {
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickLeft));
-                        buttonList.append(stick->getDirectionButton(JoyControlStick::StickUp));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickLeft));
-                        oldButtonList.append(oldStick->getDirectionButton(JoyControlStick::StickUp));
-                        break;
-                    }
-                    default:
-                    {
-                        buttonList.append(stick->getDirectionButton(value));
-                        oldButtonList.append(oldStick->getDirectionButton(value));
-                    }
-                }
-            }
-            else if (value)
-            {
-                buttonList.append(stick->getDirectionButton(value));
-                oldButtonList.append(oldStick->getDirectionButton(value));
-            }
+            JoyControlStick::JoyStickDirections directions[2];
+            int count = activeStickDirections(stick, switchStickStates.at(i), directions);
 
             QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton*> iter(*stick->getButtons());
             while (iter.hasNext())
             {
-                JoyControlStickButton *tempButton = iter.next().value();
-                if (!buttonList.contains(tempButton))
+                iter.next();
+                bool active = (count > 0 && iter.key() == directions[0]) ||
+                              (count > 1 && iter.key() == directions[1]);
+                if (!active)
                 {
-                    tempButton->setWhileHeldStatus(false);
+                    iter.value()->setWhileHeldStatus(false);
                 }
             }
 
-            for (int j=0; j < buttonList.size(); j++)
+            for (int j=0; j < count; j++)
             {
-                JoyControlStickButton *button = buttonList.at(j);
-                JoyControlStickButton *oldButton = oldButtonList.at(j);
-
-                if (button && oldButton)
-                {
-                    if (button->getChangeSetCondition() == JoyButton::SetChangeWhileHeld)
-                    {
-                        if (oldButton->getChangeSetCondition() == JoyButton::SetChangeWhileHeld && oldButton->getWhileHeldStatus())
-                        {
-                            // Button from old set involved in a while held set
-                            // change. Carry over to new set button to ensure
-                            // set changes are done in the proper order.
-                            button->setWhileHeldStatus(true);
-                        }
-                        else if (!button->getWhileHeldStatus())
-                        {
-                            // Ensure that set change events are performed if needed.
-                            tempignore = false;
-                        }
-                    }
-                }
+                carryWhileHeldStatus(stick->getDirectionButton(directions[j]),
+                                     oldStick->getDirectionButton(directions[j]));
             }
         }
 
         // Activate all dpad buttons in the switched set
-        for (int i = 0; i < current_set->getNumberVDPads(); i++)
+        for (int i = 0; i < numVDPads; i++)
         {
-            int value = vdpadstates.at(i);
-            //bool tempignore = true;
-            bool tempignore = false;
-            JoyDPad *dpad = current_set->getVDPad(i);
-            QList<JoyDPadButton*> buttonList;
-            QList<JoyDPadButton*> oldButtonList;
-
-            if (dpad->getJoyMode() == JoyDPad::StandardMode && value)
-            {
-                switch (value)
-                {
-                    case JoyDPadButton::DpadRightUp:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadUp));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadRight));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadUp));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadRight));
-                        break;
-                    }
-
-                    case JoyDPadButton::DpadRightDown:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadRight));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadDown));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadRight));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadDown));
-                        break;
-                    }
-                    case JoyDPadButton::DpadLeftDown:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadDown));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadLeft));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadDown));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadLeft));
-                        break;
-                    }
-                    case JoyDPadButton::DpadLeftUp:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadLeft));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadUp));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadLeft));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(JoyDPadButton::DpadUp));
-                        break;
-                    }
-                    default:
-                    {
-                        buttonList.append(dpad->getJoyButton(value));
-                        oldButtonList.append(old_set->getVDPad(i)->getJoyButton(value));
-                    }
-                }
-            }
-            else if (value)
-            {
-                buttonList.append(dpad->getJoyButton(value));
-                oldButtonList.append(old_set->getVDPad(i)->getJoyButton(value));
-            }
-
-            QHashIterator<int, JoyDPadButton*> iter(*dpad->getJoyButtons());
-            while (iter.hasNext())
-            {
-                // Ensure that set change events are performed if needed.
-                JoyDPadButton *button = iter.next().value();
-                if (!buttonList.contains(button))
-                {
-                    button->setWhileHeldStatus(false);
-                }
-            }
-
-            for (int j=0; j < buttonList.size(); j++)
-            {
-                JoyDPadButton *button = buttonList.at(j);
-                JoyDPadButton *oldButton = oldButtonList.at(j);
-
-                if (button && oldButton)
-                {
-                    if (button->getChangeSetCondition() == JoyButton::SetChangeWhileHeld)
-                    {
-                        if (value)
-                        {
-                            if (oldButton->getChangeSetCondition() == JoyButton::SetChangeWhileHeld && oldButton->getWhileHeldStatus())
-                            {
-                                // Button from old set involved in a while held set
-                                // change. Carry over to new set button to ensure
-                                // set changes are done in the proper order.
-                                button->setWhileHeldStatus(true);
-                            }
-                            else if (!button->getWhileHeldStatus())
-                            {
-                                // Ensure that set change events are performed if needed.
-                                tempignore = false;
-                            }
-                        }
-                        else
-                        {
-                            button->setWhileHeldStatus(false);
-                        }
-                    }
-                }
-            }
+            transferDPadWhileHeldStatus(current_set->getVDPad(i), old_set->getVDPad(i),
+                                        switchVDPadStates.at(i));
         }
 
-        for (int i = 0; i < current_set->getNumberButtons(); i++)
+        for (int i = 0; i < numButtons; i++)
         {
-            bool value = buttonstates.at(i);
-            //bool tempignore = true;
-            bool tempignore = false;
+            bool value = switchButtonStates.at(i);
             JoyButton *button = current_set->getJoyButton(i);
             JoyButton *oldButton = old_set->getJoyButton(i);
             if (button->getChangeSetCondition() == JoyButton::SetChangeWhileHeld)
             {
                 if (value)
                 {
-                    if (oldButton->getChangeSetCondition() == JoyButton::SetChangeWhileHeld && oldButton->getWhileHeldStatus())
-                    {
-                        // Button from old set involved in a while held set
-                        // change. Carry over to new set button to ensure
-                        // set changes are done in the proper order.
-                        button->setWhileHeldStatus(true);
-                    }
-                    else if (!button->getWhileHeldStatus())
-                    {
-                        // Ensure that set change events are performed if needed.
-                        tempignore = false;
-                    }
+                    carryWhileHeldStatus(button, oldButton);
                 }
                 else
                 {
                     // Ensure that set change events are performed if needed.
                     button->setWhileHeldStatus(false);
-                    //tempignore = false;
                 }
             }
 
-            //button->joyEvent(value, tempignore);
-            button->queuePendingEvent(value, tempignore);
+            button->queuePendingEvent(value, false);
         }
 
         // Activate all axis buttons in the switched set
-        for (int i = 0; i < current_set->getNumberAxes(); i++)
+        for (int i = 0; i < numAxes; i++)
         {
-            int value = axesstates.at(i);
-            //bool tempignore = true;
-            bool tempignore = false;
+            int value = switchAxesStates.at(i);
             JoyAxis *axis = current_set->getJoyAxis(i);
             JoyAxisButton *oldButton = old_set->getJoyAxis(i)->getAxisButtonByValue(value);
             JoyAxisButton *button = axis->getAxisButtonByValue(value);
 
-            if (button && oldButton)
+            if (button)
             {
-                if (button->getChangeSetCondition() == JoyButton::SetChangeWhileHeld)
-                {
-                    if (oldButton->getChangeSetCondition() == JoyButton::SetChangeWhileHeld && oldButton->getWhileHeldStatus())
-                    {
-                        // Button from old set involved in a while held set
-                        // change. Carry over to new set button to ensure
-                        // set changes are done in the proper order.
-                        button->setWhileHeldStatus(true);
-                    }
-                    else if (!button->getWhileHeldStatus())
-                    {
-                        // Ensure that set change events are performed if needed.
-                        tempignore = false;
-                    }
-                }
+                carryWhileHeldStatus(button, oldButton);
             }
-            else if (!button)
+            else
             {
                 // Ensure that set change events are performed if needed.
                 axis->getPAxisButton()->setWhileHeldStatus(false);
                 axis->getNAxisButton()->setWhileHeldStatus(false);
             }
 
-            //axis->joyEvent(value, tempignore);
-            axis->queuePendingEvent(value, tempignore, false);
+            axis->queuePendingEvent(value, false, false);
         }
 
         // Activate all dpad buttons in the switched set
-        for (int i = 0; i < current_set->getNumberHats(); i++)
+        for (int i = 0; i < numHats; i++)
         {
-            int value = dpadstates.at(i);
-            //bool tempignore = true;
-            bool tempignore = false;
+            int value = switchDPadStates.at(i);
             JoyDPad *dpad = current_set->getJoyDPad(i);
-            QList<JoyDPadButton*> buttonList;
-            QList<JoyDPadButton*> oldButtonList;
-
-            if (dpad->getJoyMode() == JoyDPad::StandardMode && value)
-            {
-                switch (value)
-                {
-                    case JoyDPadButton::DpadRightUp:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadUp));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadRight));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadUp));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadRight));
-                        break;
-                    }
-
-                    case JoyDPadButton::DpadRightDown:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadRight));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadDown));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadRight));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadDown));
-                        break;
-                    }
-                    case JoyDPadButton::DpadLeftDown:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadDown));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadLeft));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadDown));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadLeft));
-                        break;
-                    }
-                    case JoyDPadButton::DpadLeftUp:
-                    {
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadLeft));
-                        buttonList.append(dpad->getJoyButton(JoyDPadButton::DpadUp));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadLeft));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(JoyDPadButton::DpadUp));
-                        break;
-                    }
-                    default:
-                    {
-                        buttonList.append(dpad->getJoyButton(value));
-                        oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(value));
-                    }
-                }
-            }
-            else if (value)
-            {
-                buttonList.append(dpad->getJoyButton(value));
-                oldButtonList.append(old_set->getJoyDPad(i)->getJoyButton(value));
-            }
-
-            QHashIterator<int, JoyDPadButton*> iter(*dpad->getJoyButtons());
-            while (iter.hasNext())
-            {
-                // Ensure that set change events are performed if needed.
-                JoyDPadButton *button = iter.next().value();
-                if (!buttonList.contains(button))
-                {
-                    button->setWhileHeldStatus(false);
-                }
-            }
-
-            for (int j=0; j < buttonList.size(); j++)
-            {
-                JoyDPadButton *button = buttonList.at(j);
-                JoyDPadButton *oldButton = oldButtonList.at(j);
-
-                if (button && oldButton)
-                {
-                    if (button->getChangeSetCondition() == JoyButton::SetChangeWhileHeld)
-                    {
-                        if (value)
-                        {
-                            if (oldButton->getChangeSetCondition() == JoyButton::SetChangeWhileHeld && oldButton->getWhileHeldStatus())
-                            {
-                                // Button from old set involved in a while held set
-                                // change. Carry over to new set button to ensure
-                                // set changes are done in the proper order.
-                                button->setWhileHeldStatus(true);
-                            }
-                            else if (!button->getWhileHeldStatus())
-                            {
-                                // Ensure that set change events are performed if needed.
-                                tempignore = false;
-                            }
-                        }
-                        else
-                        {
-                            button->setWhileHeldStatus(false);
-                        }
-
-                    }
-                }
-            }
-
-            //dpad->joyEvent(value, tempignore);
-            dpad->queuePendingEvent(value, tempignore);
+            transferDPadWhileHeldStatus(dpad, old_set->getJoyDPad(i), value);
+            dpad->queuePendingEvent(value, false);
         }
 
         activatePossibleControlStickEvents();
@@ -621,12 +498,13 @@ void InputDevice::setActiveSetNumber(int index)
         activatePossibleDPadEvents();
         activatePossibleVDPadEvents();
         activatePossibleButtonEvents();
-        /*if (JoyButton::shouldInvokeMouseEvents())
+
+        if (Logger::getInstance()->getCurrentLogLevel() >= Logger::LOG_DEBUG)
         {
-            // Run mouse events early if needed.
-            JoyButton::invokeMouseEvents();
+            Logger::LogDebug(QString("Set change to %1 took %2 us")
+                             .arg(active_set + 1)
+                             .arg(switchTimer.nsecsElapsed() / 1000));
         }
-        */
     }
 }
 
@@ -2015,17 +1893,14 @@ bool InputDevice::isKnownController()
     }
     else
     {
-        settings->beginGroup("Mappings");
-        if (settings->contains(getGUIDString()))
+        if (settings->cachedContains(QString("Mappings/%1").arg(getGUIDString())))
         {
             result = true;
         }
-        else if (settings->contains(QString("%1%2").arg(getGUIDString()).arg("Disabled")))
+        else if (settings->cachedContains(QString("Mappings/%1%2").arg(getGUIDString()).arg("Disabled")))
         {
             result = true;
         }
-
-        settings->endGroup();
     }
 
     return result;
@@ -20,6 +20,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QVector>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QRegExp>
@@ -158,6 +159,14 @@ protected:
     QList<int> axesstates;
     QList<int> dpadstates;
 
+    // Element states captured at the start of a set change. Kept between
+    // set changes so switching sets does not allocate.
+    QVector<bool> switchButtonStates;
+    QVector<int> switchAxesStates;
+    QVector<int> switchDPadStates;
+    QVector<JoyControlStick::JoyStickDirections> switchStickStates;
+    QVector<int> switchVDPadStates;
+
     int rawAxisDeadZone;
 
     static QRegExp emptyGUID;
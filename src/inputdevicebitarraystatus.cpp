@@ -17,116 +17,154 @@
 
 #include "inputdevicebitarraystatus.h"
 
-InputDeviceBitArrayStatus::InputDeviceBitArrayStatus(InputDevice *device, bool readCurrent, QObject *parent) :
+InputDeviceBitArrayStatus::InputDeviceBitArrayStatus(QObject *parent) :
     QObject(parent)
 {
-    for (int i=0; i < device->getNumberRawAxes(); i++)
-    {
-        SetJoystick *currentSet = device->getActiveSetJoystick();
-        JoyAxis *axis = currentSet->getJoyAxis(i);
+    numAxes = 0;
+    numHats = 0;
+    numButtons = 0;
+    pollStamp = 0;
+}
 
-        if (axis && readCurrent)
-        {
-            axesStatus.append(!axis->inDeadZone(axis->getCurrentRawValue()) ? true : false);
-        }
-        else
-        {
-            axesStatus.append(false);
-        }
+/**
+ * @brief Size the status for a device and fill it. Storage is only
+ *     resized when the number of elements changes.
+ * @param Device to read
+ * @param Whether to read the current state of the active set. All flags
+ *     are cleared otherwise.
+ */
+void InputDeviceBitArrayStatus::reset(InputDevice *device, bool readCurrent)
+{
+    numAxes = device->getNumberRawAxes();
+    numHats = device->getNumberRawHats();
+    numButtons = device->getNumberRawButtons();
+
+    int wordCount = (numAxes + numHats + numButtons + 31) / 32;
+    if (statusWords.size() != wordCount)
+    {
+        statusWords.resize(wordCount);
     }
 
-    for (int i=0; i < device->getNumberRawHats(); i++)
+    clearStatusValues();
+
+    if (readCurrent)
     {
         SetJoystick *currentSet = device->getActiveSetJoystick();
-        JoyDPad *dpad = currentSet->getJoyDPad(i);
-        if (dpad && readCurrent)
+        for (int i=0; i < numAxes; i++)
         {
-            hatButtonStatus.append(dpad->getCurrentDirection() != JoyDPadButton::DpadCentered ? true : false);
+            JoyAxis *axis = currentSet->getJoyAxis(i);
+            if (axis && !axis->inDeadZone(axis->getCurrentRawValue()))
+            {
+                setStatusBit(i, true);
+            }
         }
-        else
+
+        for (int i=0; i < numHats; i++)
         {
-            hatButtonStatus.append(false);
+            JoyDPad *dpad = currentSet->getJoyDPad(i);
+            if (dpad && dpad->getCurrentDirection() != JoyDPadButton::DpadCentered)
+            {
+                setStatusBit(numAxes + i, true);
+            }
         }
-    }
 
-    buttonStatus.resize(device->getNumberRawButtons());
-    buttonStatus.fill(0);
-
-    for (int i=0; i < device->getNumberRawButtons(); i++)
-    {
-        SetJoystick *currentSet = device->getActiveSetJoystick();
-        JoyButton *button = currentSet->getJoyButton(i);
-        if (button && readCurrent)
+        for (int i=0; i < numButtons; i++)
         {
-            buttonStatus.setBit(i, button->getButtonState());
+            JoyButton *button = currentSet->getJoyButton(i);
+            if (button && button->getButtonState())
+            {
+                setStatusBit(numAxes + numHats + i, true);
+            }
         }
     }
 }
 
+void InputDeviceBitArrayStatus::setStatusBit(int bit, bool value)
+{
+    quint32 mask = 1U << (bit % 32);
+    if (value)
+    {
+        statusWords[bit / 32] |= mask;
+    }
+    else
+    {
+        statusWords[bit / 32] &= ~mask;
+    }
+}
+
 void InputDeviceBitArrayStatus::changeAxesStatus(int axisIndex, bool value)
 {
-    if (axisIndex >= 0 && axisIndex <= axesStatus.size())
+    if (axisIndex >= 0 && axisIndex < numAxes)
     {
-        axesStatus.replace(axisIndex, value);
+        setStatusBit(axisIndex, value);
     }
 }
 
 void InputDeviceBitArrayStatus::changeButtonStatus(int buttonIndex, bool value)
 {
-    if (buttonIndex >= 0 && buttonIndex <= buttonStatus.size())
+    if (buttonIndex >= 0 && buttonIndex < numButtons)
     {
-        buttonStatus.setBit(buttonIndex, value);
+        setStatusBit(numAxes + numHats + buttonIndex, value);
     }
 }
 
 void InputDeviceBitArrayStatus::changeHatStatus(int hatIndex, bool value)
 {
-    if (hatIndex >= 0 && hatIndex <= hatButtonStatus.size())
+    if (hatIndex >= 0 && hatIndex < numHats)
     {
-        hatButtonStatus.replace(hatIndex, value);
+        setStatusBit(numAxes + hatIndex, value);
     }
 }
 
-QBitArray InputDeviceBitArrayStatus::generateFinalBitArray()
+int InputDeviceBitArrayStatus::size()
 {
-    unsigned int totalArraySize = 0;
-    totalArraySize = axesStatus.size() + hatButtonStatus.size() + buttonStatus.size();
-
-    QBitArray aggregateBitArray(totalArraySize, false);
-    unsigned int currentBit = 0;
+    return numAxes + numHats + numButtons;
+}
 
-    for (int i=0; i < axesStatus.size(); i++)
+int InputDeviceBitArrayStatus::countActive()
+{
+    int result = 0;
+    for (int i=0; i < statusWords.size(); i++)
     {
-        aggregateBitArray.setBit(currentBit, axesStatus.at(i));
-        currentBit++;
+        quint32 word = statusWords.at(i);
+        while (word != 0)
+        {
+            word &= word - 1;
+            result++;
+        }
     }
 
-    for (int i=0; i < hatButtonStatus.size(); i++)
-    {
-        aggregateBitArray.setBit(currentBit, hatButtonStatus.at(i));
-        currentBit++;
-    }
+    return result;
+}
 
-    for (int i=0; i < buttonStatus.size(); i++)
+/**
+ * @brief Compare with another status word by word.
+ * @return Whether both statuses have the same layout and flags
+ */
+bool InputDeviceBitArrayStatus::hasSameStatus(InputDeviceBitArrayStatus *other)
+{
+    bool result = numAxes == other->numAxes && numHats == other->numHats &&
+            numButtons == other->numButtons;
+
+    for (int i=0; i < statusWords.size() && result; i++)
     {
-        aggregateBitArray.setBit(currentBit, buttonStatus.at(i));
-        currentBit++;
+        result = statusWords.at(i) == other->statusWords.at(i);
     }
 
-    return aggregateBitArray;
+    return result;
 }
 
 void InputDeviceBitArrayStatus::clearStatusValues()
 {
-    for (int i=0; i < axesStatus.size(); i++)
-    {
-        axesStatus.replace(i, false);
-    }
+    statusWords.fill(0);
+}
 
-    for (int i=0; i < hatButtonStatus.size(); i++)
-    {
-        hatButtonStatus.replace(i, false);
-    }
+unsigned int InputDeviceBitArrayStatus::getPollStamp()
+{
+    return pollStamp;
+}
 
-    buttonStatus.fill(false);
+void InputDeviceBitArrayStatus::setPollStamp(unsigned int stamp)
+{
+    pollStamp = stamp;
 }
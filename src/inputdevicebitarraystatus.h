@@ -19,28 +19,44 @@
 #define INPUTDEVICESTATUSEVENT_H
 
 #include <QObject>
-#include <QList>
-#include <QBitArray>
+#include <QVector>
 
 #include "inputdevice.h"
 
+/**
+ * @brief Activity flags for every axis, hat and button of a device packed
+ *     into 32 bit words. Instances are kept per device and reused for every
+ *     poll so no memory is allocated once the storage has been sized.
+ */
 class InputDeviceBitArrayStatus : public QObject
 {
     Q_OBJECT
 public:
-    explicit InputDeviceBitArrayStatus(InputDevice *device, bool readCurrent = true, QObject *parent = 0);
+    explicit InputDeviceBitArrayStatus(QObject *parent = 0);
+
+    void reset(InputDevice *device, bool readCurrent = true);
 
     void changeAxesStatus(int axisIndex, bool value);
     void changeButtonStatus(int buttonIndex, bool value);
     void changeHatStatus(int hatIndex, bool value);
 
-    QBitArray generateFinalBitArray();
+    int size();
+    int countActive();
+    bool hasSameStatus(InputDeviceBitArrayStatus *other);
     void clearStatusValues();
 
+    unsigned int getPollStamp();
+    void setPollStamp(unsigned int stamp);
+
 protected:
-    QList<bool> axesStatus;
-    QList<bool> hatButtonStatus;
-    QBitArray buttonStatus;
+    void setStatusBit(int bit, bool value);
+
+    // Layout is axes, then hats, then buttons.
+    QVector<quint32> statusWords;
+    int numAxes;
+    int numHats;
+    int numButtons;
+    unsigned int pollStamp;
 
 signals:
 
@@ -0,0 +1,73 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inputstatesampler.h"
+
+// Roughly 60 Hz.
+const int InputStateSampler::SAMPLEINTERVAL = 16;
+
+QTimer* InputStateSampler::timer = 0;
+int InputStateSampler::subscriberCount = 0;
+
+QTimer* InputStateSampler::sampleTimer()
+{
+    if (!timer)
+    {
+        timer = new QTimer();
+        timer->setInterval(SAMPLEINTERVAL);
+    }
+
+    return timer;
+}
+
+/**
+ * @brief Have a slot called every time the GUI should sample input state.
+ *     Must be called from the GUI thread.
+ * @param Object that will be sampling input state
+ * @param Slot called on every tick. Use the SLOT macro.
+ */
+void InputStateSampler::subscribe(QObject *receiver, const char *member)
+{
+    QTimer *temp = sampleTimer();
+    QObject::connect(temp, SIGNAL(timeout()), receiver, member);
+
+    subscriberCount++;
+    if (!temp->isActive())
+    {
+        temp->start();
+    }
+}
+
+/**
+ * @brief Stop sampling for an object. The timer is stopped once no
+ *     subscribers remain. Has to be called once for every subscribe call.
+ * @param Object that was sampling input state
+ */
+void InputStateSampler::unsubscribe(QObject *receiver)
+{
+    if (timer)
+    {
+        QObject::disconnect(timer, SIGNAL(timeout()), receiver, 0);
+
+        subscriberCount--;
+        if (subscriberCount <= 0)
+        {
+            subscriberCount = 0;
+            timer->stop();
+        }
+    }
+}
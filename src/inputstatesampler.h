@@ -0,0 +1,48 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUTSTATESAMPLER_H
+#define INPUTSTATESAMPLER_H
+
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @brief Shared GUI thread timer used by widgets that display the live
+ *     state of a controller. Widgets sample the values published by the
+ *     input thread at a fixed rate instead of reacting to every input
+ *     event. The timer only runs while at least one widget is subscribed.
+ */
+class InputStateSampler
+{
+public:
+    static void subscribe(QObject *receiver, const char *member);
+    static void unsubscribe(QObject *receiver);
+
+    static const int SAMPLEINTERVAL;
+
+protected:
+    static QTimer* sampleTimer();
+
+    static QTimer *timer;
+    static int subscriberCount;
+
+private:
+    InputStateSampler();
+};
+
+#endif // INPUTSTATESAMPLER_H
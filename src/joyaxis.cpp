@@ -95,6 +95,36 @@ bool JoyAxis::hasPendingEvent()
     return pendingEvent;
 }
 
+/**
+ * @brief Check if the queued event would activate or release the axis or
+ *     switch its direction. Such an event must not be replaced by a
+ *     later value before it is activated.
+ * @return Whether the queued event changes the state of the axis
+ */
+bool JoyAxis::hasPendingStateChange()
+{
+    bool result = false;
+    if (this->stick)
+    {
+        result = stick->hasPendingStateChange();
+    }
+    else if (pendingEvent)
+    {
+        bool pendingActive = !inDeadZone(pendingValue);
+        if (pendingActive != isActive)
+        {
+            result = true;
+        }
+        else if (pendingActive &&
+                 (calculateThrottledValue(pendingValue) >= 0) != (currentThrottledValue >= 0))
+        {
+            result = true;
+        }
+    }
+
+    return result;
+}
+
 void JoyAxis::clearPendingEvent()
 {
     pendingEvent = false;
@@ -136,8 +166,6 @@ void JoyAxis::stickPassEvent(int value, bool ignoresets, bool updateLastValues)
         {
             stick->joyEvent(ignoresets);
         }
-
-        emit moved(currentRawValue);
     }
 }
 
@@ -189,8 +217,6 @@ void JoyAxis::joyEvent(int value, bool ignoresets, bool updateLastValues)
             createDeskEvent(ignoresets);
         }
     }
-
-    emit moved(currentRawValue);
 }
 
 bool JoyAxis::inDeadZone(int value)
@@ -632,6 +658,20 @@ int JoyAxis::getCurrentRawValue()
     return currentRawValue;
 }
 
+/**
+ * @brief Get the last raw value published by the input thread. Safe to
+ *     call from the GUI thread without holding the input daemon mutex.
+ * @return Raw axis value
+ */
+int JoyAxis::getPublishedRawValue()
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    return publishedRawValue.loadAcquire();
+#else
+    return publishedRawValue;
+#endif
+}
+
 void JoyAxis::adjustRange()
 {
     if (throttle == JoyAxis::NegativeThrottle)
@@ -797,6 +837,8 @@ void JoyAxis::setCurrentRawValue(int value)
     {
         currentRawValue = JoyAxis::AXISMIN;
     }
+
+    publishedRawValue.fetchAndStoreRelease(currentRawValue);
 }
 
 void JoyAxis::setButtonsMouseMode(JoyButton::JoyMouseMovementMode mode)
@@ -1157,7 +1199,7 @@ JoyButton::JoyExtraAccelerationCurve JoyAxis::getExtraAccelerationCurve()
 void JoyAxis::copyRawValues(JoyAxis *srcAxis)
 {
     this->lastKnownRawValue = srcAxis->lastKnownRawValue;
-    this->currentRawValue = srcAxis->currentRawValue;
+    setCurrentRawValue(srcAxis->currentRawValue);
 }
 
 void JoyAxis::copyThrottledValues(JoyAxis *srcAxis)
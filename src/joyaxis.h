@@ -19,6 +19,7 @@
 #define JOYAXIS_H
 
 #include <QObject>
+#include <QAtomicInt>
 #include <QTimer>
 #include <QTime>
 #include <QList>
@@ -49,6 +50,7 @@ public:
     void activatePendingEvent();
     bool hasPendingEvent();
     void clearPendingEvent();
+    bool hasPendingStateChange();
 
     bool inDeadZone(int value);
 
@@ -71,6 +73,7 @@ public:
     int getThrottle();
     int getCurrentThrottledValue();
     int getCurrentRawValue();
+    int getPublishedRawValue();
     //int getCurrentThrottledMin();
     //int getCurrentThrottledMax();
     int getCurrentThrottledDeadValue();
@@ -174,6 +177,8 @@ protected:
     bool eventActive;
     int currentThrottledValue;
     int currentRawValue;
+    // Copy of currentRawValue that can be sampled from the GUI thread.
+    QAtomicInt publishedRawValue;
     int throttle;
     JoyAxisButton *activeButton;
     int originset;
@@ -195,7 +200,6 @@ protected:
 signals:
     void active(int value);
     void released(int value);
-    void moved(int value);
     void throttleChangePropogated(int index);
     void throttleChanged();
     void axisNameChanged();
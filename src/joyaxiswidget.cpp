@@ -57,15 +57,13 @@ JoyAxis* JoyAxisWidget::getAxis()
 
 void JoyAxisWidget::disableFlashes()
 {
-    disconnect(axis, SIGNAL(active(int)), this, SLOT(flash()));
-    disconnect(axis, SIGNAL(released(int)), this, SLOT(unflash()));
+    flashesEnabled = false;
     this->unflash();
 }
 
 void JoyAxisWidget::enableFlashes()
 {
-    connect(axis, SIGNAL(active(int)), this, SLOT(flash()), Qt::QueuedConnection);
-    connect(axis, SIGNAL(released(int)), this, SLOT(unflash()), Qt::QueuedConnection);
+    flashesEnabled = true;
 }
 
 /**
@@ -89,11 +87,20 @@ void JoyAxisWidget::showContextMenu(const QPoint &point)
 
 void JoyAxisWidget::tryFlash()
 {
-    JoyAxisButton *nAxisButton = axis->getNAxisButton();
-    JoyAxisButton *pAxisButton = axis->getPAxisButton();
-
-    if (nAxisButton->getButtonState() || pAxisButton->getButtonState())
+    if (isInputActive())
     {
         flash();
     }
 }
+
+int JoyAxisWidget::getActiveZoneVersion()
+{
+    return axis->getNAxisButton()->getActiveZoneVersion() +
+           axis->getPAxisButton()->getActiveZoneVersion();
+}
+
+bool JoyAxisWidget::isInputActive()
+{
+    return axis->getNAxisButton()->getButtonState() ||
+           axis->getPAxisButton()->getButtonState();
+}
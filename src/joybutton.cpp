@@ -26,12 +26,15 @@
 #include "vdpad.h"
 #include "event.h"
 #include "logger.h"
+#include "joymousemotion.h"
+#include "eventhandlers/baseeventhandler.h"
 
 #ifdef Q_OS_WIN
   #include "eventhandlerfactory.h"
 #endif
 
 const QString JoyButton::xmlName = "button";
+const int JoyButton::MAXACTIVEZONESLOTS;
 
 // Set default values for many properties.
 const int JoyButton::ENABLEDTURBODEFAULT = 100;
@@ -79,10 +82,12 @@ const JoyButton::JoyExtraAccelerationCurve
 JoyButton::DEFAULTEXTRAACCELCURVE = JoyButton::LinearAccelCurve;
 
 const int JoyButton::DEFAULTSPRINGRELEASERADIUS = 0;
+// Distance past a zone boundary required before switching zones.
+const double JoyButton::DISTANCEZONEHYSTERESIS = 0.01;
 
 // Keep references to active keys and mouse buttons.
-QHash<unsigned int, int> JoyButton::activeKeys;
-QHash<unsigned int, int> JoyButton::activeMouseButtons;
+ActiveKeyTable JoyButton::activeKeys(ActiveKeyTable::DEFAULTKEYTABLESIZE);
+ActiveKeyTable JoyButton::activeMouseButtons(ActiveKeyTable::DEFAULTMOUSETABLESIZE);
 JoyButtonSlot* JoyButton::lastActiveKey = 0;
 
 // Keep track of active Mouse Speed Mod slots.
@@ -98,8 +103,10 @@ QList<PadderCommon::springModeInfo> JoyButton::springYSpeeds;
 
 // Keeps timestamp of last mouse event.
 //QElapsedTimer JoyButton::lastMouseTime;
-// Temporary test object to test old mouse time behavior.
-QTime JoyButton::testOldMouseTime;
+// Monotonic clock used to integrate mouse movement between ticks.
+QElapsedTimer JoyButton::mouseClock;
+qint64 JoyButton::lastMouseTickTime = 0;
+qint64 JoyButton::mouseTickTime = -1;
 
 // Helper object to have a single mouse event for all JoyButton
 // instances.
@@ -108,6 +115,10 @@ JoyButtonMouseHelper JoyButton::mouseHelper;
 QTimer JoyButton::staticMouseEventTimer;
 QList<JoyButton*> JoyButton::pendingMouseButtons;
 
+QList<JoyButton::mouseCursorInfo> JoyButton::wheelXSpeeds;
+QList<JoyButton::mouseCursorInfo> JoyButton::wheelYSpeeds;
+QList<JoyButton*> JoyButton::pendingWheelButtons;
+
 // History buffers used for mouse smoothing routine.
 QList<double> JoyButton::mouseHistoryX;
 QList<double> JoyButton::mouseHistoryY;
@@ -116,6 +127,10 @@ QList<double> JoyButton::mouseHistoryY;
 double JoyButton::cursorRemainderX = 0.0;
 double JoyButton::cursorRemainderY = 0.0;
 
+// Carry over remainder of a wheel scroll for the next mouse event.
+double JoyButton::wheelRemainderX = 0.0;
+double JoyButton::wheelRemainderY = 0.0;
+
 double JoyButton::weightModifier = 0;
 int JoyButton::mouseHistorySize = 1;
 
@@ -127,8 +142,6 @@ int JoyButton::gamepadRefreshRate = 10;
 JoyKeyRepeatHelper JoyButton::repeatHelper;
 #endif
 
-static const double PI = acos(-1.0);
-
 JoyButton::JoyButton(int index, int originset, SetJoystick *parentSet,
                      QObject *parent) :
     QObject(parent)
@@ -142,13 +155,14 @@ JoyButton::JoyButton(int index, int originset, SetJoystick *parentSet,
     pauseWaitTimer.setParent(this);
     createDeskTimer.setParent(this);
     releaseDeskTimer.setParent(this);
-    mouseWheelVerticalEventTimer.setParent(this);
-    mouseWheelHorizontalEventTimer.setParent(this);
     setChangeTimer.setParent(this);
     keyPressTimer.setParent(this);
     delayTimer.setParent(this);
     slotSetChangeTimer.setParent(this);
-    activeZoneTimer.setParent(this);
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    turboTimer.setTimerType(Qt::PreciseTimer);
+#endif
 
     setChangeTimer.setSingleShot(true);
     slotSetChangeTimer.setSingleShot(true);
@@ -161,14 +175,13 @@ JoyButton::JoyButton(int index, int originset, SetJoystick *parentSet,
     connect(&createDeskTimer, SIGNAL(timeout()), this, SLOT(waitForDeskEvent()));
     connect(&releaseDeskTimer, SIGNAL(timeout()), this, SLOT(waitForReleaseDeskEvent()));
     connect(&turboTimer, SIGNAL(timeout()), this, SLOT(turboEvent()));
-    connect(&mouseWheelVerticalEventTimer, SIGNAL(timeout()), this, SLOT(wheelEventVertical()));
-    connect(&mouseWheelHorizontalEventTimer, SIGNAL(timeout()), this, SLOT(wheelEventHorizontal()));
     connect(&setChangeTimer, SIGNAL(timeout()), this, SLOT(checkForSetChange()));
     connect(&slotSetChangeTimer, SIGNAL(timeout()), this, SLOT(slotSetChange()));
-    connect(&activeZoneTimer, SIGNAL(timeout()), this, SLOT(buildActiveZoneSummaryString()));
 
-    activeZoneTimer.setInterval(0);
-    activeZoneTimer.setSingleShot(true);
+    activeZoneSlotCount = 0;
+    activeZoneStringVersion = -1;
+    hasDistanceZones = false;
+    currentDistanceZone = -1;
 
     // Will only matter on the first call
     establishMouseTimerConnections();
@@ -284,8 +297,8 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
                 emit clicked(index);
                 if (updateInitAccelValues)
                 {
-                    oldAccelMulti = updateOldAccelMulti = 0.0;
-                    accelTravel = 0.0;
+                    accelState.currentMulti = accelState.oldMulti = 0.0;
+                    accelState.travel = 0.0;
                 }
             }
             else
@@ -352,7 +365,7 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
                     buttonHeldRelease.restart();
                     keyPressHold.restart();
                     cycleResetHold.restart();
-                    turboTimer.start();
+                    startTurboSchedule();
 
                     // Newly activated button. Just entered safe zone.
                     if (updateInitAccelValues)
@@ -370,9 +383,11 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
                 else if (!isButtonPressed && !activePress && turboTimer.isActive())
                 {
                     turboTimer.stop();
-                    Logger::LogDebug(tr("Finishing turbo for button #%1 - %2")
+                    Logger::LogDebug(tr("Finishing turbo for button #%1 - %2. Requested %3 Hz, achieved %4 Hz")
                                     .arg(parentSet->getInputDevice()->getRealJoyNumber())
-                                    .arg(getPartialName()));
+                                    .arg(getPartialName())
+                                    .arg(turboInterval > 0 ? 1000.0 / turboInterval : 0.0, 0, 'f', 1)
+                                    .arg(getAchievedTurboRate(), 0, 'f', 1));
 
                     if (isKeyPressed)
                     {
@@ -383,7 +398,7 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
                         lastDistance = getMouseDistanceFromDeadZone();
                     }
 
-                    activeZoneTimer.start();
+                    publishActiveZone();
                 }
             }
             // Toogle is enabled and a controller button change has occurred.
@@ -458,7 +473,7 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
             {
                 updateLastMouseDistance = false;
                 updateStartingMouseDistance = false;
-                updateOldAccelMulti = 0.0;
+                accelState.currentMulti = 0.0;
             }
 
         }
@@ -554,8 +569,6 @@ void JoyButton::reset()
     createDeskTimer.stop();
     releaseDeskTimer.stop();
     holdTimer.stop();
-    mouseWheelVerticalEventTimer.stop();
-    mouseWheelHorizontalEventTimer.stop();
     setChangeTimer.stop();
     keyPressTimer.stop();
     delayTimer.stop();
@@ -572,14 +585,22 @@ void JoyButton::reset()
         slotiter = 0;
     }
 
+    // Clear the published active slots before the slots are deleted so the
+    // GUI never reads a deleted slot.
+    assignmentsLock.lockForWrite();
     releaseActiveSlots();
-    clearAssignedSlots();
+    clearAssignedSlots(false);
+    assignmentsLock.unlock();
+
+    emit slotsChanged();
 
     isButtonPressedQueue.clear();
     ignoreSetQueue.clear();
     mouseEventQueue.clear();
     mouseWheelVerticalEventQueue.clear();
     mouseWheelHorizontalEventQueue.clear();
+    wheelImpulses.clear();
+    pendingWheelButtons.removeAll(this);
 
     resetProperties(); // quitEvent changed here
 }
@@ -600,51 +621,99 @@ int JoyButton::getTurboInterval()
     return turboInterval;
 }
 
-void JoyButton::turboEvent()
+/**
+ * @brief Get the number of turbo presses per second achieved during the
+ *     current or most recent turbo run.
+ * @return Achieved rate in Hz
+ */
+double JoyButton::getAchievedTurboRate()
 {
-    if (!isKeyPressed)
+    double result = 0.0;
+    if (turboEpoch.isValid() && turboEpoch.elapsed() > 0)
     {
-        if (!isButtonPressedQueue.isEmpty())
-        {
-            ignoreSetQueue.clear();
-            isButtonPressedQueue.clear();
+        result = turboPressCount * 1000.0 / turboEpoch.elapsed();
+    }
 
-            ignoreSetQueue.enqueue(false);
-            isButtonPressedQueue.enqueue(isButtonPressed);
-        }
+    return result;
+}
+
+/**
+ * @brief Start a new turbo run. Transition deadlines are measured from
+ *     this point.
+ */
+void JoyButton::startTurboSchedule()
+{
+    turboEpoch.start();
+    turboDeadline = 0;
+    turboPressCount = 0;
+    turboTimer.start(0);
+}
+
+/**
+ * @brief Schedule the next turbo transition. The deadline is based on the
+ *     deadline of the previous transition rather than the current time so
+ *     event loop latency does not accumulate between cycles.
+ * @param Time in ms between the previous transition and the next one
+ */
+void JoyButton::scheduleTurboEvent(int duration)
+{
+    qint64 now = turboEpoch.elapsed();
+    if (now - turboDeadline > turboInterval)
+    {
+        // More than a full cycle behind. Restart the cycle from the current
+        // time instead of sending a burst of events to catch up.
+        turboDeadline = now;
+    }
+
+    turboDeadline += duration;
+    turboTimer.start(static_cast<int>(qMax(turboDeadline - now, static_cast<qint64>(0))));
+}
+
+void JoyButton::turboPressEvent()
+{
+    if (!isButtonPressedQueue.isEmpty())
+    {
+        ignoreSetQueue.clear();
+        isButtonPressedQueue.clear();
+
+        ignoreSetQueue.enqueue(false);
+        isButtonPressedQueue.enqueue(isButtonPressed);
+    }
+
+    createDeskEvent();
+    isKeyPressed = true;
+    turboPressCount++;
+}
+
+void JoyButton::turboReleaseEvent()
+{
+    if (!isButtonPressedQueue.isEmpty())
+    {
+        ignoreSetQueue.enqueue(false);
+        isButtonPressedQueue.enqueue(!isButtonPressed);
+    }
+
+    releaseDeskEvent();
+    isKeyPressed = false;
+}
 
-        createDeskEvent();
-        isKeyPressed = true;
+void JoyButton::turboEvent()
+{
+    if (!isKeyPressed)
+    {
+        turboPressEvent();
         if (turboTimer.isActive())
         {
-            int tempInterval = turboInterval / 2;
-            if (turboTimer.interval() != tempInterval)
-            {
-                turboTimer.start(tempInterval);
-            }
+            scheduleTurboEvent(turboInterval / 2);
         }
     }
     else
     {
-        if (!isButtonPressedQueue.isEmpty())
-        {
-            ignoreSetQueue.enqueue(false);
-            isButtonPressedQueue.enqueue(!isButtonPressed);
-        }
-
-        releaseDeskEvent();
-
-        isKeyPressed = false;
+        turboReleaseEvent();
         if (turboTimer.isActive())
         {
-            int tempInterval = turboInterval / 2;
-            if (turboTimer.interval() != tempInterval)
-            {
-                turboTimer.start(tempInterval);
-            }
-
+            scheduleTurboEvent(turboInterval - (turboInterval / 2));
         }
-
     }
 }
 
@@ -656,45 +725,57 @@ bool JoyButton::distanceEvent()
     {
         QReadLocker tempLocker(&assignmentsLock);
 
-        bool distanceFound = containsDistanceSlots();
-
-        if (distanceFound)
+        if (hasDistanceZones)
         {
             double currentDistance = getDistanceFromDeadZone();
-            double tempDistance = 0.0;
             JoyButtonSlot *previousDistanceSlot = 0;
-            QListIterator<JoyButtonSlot*> iter(assignments);
-            if (previousCycle)
+            bool sameZone = false;
+
+            const DistanceZoneSegment *segment = 0;
+            for (int i=0; i < distanceZoneSegments.size() && !segment; i++)
             {
-                iter.findNext(previousCycle);
+                if (distanceZoneSegments.at(i).cycleSlot == previousCycle)
+                {
+                    segment = &distanceZoneSegments.at(i);
+                }
             }
 
-            while (iter.hasNext())
+            if (segment)
             {
-                JoyButtonSlot *slot = iter.next();
-                int tempcode = slot->getSlotCode();
-                if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
+                int zone = currentDistanceZone;
+                bool zoneValid = (zone < 0 && !this->currentDistance) ||
+                        (zone >= 0 && zone < segment->zoneSlots.size() &&
+                         segment->zoneSlots.at(zone) == this->currentDistance);
+
+                if (zoneValid)
                 {
-                    tempDistance += tempcode / 100.0;
+                    // Movement inside the current zone (with hysteresis)
+                    // does not change anything.
+                    bool aboveLower = zone < 0 ||
+                            currentDistance >= segment->thresholds.at(zone) - DISTANCEZONEHYSTERESIS;
+                    bool belowUpper = zone + 1 >= segment->thresholds.size() ||
+                            currentDistance < segment->thresholds.at(zone + 1) + DISTANCEZONEHYSTERESIS;
+
+                    sameZone = aboveLower && belowUpper;
+                }
 
-                    if (currentDistance < tempDistance)
-                    {
-                        iter.toBack();
-                    }
-                    else
+                if (!sameZone)
+                {
+                    zone = findDistanceZone(*segment, currentDistance);
+                    currentDistanceZone = zone;
+                    if (zone >= 0)
                     {
-                        previousDistanceSlot = slot;
+                        previousDistanceSlot = segment->zoneSlots.at(zone);
                     }
                 }
-                else if (slot->getSlotMode() == JoyButtonSlot::JoyCycle)
-                {
-                    tempDistance = 0.0;
-                    iter.toBack();
-                }
+            }
+            else
+            {
+                currentDistanceZone = -1;
             }
 
             // No applicable distance slot
-            if (!previousDistanceSlot)
+            if (!sameZone && !previousDistanceSlot)
             {
                 if (this->currentDistance)
                 {
@@ -720,7 +801,7 @@ bool JoyButton::distanceEvent()
                 }
             }
             // An applicable distance slot was found
-            else if (previousDistanceSlot)
+            else if (!sameZone && previousDistanceSlot)
             {
                 if (this->currentDistance != previousDistanceSlot)
                 {
@@ -754,6 +835,61 @@ bool JoyButton::distanceEvent()
     return released;
 }
 
+/**
+ * @brief Compile the distance slots of every cycle segment into sorted
+ *     thresholds so the active zone can be found with a binary search.
+ *     assignmentsLock must be held for writing.
+ */
+void JoyButton::buildDistanceZones()
+{
+    distanceZoneSegments.clear();
+    hasDistanceZones = false;
+    currentDistanceZone = -1;
+
+    DistanceZoneSegment segment;
+    segment.cycleSlot = 0;
+    double tempDistance = 0.0;
+
+    QListIterator<JoyButtonSlot*> iter(assignments);
+    while (iter.hasNext())
+    {
+        JoyButtonSlot *slot = iter.next();
+        if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
+        {
+            tempDistance += slot->getSlotCode() / 100.0;
+            segment.thresholds.append(tempDistance);
+            segment.zoneSlots.append(slot);
+            hasDistanceZones = true;
+        }
+        else if (slot->getSlotMode() == JoyButtonSlot::JoyCycle)
+        {
+            distanceZoneSegments.append(segment);
+
+            segment.cycleSlot = slot;
+            segment.thresholds.clear();
+            segment.zoneSlots.clear();
+            tempDistance = 0.0;
+        }
+    }
+
+    distanceZoneSegments.append(segment);
+}
+
+/**
+ * @brief Find the zone that applies to a distance. A zone starts at its
+ *     threshold and ends at the threshold of the next zone.
+ * @param Compiled cycle segment
+ * @param Distance from the dead zone
+ * @return Index of the zone or -1 if the distance is below every zone
+ */
+int JoyButton::findDistanceZone(const DistanceZoneSegment &segment, double distance)
+{
+    QVector<double>::const_iterator iter =
+            qUpperBound(segment.thresholds.constBegin(), segment.thresholds.constEnd(), distance);
+
+    return static_cast<int>(iter - segment.thresholds.constBegin()) - 1;
+}
+
 void JoyButton::createDeskEvent()
 {
     quitEvent = false;
@@ -794,8 +930,6 @@ void JoyButton::activateSlots()
 {
     if (slotiter)
     {
-        QWriteLocker tempLocker(&activeZoneLock);
-
         bool exit = false;
         //bool delaySequence = checkForDelaySequence();
         bool delaySequence = false;
@@ -811,8 +945,7 @@ void JoyButton::activateSlots()
             {
                 sendevent(slot, true);
                 activeSlots.append(slot);
-                int oldvalue = activeKeys.value(tempcode, 0) + 1;
-                activeKeys.insert(tempcode, oldvalue);
+                activeKeys.acquire(tempcode, slot->getSlotCodeAlias());
                 if (!slot->isModifierKey())
                 {
                     lastActiveKey = slot;
@@ -830,28 +963,21 @@ void JoyButton::activateSlots()
                     tempcode == JoyButtonSlot::MouseWheelDown)
                 {
                     slot->getMouseInterval()->restart();
-                    wheelVerticalTime.restart();
-                    currentWheelVerticalEvent = slot;
                     activeSlots.append(slot);
-                    wheelEventVertical();
-                    currentWheelVerticalEvent = 0;
+                    queueWheelSlot(slot);
                 }
                 else if (tempcode == JoyButtonSlot::MouseWheelLeft ||
                          tempcode == JoyButtonSlot::MouseWheelRight)
                 {
                     slot->getMouseInterval()->restart();
-                    wheelHorizontalTime.restart();
-                    currentWheelHorizontalEvent = slot;
                     activeSlots.append(slot);
-                    wheelEventHorizontal();
-                    currentWheelHorizontalEvent = 0;
+                    queueWheelSlot(slot);
                 }
                 else
                 {
                     sendevent(slot, true);
                     activeSlots.append(slot);
-                    int oldvalue = activeMouseButtons.value(tempcode, 0) + 1;
-                    activeMouseButtons.insert(tempcode, oldvalue);
+                    activeMouseButtons.acquire(tempcode);
                 }
             }
             else if (mode == JoyButtonSlot::JoyMouseMovement)
@@ -881,8 +1007,9 @@ void JoyButton::activateSlots()
                         staticMouseEventTimer.start(tempRate);
 
                         //lastMouseTime.restart();
-                        testOldMouseTime.restart();
-                        accelExtraDurationTime.restart();
+                        lastMouseTickTime = currentMouseTime();
+                        mouseTickTime = -1;
+                        accelState.multiplierTime = JoyExtraAcceleration::currentTime();
                     }
                 }
             }
@@ -1038,7 +1165,7 @@ void JoyButton::activateSlots()
 #endif
 
         //emit activeZoneChanged();
-        activeZoneTimer.start();
+        publishActiveZone();
     }
 }
 
@@ -1077,7 +1204,6 @@ void JoyButton::mouseEvent()
     {
         updateLastMouseDistance = true;
         updateStartingMouseDistance = true;
-        updateOldAccelMulti = 0.0;
 
         QQueue<JoyButtonSlot*> tempQueue;
 
@@ -1086,18 +1212,9 @@ void JoyButton::mouseEvent()
             buttonslot = mouseEventQueue.dequeue();
         }
 
-        //unsigned int timeElapsed = lastMouseTime.elapsed();
-        unsigned int timeElapsed = testOldMouseTime.elapsed();
-        //unsigned int nanoTimeElapsed = lastMouseTime.nsecsElapsed();
-
-        // Presumed initial mouse movement. Use full duration rather than
-        // partial.
-        if (staticMouseEventTimer.interval() < mouseRefreshRate)
-        {
-            //unsigned int nanoRemainder = nanoTimeElapsed - (timeElapsed * 1000000);
-            timeElapsed = getMouseRefreshRate() + (timeElapsed - staticMouseEventTimer.interval());
-            //nanoTimeElapsed = (timeElapsed * 1000000) + (nanoRemainder);
-        }
+        // Velocity is integrated over the exact time since the previous
+        // mouse tick so displacement does not depend on the refresh rate.
+        qint64 tickElapsed = getMouseTickElapsed();
 
         while (buttonslot)
         {
@@ -1272,131 +1389,26 @@ void JoyButton::mouseEvent()
                     double distance = 0;
                     difference = (mouseSpeedModifier == 1.0) ? difference : (difference * mouseSpeedModifier);
 
-                    double mintravel = minMouseDistanceAccelThreshold * 0.01;
-                    double minstop = qMax(0.05, mintravel);
-                    //double currentTravel = getAccelerationDistance() - lastAccelerationDistance;
-
-                    // Last check ensures that acceleration is only applied for the same direction.
-                    if (extraAccelerationEnabled && isPartRealAxis() &&
-                        fabs(getAccelerationDistance() - lastAccelerationDistance) >= mintravel &&
-                        (getAccelerationDistance() - lastAccelerationDistance >= 0) == (getAccelerationDistance() >= 0))
+                    if (extraAccelerationEnabled && isPartRealAxis())
                     {
-                        double magfactor = extraAccelerationMultiplier;
-                        double minfactor = qMax((DEFAULTSTARTACCELMULTIPLIER * 0.001) + 1.0, magfactor * (startAccelMultiplier * 0.01));
-                        double maxtravel = maxMouseDistanceAccelThreshold * 0.01;
-                        double slope = (magfactor - minfactor)/(maxtravel - mintravel);
-                        double intercept = minfactor - (slope * mintravel);
-
-                        double intermediateTravel = qMin(maxtravel, fabs(getAccelerationDistance() - lastAccelerationDistance));
-                        if (currentAccelMulti > 1.0 && oldAccelMulti == 0.0)
-                        {
-                            intermediateTravel = qMin(maxtravel, intermediateTravel + mintravel);
-                        }
-
-                        double currentAccelMultiTemp = (slope * intermediateTravel + intercept);
-                        if (extraAccelCurve == EaseOutSineCurve)
-                        {
-                            double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(getMultiDiff2 * (PI/2.0)) + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutQuadAccelCurve)
-                        {
-                            double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            currentAccelMultiTemp = -(extraAccelerationMultiplier - minfactor) * (getMultiDiff2 * (getMultiDiff2 - 2)) + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutCubicAccelCurve)
-                        {
-                            double getMultiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor)) - 1;
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * ((getMultiDiff) * (getMultiDiff) * (getMultiDiff) + 1) + minfactor;
-                        }
-
-                        difference = difference * currentAccelMultiTemp;
-                        currentAccelMulti = currentAccelMultiTemp;
-                        updateOldAccelMulti = currentAccelMulti;
-                        accelTravel = intermediateTravel;
-                        accelExtraDurationTime.restart();
+                        JoyExtraAcceleration::Parameters accelParams;
+                        accelParams.multiplier = extraAccelerationMultiplier;
+                        accelParams.minThreshold = minMouseDistanceAccelThreshold;
+                        accelParams.maxThreshold = maxMouseDistanceAccelThreshold;
+                        accelParams.startMultiplier = startAccelMultiplier;
+                        accelParams.duration = accelDuration;
+                        accelParams.curve = static_cast<JoyExtraAcceleration::EasingCurve>(extraAccelCurve);
+
+                        difference = difference * JoyExtraAcceleration::calculateMultiplier(
+                                    accelParams, accelState, getAccelerationDistance(),
+                                    lastAccelerationDistance, startingAccelerationDistance,
+                                    currentDistanceTime - accelState.lastDistanceTime,
+                                    JoyExtraAcceleration::currentTime(),
+                                    updateStartingMouseDistance);
                     }
-                    else if (extraAccelerationEnabled && isPartRealAxis() && accelDuration > 0.0 &&
-                             currentAccelMulti > 0.0 &&
-                             fabs(getAccelerationDistance() - startingAccelerationDistance) < minstop)
-                    {
-                        //qDebug() << "Keep Trying: " << fabs(getAccelerationDistance() - lastAccelerationDistance);
-                        //qDebug() << "MIN TRAVEL: " << mintravel;
-
-                        updateStartingMouseDistance = true;
-                        double magfactor = extraAccelerationMultiplier;
-                        double minfactor = qMax((DEFAULTSTARTACCELMULTIPLIER * 0.001) + 1.0, magfactor * (startAccelMultiplier * 0.01));
-                        double maxtravel = maxMouseDistanceAccelThreshold * 0.01;
-                        double slope = (magfactor - minfactor)/(maxtravel - mintravel);
-                        double intercept = minfactor - (slope * mintravel);
-
-                        unsigned int elapsedElapsed = accelExtraDurationTime.elapsed();
-
-                        double intermediateTravel = accelTravel;
-                        if ((getAccelerationDistance() - startingAccelerationDistance >= 0) != (getAccelerationDistance() >= 0))
-                        {
-                            // Travelling towards dead zone. Decrease acceleration and duration.
-                            intermediateTravel = qMax(intermediateTravel - fabs(getAccelerationDistance() - startingAccelerationDistance), mintravel);
-                        }
-
-                        // Linear case
-                        double currentAccelMultiTemp = (slope * intermediateTravel + intercept);
-                        double elapsedDuration = accelDuration *
-                                ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-
-                        if (extraAccelCurve == EaseOutSineCurve)
-                        {
-                            double multiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            double temp = sin(multiDiff * (PI/2.0));
-                            elapsedDuration = accelDuration * temp + 0;
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(multiDiff * (PI/2.0)) + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutQuadAccelCurve)
-                        {
-                            double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            double temp = (getMultiDiff2 * (getMultiDiff2 - 2));
-                            elapsedDuration = -accelDuration * temp + 0;
-                            currentAccelMultiTemp = -(extraAccelerationMultiplier - minfactor) * temp + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutCubicAccelCurve)
-                        {
-                            double getMultiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor)) - 1;
-                            double temp = ((getMultiDiff) * (getMultiDiff) * (getMultiDiff) + 1);
-                            elapsedDuration = accelDuration * temp + 0;
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * temp + minfactor;
-                        }
 
-                        double tempAccel = currentAccelMultiTemp;
-                        double elapsedDiff = 1.0;
-                        if (elapsedDuration > 0.0 && (elapsedElapsed * 0.001) < elapsedDuration)
-                        {
-                            elapsedDiff = ((elapsedElapsed * 0.001) / elapsedDuration);
-                            elapsedDiff = (1.0 - tempAccel) * (elapsedDiff * elapsedDiff * elapsedDiff) + tempAccel;
-
-                            difference = elapsedDiff * difference;
-
-                            // As acceleration is applied, do not update last
-                            // distance values when not necessary.
-                            updateStartingMouseDistance = false;
-                            updateOldAccelMulti = currentAccelMulti;
-                        }
-                        else
-                        {
-                            elapsedDiff = 1.0;
-                            currentAccelMulti = 0.0;
-                            updateOldAccelMulti = 0.0;
-                            accelTravel = 0.0;
-                        }
-                    }
-                    else if (extraAccelerationEnabled && isPartRealAxis())
-                    {
-                        currentAccelMulti = 0.0;
-                        updateStartingMouseDistance = true;
-                        oldAccelMulti = updateOldAccelMulti = 0.0;
-                        accelTravel = 0.0;
-                    }
-
-                    sumDist += difference * (mousespeed * JoyButtonSlot::JOYSPEED * timeElapsed) * 0.001;
+                    sumDist += JoyMouseMotion::displacement(
+                                difference * (mousespeed * JoyButtonSlot::JOYSPEED), tickElapsed);
                     //sumDist = difference * (nanoTimeElapsed * 0.000000001) * mousespeed * JoyButtonSlot::JOYSPEED;
                     distance = sumDist;
 
@@ -1520,112 +1532,233 @@ void JoyButton::mouseEvent()
     }
 }
 
-void JoyButton::wheelEventVertical()
+/**
+ * @brief Queue the scroll of the active wheel slots of the button for the
+ *     current mouse tick. Scroll is integrated from the wheel speed and the
+ *     distance of the button over the time since the previous tick. Runs
+ *     in the mouse thread.
+ */
+void JoyButton::wheelEvent()
 {
-    JoyButtonSlot *buttonslot = 0;
-    if (currentWheelVerticalEvent)
+    double elapsed = getMouseTickElapsed() * 0.000000001;
+    double distance = getMouseDistanceFromDeadZone();
+
+    QListIterator<mouseCursorInfo> iterImpulse(wheelImpulses);
+    while (iterImpulse.hasNext())
+    {
+        mouseCursorInfo info = iterImpulse.next();
+        if (isVerticalWheelSlot(info.slot))
+        {
+            wheelYSpeeds.append(info);
+        }
+        else
+        {
+            wheelXSpeeds.append(info);
+        }
+    }
+
+    wheelImpulses.clear();
+
+    double detentsY = wheelSpeedY * distance * elapsed;
+    QListIterator<JoyButtonSlot*> iterY(mouseWheelVerticalEventQueue);
+    while (iterY.hasNext())
+    {
+        mouseCursorInfo info;
+        info.slot = iterY.next();
+        info.code = isPositiveWheelSlot(info.slot) ? detentsY : -detentsY;
+        wheelYSpeeds.append(info);
+    }
+
+    double detentsX = wheelSpeedX * distance * elapsed;
+    QListIterator<JoyButtonSlot*> iterX(mouseWheelHorizontalEventQueue);
+    while (iterX.hasNext())
+    {
+        mouseCursorInfo info;
+        info.slot = iterX.next();
+        info.code = isPositiveWheelSlot(info.slot) ? detentsX : -detentsX;
+        wheelXSpeeds.append(info);
+    }
+
+    if (mouseWheelVerticalEventQueue.isEmpty() && mouseWheelHorizontalEventQueue.isEmpty())
     {
-        buttonslot = currentWheelVerticalEvent;
+        pendingWheelButtons.removeAll(this);
     }
+}
 
-    if (buttonslot && wheelSpeedY != 0)
+/**
+ * @brief Start scrolling for a wheel slot. The slot scrolls a full detent
+ *     on the next mouse tick and is then integrated by wheelEvent until
+ *     it is released.
+ * @param Wheel slot being activated
+ */
+void JoyButton::queueWheelSlot(JoyButtonSlot *slot)
+{
+    bool vertical = isVerticalWheelSlot(slot);
+    int wheelSpeed = vertical ? wheelSpeedY : wheelSpeedX;
+    if (wheelSpeed != 0)
     {
-        bool isActive = activeSlots.contains(buttonslot);
-        if (isActive)
+        if (vertical)
         {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
-            mouseWheelVerticalEventQueue.enqueue(buttonslot);
-            mouseWheelVerticalEventTimer.start(1000 / wheelSpeedY);
+            mouseWheelVerticalEventQueue.enqueue(slot);
         }
         else
         {
-            mouseWheelVerticalEventTimer.stop();
+            mouseWheelHorizontalEventQueue.enqueue(slot);
+        }
+
+        mouseCursorInfo info;
+        info.slot = slot;
+        info.code = isPositiveWheelSlot(slot) ? 1.0 : -1.0;
+        wheelImpulses.append(info);
+
+        if (!pendingWheelButtons.contains(this))
+        {
+            pendingWheelButtons.append(this);
+        }
+
+        if (!staticMouseEventTimer.isActive() || staticMouseEventTimer.interval() == IDLEMOUSEREFRESHRATE)
+        {
+            staticMouseEventTimer.start(mouseRefreshRate);
+            lastMouseTickTime = currentMouseTime();
+            mouseTickTime = -1;
         }
     }
-    else if (!mouseWheelVerticalEventQueue.isEmpty() && wheelSpeedY != 0)
+}
+
+/**
+ * @brief Scroll the mouse wheel using the combined scroll queued by every
+ *     button during the current mouse tick. At most one wheel event is
+ *     sent for each axis no matter how many buttons are scrolling.
+ */
+void JoyButton::moveMouseWheel()
+{
+    if (!wheelXSpeeds.isEmpty() || !wheelYSpeeds.isEmpty())
     {
-        QQueue<JoyButtonSlot*> tempQueue;
-        while (!mouseWheelVerticalEventQueue.isEmpty())
+        bool highResolution = hasHighResolutionWheel();
+        JoyButtonSlot *clickSlotX = 0;
+        JoyButtonSlot *clickSlotY = 0;
+        int scrollX = takeWheelScroll(wheelXSpeeds, wheelRemainderX, highResolution, clickSlotX);
+        int scrollY = takeWheelScroll(wheelYSpeeds, wheelRemainderY, highResolution, clickSlotY);
+
+        if (highResolution)
         {
-            buttonslot = mouseWheelVerticalEventQueue.dequeue();
-            bool isActive = activeSlots.contains(buttonslot);
-            if (isActive)
+            if (scrollX != 0 || scrollY != 0)
             {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
-                tempQueue.enqueue(buttonslot);
+                sendWheelEvent(scrollY, scrollX);
             }
         }
-
-        if (!tempQueue.isEmpty())
-        {
-            mouseWheelVerticalEventQueue = tempQueue;
-            mouseWheelVerticalEventTimer.start(1000 / wheelSpeedY);
-        }
         else
         {
-            mouseWheelVerticalEventTimer.stop();
+            if (clickSlotY)
+            {
+                sendevent(clickSlotY, true);
+                sendevent(clickSlotY, false);
+            }
+
+            if (clickSlotX)
+            {
+                sendevent(clickSlotX, true);
+                sendevent(clickSlotX, false);
+            }
         }
     }
-    else
+
+    if (pendingWheelButtons.isEmpty())
     {
-        mouseWheelVerticalEventTimer.stop();
+        wheelRemainderX = 0.0;
+        wheelRemainderY = 0.0;
     }
 }
 
-void JoyButton::wheelEventHorizontal()
+/**
+ * @brief Combine the scroll queued for one axis with the remainder left
+ *     from previous ticks and take the part that can be sent now.
+ * @param Scroll queued for the axis. Cleared after use.
+ * @param Scroll in detents not sent yet. Signed by direction.
+ * @param Whether the event handler supports high resolution scrolling
+ * @param Set to the slot to click when high resolution scrolling is
+ *     not supported. Left as 0 if no click should be sent.
+ * @return High resolution units to scroll or the number of clicks to send
+ */
+int JoyButton::takeWheelScroll(QList<mouseCursorInfo> &speeds, double &remainder,
+                               bool highResolution, JoyButtonSlot *&clickSlot)
 {
-    JoyButtonSlot *buttonslot = 0;
-    if (currentWheelHorizontalEvent)
-    {
-        buttonslot = currentWheelHorizontalEvent;
-    }
+    int result = 0;
+    double scroll = 0.0;
+    JoyButtonSlot *positiveSlot = 0;
+    JoyButtonSlot *negativeSlot = 0;
 
-    if (buttonslot && wheelSpeedX != 0)
+    QListIterator<mouseCursorInfo> iter(speeds);
+    while (iter.hasNext())
     {
-        bool isActive = activeSlots.contains(buttonslot);
-        if (isActive)
+        mouseCursorInfo info = iter.next();
+        scroll += info.code;
+        if (isPositiveWheelSlot(info.slot))
         {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
-            mouseWheelHorizontalEventQueue.enqueue(buttonslot);
-            mouseWheelHorizontalEventTimer.start(1000 / wheelSpeedX);
+            positiveSlot = positiveSlot ? positiveSlot : info.slot;
         }
         else
         {
-            mouseWheelHorizontalEventTimer.stop();
+            negativeSlot = negativeSlot ? negativeSlot : info.slot;
         }
     }
-    else if (!mouseWheelHorizontalEventQueue.isEmpty() && wheelSpeedX != 0)
+
+    speeds.clear();
+
+    if (scroll != 0.0)
     {
-        QQueue<JoyButtonSlot*> tempQueue;
-        while (!mouseWheelHorizontalEventQueue.isEmpty())
+        // Drop the remainder left over from scrolling in the
+        // other direction.
+        if ((remainder < 0.0) != (scroll < 0.0))
         {
-            buttonslot = mouseWheelHorizontalEventQueue.dequeue();
-            bool isActive = activeSlots.contains(buttonslot);
-            if (isActive)
-            {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
-                tempQueue.enqueue(buttonslot);
-            }
+            remainder = 0.0;
         }
 
-        if (!tempQueue.isEmpty())
+        remainder += scroll;
+    }
+
+    if (highResolution)
+    {
+        result = static_cast<int>(remainder * BaseEventHandler::WHEELDETENTUNITS);
+        remainder -= result / static_cast<double>(BaseEventHandler::WHEELDETENTUNITS);
+    }
+    else
+    {
+        if (remainder >= 1.0 && positiveSlot)
         {
-            mouseWheelHorizontalEventQueue = tempQueue;
-            mouseWheelHorizontalEventTimer.start(1000 / wheelSpeedX);
+            result = 1;
+            clickSlot = positiveSlot;
         }
-        else
+        else if (remainder <= -1.0 && negativeSlot)
         {
-            mouseWheelHorizontalEventTimer.stop();
+            result = -1;
+            clickSlot = negativeSlot;
         }
+
+        // Only one click is sent per tick. Do not let a backlog build up
+        // so scrolling stops as soon as the buttons are released.
+        remainder = qBound(-1.0, remainder - result, 1.0);
     }
-    else
-    {
-        mouseWheelHorizontalEventTimer.stop();
-    }
+
+    return result;
+}
+
+bool JoyButton::isVerticalWheelSlot(JoyButtonSlot *slot)
+{
+    return slot->getSlotCode() == JoyButtonSlot::MouseWheelUp ||
+           slot->getSlotCode() == JoyButtonSlot::MouseWheelDown;
+}
+
+/**
+ * @brief Whether a wheel slot scrolls in the positive direction of
+ *     its axis. Matches the direction used by the event handlers.
+ * @param Wheel slot
+ * @return Whether the slot scrolls up or left
+ */
+bool JoyButton::isPositiveWheelSlot(JoyButtonSlot *slot)
+{
+    return slot->getSlotCode() == JoyButtonSlot::MouseWheelUp ||
+           slot->getSlotCode() == JoyButtonSlot::MouseWheelLeft;
 }
 
 void JoyButton::setUseTurbo(bool useTurbo)
@@ -2354,48 +2487,139 @@ QString JoyButton::getSlotsSummary()
  */
 QString JoyButton::getActiveZoneSummary()
 {
-    QList<JoyButtonSlot*> tempList = getActiveZoneList();
+    QList<ActiveZoneSlotInfo> tempList = getActiveZoneList();
     QString temp = buildActiveZoneSummary(tempList);
     return temp;
 }
 
+/**
+ * @brief Get the summary of slots that will be activated or are currently
+ *     active. The summary is only rebuilt when the active zone has changed
+ *     since the last call. Meant to be called from the GUI thread.
+ * @return String of currently applicable slots for a button
+ */
 QString JoyButton::getCalculatedActiveZoneSummary()
 {
+    int version = getActiveZoneVersion();
+
     activeZoneStringLock.lockForRead();
-    QString temp = this->activeZoneString;
+    if (activeZoneStringVersion == version)
+    {
+        QString temp = this->activeZoneString;
+        activeZoneStringLock.unlock();
+        return temp;
+    }
     activeZoneStringLock.unlock();
+
+    QString temp = getActiveZoneSummary();
+
+    activeZoneStringLock.lockForWrite();
+    this->activeZoneString = temp;
+    this->activeZoneStringVersion = version;
+    activeZoneStringLock.unlock();
+
     return temp;
 }
 
 /**
- * @brief Generate active zone string and notify other objects.
+ * @brief Get a value that changes every time the active zone of the button
+ *     changes. Used by the GUI to check if a label has to be updated.
+ * @return Active zone version
+ */
+int JoyButton::getActiveZoneVersion()
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    return activeZoneSequence.load() + activeZoneConfigVersion.load();
+#else
+    return activeZoneSequence + activeZoneConfigVersion;
+#endif
+}
+
+/**
+ * @brief Mark active zone string as outdated and notify other objects.
  */
 void JoyButton::buildActiveZoneSummaryString()
 {
-    activeZoneStringLock.lockForWrite();
-    this->activeZoneString = getActiveZoneSummary();
-    activeZoneStringLock.unlock();
+    activeZoneConfigVersion.fetchAndAddOrdered(1);
 
     emit activeZoneChanged();
 }
 
 /**
- * @brief Generate active zone string but do not notify any other object.
+ * @brief Mark active zone string as outdated but do not notify any
+ *     other object.
  */
 void JoyButton::localBuildActiveZoneSummaryString()
 {
-    activeZoneStringLock.lockForWrite();
-    this->activeZoneString = getActiveZoneSummary();
-    activeZoneStringLock.unlock();
+    activeZoneConfigVersion.fetchAndAddOrdered(1);
 }
 
-QString JoyButton::buildActiveZoneSummary(QList<JoyButtonSlot *> &tempList)
+/**
+ * @brief Copy the first active slots so the GUI can build a summary without
+ *     touching activeSlots. Only called from the thread processing
+ *     button events. No locks are taken and no strings are built.
+ */
+void JoyButton::publishActiveZone()
+{
+    activeZoneSequence.fetchAndAddOrdered(1);
+
+    int count = 0;
+    QListIterator<JoyButtonSlot*> iter(activeSlots);
+    while (iter.hasNext() && count < MAXACTIVEZONESLOTS)
+    {
+        activeZoneSlots[count] = iter.next();
+        count++;
+    }
+
+    activeZoneSlotCount = count;
+
+    activeZoneSequence.fetchAndAddOrdered(1);
+}
+
+/**
+ * @brief Read the slots published by publishActiveZone. Retries if the
+ *     copy was changed while it was being read.
+ * @param Destination array. Must hold MAXACTIVEZONESLOTS elements.
+ * @return Number of slots copied
+ */
+int JoyButton::readActiveZoneSnapshot(JoyButtonSlot **slots)
+{
+    int count = 0;
+    bool done = false;
+    while (!done)
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        int start = activeZoneSequence.loadAcquire();
+#else
+        int start = activeZoneSequence;
+#endif
+        if ((start & 1) == 0)
+        {
+            count = qMin(activeZoneSlotCount, static_cast<int>(MAXACTIVEZONESLOTS));
+            for (int i=0; i < count; i++)
+            {
+                slots[i] = activeZoneSlots[i];
+            }
+
+            done = activeZoneSequence.testAndSetOrdered(start, start);
+        }
+        else
+        {
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    return count;
+}
+
+QString JoyButton::buildActiveZoneSummary(QList<ActiveZoneSlotInfo> &tempList)
 {
     QString newlabel;
-    QListIterator<JoyButtonSlot*> iter(tempList);
+    QListIterator<ActiveZoneSlotInfo> iter(tempList);
     QStringList stringlist;
     int i = 0;
-    bool slotsActive = !activeSlots.isEmpty();
+    JoyButtonSlot *publishedSlots[MAXACTIVEZONESLOTS];
+    bool slotsActive = readActiveZoneSnapshot(publishedSlots) > 0;
 
     if (setSelectionCondition == SetChangeOneWay)
     {
@@ -2423,15 +2647,14 @@ QString JoyButton::buildActiveZoneSummary(QList<JoyButtonSlot *> &tempList)
         bool behindHold = false;
         while (iter.hasNext())
         {
-            JoyButtonSlot *slot = iter.next();
-            JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
-            switch (mode)
+            const ActiveZoneSlotInfo &info = iter.next();
+            switch (info.mode)
             {
                 case JoyButtonSlot::JoyKeyboard:
                 case JoyButtonSlot::JoyMouseButton:
                 case JoyButtonSlot::JoyMouseMovement:
                 {
-                    QString temp = slot->getSlotString();
+                    QString temp = info.label;
                     if (behindHold)
                     {
                         temp.prepend("[H] ");
@@ -2468,7 +2691,7 @@ QString JoyButton::buildActiveZoneSummary(QList<JoyButtonSlot *> &tempList)
                 case JoyButtonSlot::JoyTextEntry:
                 case JoyButtonSlot::JoyExecute:
                 {
-                    QString temp = slot->getSlotString();
+                    QString temp = info.label;
                     if (behindHold)
                     {
                         temp.prepend("[H] ");
@@ -2524,41 +2747,46 @@ QString JoyButton::buildActiveZoneSummary(QList<JoyButtonSlot *> &tempList)
     return newlabel;
 }
 
-QList<JoyButtonSlot*> JoyButton::getActiveZoneList()
+/**
+ * @brief Copy the data of the slots that will be activated or are currently
+ *     active. Slots are only deleted while assignmentsLock is held for
+ *     writing, and the published active slots are cleared before that, so
+ *     the slots are only touched while the lock is held for reading.
+ * @return Copied slot data
+ */
+QList<JoyButton::ActiveZoneSlotInfo> JoyButton::getActiveZoneList()
 {
-    QListIterator<JoyButtonSlot*> activeSlotsIter(activeSlots);
+    QReadLocker tempLocker(&assignmentsLock);
+    Q_UNUSED(tempLocker);
+
+    JoyButtonSlot *publishedSlots[MAXACTIVEZONESLOTS];
+    int numActiveSlots = readActiveZoneSnapshot(publishedSlots);
+
+    QList<JoyButtonSlot*> activeSlotsCopy;
+    for (int i=0; i < numActiveSlots; i++)
+    {
+        activeSlotsCopy.append(publishedSlots[i]);
+    }
+
+    QListIterator<JoyButtonSlot*> activeSlotsIter(activeSlotsCopy);
     QListIterator<JoyButtonSlot*> assignmentsIter(assignments);
 
     QListIterator<JoyButtonSlot*> *iter = 0;
-    QReadWriteLock *tempLock = 0;
-
-    activeZoneLock.lockForRead();
-    int numActiveSlots = activeSlots.size();
-    activeZoneLock.unlock();
 
     if (numActiveSlots > 0)
     {
-        tempLock = &activeZoneLock;
         iter = &activeSlotsIter;
     }
     else
     {
-        tempLock = &assignmentsLock;
         iter = &assignmentsIter;
-    }
-
-    QReadLocker tempLocker(tempLock);
-    Q_UNUSED(tempLocker);
-
-    if (tempLock == &assignmentsLock)
-    {
         if (previousCycle)
         {
             iter->findNext(previousCycle);
         }
     }
 
-    QList<JoyButtonSlot*> tempSlotList;
+    QList<ActiveZoneSlotInfo> tempSlotList;
 
     if (setSelectionCondition != SetChangeWhileHeld && iter->hasNext())
     {
@@ -2572,7 +2800,10 @@ QList<JoyButtonSlot*> JoyButton::getActiveZoneList()
                 case JoyButtonSlot::JoyMouseButton:
                 case JoyButtonSlot::JoyMouseMovement:
                 {
-                    tempSlotList.append(slot);
+                    ActiveZoneSlotInfo info;
+                    info.mode = mode;
+                    info.label = slot->getSlotString();
+                    tempSlotList.append(info);
                     break;
                 }
                 case JoyButtonSlot::JoyKeyPress:
@@ -2582,7 +2813,10 @@ QList<JoyButtonSlot*> JoyButton::getActiveZoneList()
                 case JoyButtonSlot::JoyTextEntry:
                 case JoyButtonSlot::JoyExecute:
                 {
-                    tempSlotList.append(slot);
+                    ActiveZoneSlotInfo info;
+                    info.mode = mode;
+                    info.label = slot->getSlotString();
+                    tempSlotList.append(info);
                     break;
                 }
                 case JoyButtonSlot::JoyRelease:
@@ -2671,6 +2905,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
             {
                 assignmentsLock.lockForWrite();
                 assignments.append(slot);
+                buildDistanceZones();
                 assignmentsLock.unlock();
 
                 buildActiveZoneSummaryString();
@@ -2682,6 +2917,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
     {
         assignmentsLock.lockForWrite();
         assignments.append(slot);
+        buildDistanceZones();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2727,6 +2963,7 @@ bool JoyButton::setAssignedSlot(int code, unsigned int alias,
             {
                 assignmentsLock.lockForWrite();
                 assignments.append(slot);
+                buildDistanceZones();
                 assignmentsLock.unlock();
 
                 buildActiveZoneSummaryString();
@@ -2738,6 +2975,7 @@ bool JoyButton::setAssignedSlot(int code, unsigned int alias,
     {
         assignmentsLock.lockForWrite();
         assignments.append(slot);
+        buildDistanceZones();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2819,6 +3057,7 @@ bool JoyButton::setAssignedSlot(int code, unsigned int alias, int index,
         }
 
         checkTurboCondition(slot);
+        buildDistanceZones();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2888,6 +3127,7 @@ bool JoyButton::insertAssignedSlot(int code, unsigned int alias, int index,
         }
 
         checkTurboCondition(slot);
+        buildDistanceZones();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2945,6 +3185,7 @@ bool JoyButton::insertAssignedSlot(JoyButtonSlot *newSlot, bool updateActiveStri
         assignmentsLock.lockForWrite();
         checkTurboCondition(newSlot);
         assignments.append(newSlot);
+        buildDistanceZones();
         assignmentsLock.unlock();
 
         if (updateActiveString)
@@ -3019,6 +3260,7 @@ bool JoyButton::setAssignedSlot(JoyButtonSlot *otherSlot, int index)
             assignments.append(newslot);
         }
 
+        buildDistanceZones();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -3600,12 +3842,9 @@ void JoyButton::releaseDeskEvent(bool skipsetchange)
     if (!currentRelease)
     {
         lastAccelerationDistance = 0.0;
-        currentAccelMulti = 0.0;
         currentAccelerationDistance = 0.0;
         startingAccelerationDistance = 0.0;
-        oldAccelMulti = updateOldAccelMulti = 0.0;
-        accelTravel = 0.0;
-        accelExtraDurationTime.restart();
+        JoyExtraAcceleration::resetState(accelState, JoyExtraAcceleration::currentTime());
 
         lastMouseDistance = 0.0;
         currentMouseDistance = 0.0;
@@ -3761,6 +4000,7 @@ void JoyButton::clearAssignedSlots(bool signalEmit)
     }
 
     assignments.clear();
+    buildDistanceZones();
     if (signalEmit)
     {
         emit slotsChanged();
@@ -3776,10 +4016,18 @@ void JoyButton::removeAssignedSlot(int index)
         JoyButtonSlot *slot = assignments.takeAt(index);
         if (slot)
         {
+            // The GUI may read the published active slots. Release them
+            // before the slot is deleted.
+            if (activeSlots.contains(slot))
+            {
+                releaseActiveSlots();
+            }
+
             delete slot;
             slot = 0;
         }
 
+        buildDistanceZones();
         tempAssignLocker.unlock();
 
         buildActiveZoneSummaryString();
@@ -3796,12 +4044,9 @@ void JoyButton::clearSlotsEventReset(bool clearSignalEmit)
     createDeskTimer.stop();
     releaseDeskTimer.stop();
     holdTimer.stop();
-    mouseWheelVerticalEventTimer.stop();
-    mouseWheelHorizontalEventTimer.stop();
     setChangeTimer.stop();
     keyPressTimer.stop();
     delayTimer.stop();
-    activeZoneTimer.stop();
 #ifdef Q_OS_WIN
     repeatHelper.getRepeatTimer()->stop();
 #endif
@@ -3820,6 +4065,8 @@ void JoyButton::clearSlotsEventReset(bool clearSignalEmit)
     mouseEventQueue.clear();
     mouseWheelVerticalEventQueue.clear();
     mouseWheelHorizontalEventQueue.clear();
+    wheelImpulses.clear();
+    pendingWheelButtons.removeAll(this);
 
     currentCycle = 0;
     previousCycle = 0;
@@ -3829,15 +4076,13 @@ void JoyButton::clearSlotsEventReset(bool clearSignalEmit)
     currentRawValue = 0;
     currentMouseEvent = 0;
     currentRelease = 0;
-    currentWheelVerticalEvent = 0;
-    currentWheelHorizontalEvent = 0;
     currentKeyPress = 0;
     currentDelay = 0;
 
     isKeyPressed = isButtonPressed = false;
 
     //buildActiveZoneSummaryString();
-    activeZoneTimer.start();
+    publishActiveZone();
     quitEvent = true;
 }
 
@@ -3850,12 +4095,9 @@ void JoyButton::eventReset()
     createDeskTimer.stop();
     releaseDeskTimer.stop();
     holdTimer.stop();
-    mouseWheelVerticalEventTimer.stop();
-    mouseWheelHorizontalEventTimer.stop();
     setChangeTimer.stop();
     keyPressTimer.stop();
     delayTimer.stop();
-    activeZoneTimer.stop();
 #ifdef Q_OS_WIN
     repeatHelper.getRepeatTimer()->stop();
 #endif
@@ -3871,6 +4113,8 @@ void JoyButton::eventReset()
     mouseEventQueue.clear();
     mouseWheelVerticalEventQueue.clear();
     mouseWheelHorizontalEventQueue.clear();
+    wheelImpulses.clear();
+    pendingWheelButtons.removeAll(this);
 
     currentCycle = 0;
     previousCycle = 0;
@@ -3880,8 +4124,6 @@ void JoyButton::eventReset()
     currentRawValue = 0;
     currentMouseEvent = 0;
     currentRelease = 0;
-    currentWheelVerticalEvent = 0;
-    currentWheelHorizontalEvent = 0;
     currentKeyPress = 0;
     currentDelay = 0;
 
@@ -3896,8 +4138,6 @@ void JoyButton::releaseActiveSlots()
 {
     if (!activeSlots.isEmpty())
     {
-        QWriteLocker tempLocker(&activeZoneLock);
-
         bool changeRepeatState = false;
         QListIterator<JoyButtonSlot*> iter(activeSlots);
 
@@ -3910,17 +4150,12 @@ void JoyButton::releaseActiveSlots()
 
             if (mode == JoyButtonSlot::JoyKeyboard)
             {
-                int referencecount = activeKeys.value(tempcode, 1) - 1;
+                int referencecount = activeKeys.release(tempcode);
                 if (referencecount <= 0)
                 {
                     sendevent(slot, false);
-                    activeKeys.remove(tempcode);
                     changeRepeatState = true;
                 }
-                else
-                {
-                    activeKeys.insert(tempcode, referencecount);
-                }
 
                 if (lastActiveKey == slot && referencecount <= 0)
                 {
@@ -3934,15 +4169,10 @@ void JoyButton::releaseActiveSlots()
                     tempcode != JoyButtonSlot::MouseWheelLeft &&
                     tempcode != JoyButtonSlot::MouseWheelRight)
                 {
-                    int referencecount = activeMouseButtons.value(tempcode, 1) - 1;
+                    int referencecount = activeMouseButtons.release(tempcode);
                     if (referencecount <= 0)
                     {
                         sendevent(slot, false);
-                        activeMouseButtons.remove(tempcode);
-                    }
-                    else
-                    {
-                        activeMouseButtons.insert(tempcode, referencecount);
                     }
                 }
                 else if (tempcode == JoyButtonSlot::MouseWheelUp ||
@@ -4133,24 +4363,11 @@ void JoyButton::releaseActiveSlots()
         }
 
         pendingMouseButtons.removeAll(this);
-        currentWheelVerticalEvent = 0;
-        currentWheelHorizontalEvent = 0;
-        mouseWheelVerticalEventTimer.stop();
-        mouseWheelHorizontalEventTimer.stop();
-
-        if (!mouseWheelVerticalEventQueue.isEmpty())
-        {
-            mouseWheelVerticalEventQueue.clear();
-            lastWheelVerticalDistance = getMouseDistanceFromDeadZone();
-            wheelVerticalTime.restart();
-        }
 
-        if (!mouseWheelHorizontalEventQueue.isEmpty())
-        {
-            mouseWheelHorizontalEventQueue.clear();
-            lastWheelHorizontalDistance = getMouseDistanceFromDeadZone();
-            wheelHorizontalTime.restart();
-        }
+        // Button stays in the pending wheel list until the next mouse
+        // tick so a short tap still scrolls a full detent.
+        mouseWheelVerticalEventQueue.clear();
+        mouseWheelHorizontalEventQueue.clear();
 
         // Check if mouse remainder should be zero.
         // Only need to check one list from cursor speeds and spring speeds
@@ -4164,7 +4381,7 @@ void JoyButton::releaseActiveSlots()
         }
 
         //emit activeZoneChanged();
-        activeZoneTimer.start();
+        publishActiveZone();
 
 #ifdef Q_OS_WIN
         BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
@@ -4590,14 +4807,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
     movedY = 0;
     double finalx = 0.0;
     double finaly = 0.0;
-    //int elapsedTime = lastMouseTime.elapsed();
-    int elapsedTime = testOldMouseTime.elapsed();
-    movedElapsed = elapsedTime;
-    if (staticMouseEventTimer.interval() < mouseRefreshRate)
-    {
-        elapsedTime = mouseRefreshRate + (elapsedTime - staticMouseEventTimer.interval());
-        movedElapsed = elapsedTime;
-    }
+    movedElapsed = static_cast<int>(getMouseTickElapsed() / 1000000);
 
     if (mouseHistoryX.size() >= mouseHistorySize)
     {
@@ -4639,34 +4849,10 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
             infoY.slot->getMouseInterval()->restart();
         }
 
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderX >= 0) == (finalx >= 0))
-        {
-            finalx += cursorRemainderX;
-        }
-
-        // Cap maximum relative mouse movement.
-        if (abs(finalx) > 127)
-        {
-            finalx = (finalx < 0) ? -127 : 127;
-        }
-
+        finalx = JoyMouseMotion::carryRemainder(finalx, cursorRemainderX);
         mouseHistoryX.prepend(finalx);
 
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderY >= 0) == (finaly >= 0))
-        {
-            finaly += cursorRemainderY;
-        }
-
-        // Cap maximum relative mouse movement.
-        if (abs(finaly) > 127)
-        {
-            finaly = (finaly < 0) ? -127 : 127;
-        }
-
+        finaly = JoyMouseMotion::carryRemainder(finaly, cursorRemainderY);
         mouseHistoryY.prepend(finaly);
 
         cursorRemainderX = 0;
@@ -4691,22 +4877,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
         if (fabs(adjustedX) > 0)
         {
             adjustedX = adjustedX / static_cast<double>(finalWeight);
-
-            if (adjustedX > 0)
-            {
-                double oldX = adjustedX;
-                adjustedX = static_cast<int>(floor(adjustedX));
-                //adjustedX = (int)floor(adjustedX + 0.5); // Old rounding behavior
-                cursorRemainderX = oldX - adjustedX;
-            }
-            else
-            {
-                double oldX = adjustedX;
-                adjustedX = static_cast<int>(ceil(adjustedX));
-                //adjustedX = (int)ceil(adjustedX - 0.5); // Old rounding behavior
-                cursorRemainderX = oldX - adjustedX;
-            }
-
+            adjustedX = JoyMouseMotion::takeWholePixels(adjustedX, cursorRemainderX);
         }
 
         QListIterator<double> iterY(mouseHistoryY);
@@ -4724,20 +4895,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
         if (fabs(adjustedY) > 0)
         {
             adjustedY = adjustedY / static_cast<double>(finalWeight);
-            if (adjustedY > 0)
-            {
-                double oldY = adjustedY;
-                adjustedY = static_cast<int>(floor(adjustedY));
-                //adjustedY = (int)floor(adjustedY + 0.5); // Old rounding behavior
-                cursorRemainderY = oldY - adjustedY;
-            }
-            else
-            {
-                double oldY = adjustedY;
-                adjustedY = static_cast<int>(ceil(adjustedY));
-                //adjustedY = (int)ceil(adjustedY - 0.5); // Old rounding behavior
-                cursorRemainderY = oldY - adjustedY;
-            }
+            adjustedY = JoyMouseMotion::takeWholePixels(adjustedY, cursorRemainderY);
         }
 
         // This check is more of a precaution than anything. No need to cause
@@ -4764,7 +4922,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
     //lastMouseTime.restart();
 
     // Check if mouse event timer should use idle time.
-    if (pendingMouseButtons.length() == 0)
+    if (pendingMouseButtons.length() == 0 && pendingWheelButtons.length() == 0)
     {
         if (staticMouseEventTimer.interval() != IDLEMOUSEREFRESHRATE)
         {
@@ -4792,6 +4950,12 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
             // Restore intended QTimer interval.
             staticMouseEventTimer.start(mouseRefreshRate);
         }
+
+        if (pendingMouseButtons.length() == 0)
+        {
+            cursorRemainderX = 0;
+            cursorRemainderY = 0;
+        }
     }
 
 
@@ -4950,7 +5114,7 @@ void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved)
     //lastMouseTime.restart();
 
     // Check if mouse event timer should use idle time.
-    if (pendingMouseButtons.length() == 0)
+    if (pendingMouseButtons.length() == 0 && pendingWheelButtons.length() == 0)
     {
         staticMouseEventTimer.start(IDLEMOUSEREFRESHRATE);
     }
@@ -5196,6 +5360,7 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->eventReset();
     destButton->assignmentsLock.lockForWrite();
     destButton->assignments.clear();
+    destButton->buildDistanceZones();
     destButton->assignmentsLock.unlock();
 
     assignmentsLock.lockForWrite();
@@ -5325,6 +5490,11 @@ QList<JoyButton*>* JoyButton::getPendingMouseButtons()
     return &pendingMouseButtons;
 }
 
+QList<JoyButton*>* JoyButton::getPendingWheelButtons()
+{
+    return &pendingWheelButtons;
+}
+
 bool JoyButton::hasCursorEvents()
 {
     return (cursorXSpeeds.length() != 0) || (cursorYSpeeds.length() != 0);
@@ -5403,7 +5573,8 @@ void JoyButton::setMouseRefreshRate(int refresh)
 
         if (staticMouseEventTimer.isActive())
         {
-            testOldMouseTime.restart();
+            lastMouseTickTime = currentMouseTime();
+            mouseTickTime = -1;
             //lastMouseTime.restart();
             int tempInterval = staticMouseEventTimer.interval();
 
@@ -5487,8 +5658,6 @@ void JoyButton::resetProperties()
     currentRawValue = 0;
     currentMouseEvent = 0;
     currentRelease = 0;
-    currentWheelVerticalEvent = 0;
-    currentWheelHorizontalEvent = 0;
     currentKeyPress = 0;
     currentDelay = 0;
     currentSetChangeSlot = 0;
@@ -5521,23 +5690,20 @@ void JoyButton::resetProperties()
     cycleResetInterval = 0;
     relativeSpring = false;
     lastDistance = 0.0;
-    currentAccelMulti = 0.0;
+    JoyExtraAcceleration::resetState(accelState, JoyExtraAcceleration::currentTime());
     lastAccelerationDistance = 0.0;
     lastMouseDistance = 0.0;
     currentMouseDistance = 0.0;
     updateLastMouseDistance = false;
     updateStartingMouseDistance = false;
-    updateOldAccelMulti = 0.0;
     updateInitAccelValues = true;
 
     currentAccelerationDistance = 0.0;
+    currentDistanceTime = accelState.lastDistanceTime;
     startingAccelerationDistance = 0.0;
-    lastWheelVerticalDistance = 0.0;
-    lastWheelHorizontalDistance = 0.0;
-    tempTurboInterval = 0;
+    turboDeadline = 0;
+    turboPressCount = 0;
     //currentTurboMode = GradientTurbo;
-    oldAccelMulti = 0.0;
-    accelTravel = 0.0;
     currentTurboMode = DEFAULTTURBOMODE;
     easingDuration = DEFAULTEASINGDURATION;
     springDeadCircleMultiplier = DEFAULTSPRINGRELEASERADIUS;
@@ -5557,6 +5723,8 @@ void JoyButton::resetProperties()
     activeZoneStringLock.lockForWrite();
     activeZoneString = tr("[NO KEY]");
     activeZoneStringLock.unlock();
+
+    localBuildActiveZoneSummaryString();
 }
 
 bool JoyButton::isModifierButton()
@@ -5569,12 +5737,41 @@ void JoyButton::resetActiveButtonMouseDistances()
     mouseHelper.resetButtonMouseDistances();
 }
 
+/**
+ * @brief Send release events for any keys and mouse buttons that are
+ *     still referenced and clear the reference tables. Should only be
+ *     called once no button can still hold an output.
+ */
+void JoyButton::releaseAllActiveKeys()
+{
+    QList<ActiveKeyTable::ActiveKeyEntry> heldKeys = activeKeys.takeAll();
+    QListIterator<ActiveKeyTable::ActiveKeyEntry> keyIter(heldKeys);
+    while (keyIter.hasNext())
+    {
+        ActiveKeyTable::ActiveKeyEntry entry = keyIter.next();
+        JoyButtonSlot tempSlot(entry.code, entry.alias, JoyButtonSlot::JoyKeyboard);
+        sendevent(&tempSlot, false);
+    }
+
+    QList<ActiveKeyTable::ActiveKeyEntry> heldButtons = activeMouseButtons.takeAll();
+    QListIterator<ActiveKeyTable::ActiveKeyEntry> buttonIter(heldButtons);
+    while (buttonIter.hasNext())
+    {
+        ActiveKeyTable::ActiveKeyEntry entry = buttonIter.next();
+        JoyButtonSlot tempSlot(entry.code, entry.alias, JoyButtonSlot::JoyMouseButton);
+        sendevent(&tempSlot, false);
+    }
+
+    lastActiveKey = 0;
+}
+
 void JoyButton::resetAccelerationDistances()
 {
     if (updateLastMouseDistance)
     {
         lastAccelerationDistance = currentAccelerationDistance;
         lastMouseDistance = currentMouseDistance;
+        accelState.lastDistanceTime = currentDistanceTime;
         updateLastMouseDistance = false;
     }
 
@@ -5584,14 +5781,11 @@ void JoyButton::resetAccelerationDistances()
         updateStartingMouseDistance = false;
     }
 
-    if (updateOldAccelMulti >= 0.0)
-    {
-        oldAccelMulti = updateOldAccelMulti;
-        updateOldAccelMulti = 0.0;
-    }
+    JoyExtraAcceleration::advancePoll(accelState);
 
     currentAccelerationDistance = getAccelerationDistance();
     currentMouseDistance = getMouseDistanceFromDeadZone();
+    currentDistanceTime = JoyExtraAcceleration::currentTime();
 }
 
 void JoyButton::initializeDistanceValues()
@@ -5599,6 +5793,7 @@ void JoyButton::initializeDistanceValues()
     lastAccelerationDistance = getLastAccelerationDistance();
     currentAccelerationDistance = getAccelerationDistance();
     startingAccelerationDistance = lastAccelerationDistance;
+    currentDistanceTime = JoyExtraAcceleration::currentTime();
 
     lastMouseDistance = getLastMouseDistanceFromDeadZone();
     currentMouseDistance = getMouseDistanceFromDeadZone();
@@ -5622,6 +5817,7 @@ void JoyButton::copyLastMouseDistanceFromDeadZone(JoyButton *srcButton)
 void JoyButton::copyLastAccelerationDistance(JoyButton *srcButton)
 {
     this->lastAccelerationDistance = srcButton->lastAccelerationDistance;
+    this->accelState.lastDistanceTime = srcButton->accelState.lastDistanceTime;
 }
 
 bool JoyButton::isExtraAccelerationEnabled()
@@ -5761,10 +5957,40 @@ double JoyButton::getCurrentSpringDeadCircle()
     return (springDeadCircleMultiplier * 0.01);
 }
 
+/**
+ * @brief End the current mouse tick. The next tick integrates movement from
+ *     the time sampled for this tick so no time is lost between ticks.
+ */
 void JoyButton::restartLastMouseTime()
 {
-    testOldMouseTime.restart();
-    //lastMouseTime.restart();
+    lastMouseTickTime = (mouseTickTime >= 0) ? mouseTickTime : currentMouseTime();
+    mouseTickTime = -1;
+}
+
+/**
+ * @brief Get the time between the previous mouse tick and the current one.
+ *     The current time is sampled once per tick so every button sees the
+ *     same value.
+ * @return Elapsed time in ns
+ */
+qint64 JoyButton::getMouseTickElapsed()
+{
+    if (mouseTickTime < 0)
+    {
+        mouseTickTime = currentMouseTime();
+    }
+
+    return qMax(mouseTickTime - lastMouseTickTime, static_cast<qint64>(0));
+}
+
+qint64 JoyButton::currentMouseTime()
+{
+    if (!mouseClock.isValid())
+    {
+        mouseClock.start();
+    }
+
+    return mouseClock.nsecsElapsed();
 }
 
 void JoyButton::setStaticMouseThread(QThread *thread)
@@ -5782,7 +6008,8 @@ void JoyButton::setStaticMouseThread(QThread *thread)
                               Q_ARG(int, oldInterval));
 
     //lastMouseTime.start();
-    testOldMouseTime.start();
+    lastMouseTickTime = currentMouseTime();
+    mouseTickTime = -1;
 
 #ifdef Q_OS_WIN
     repeatHelper.moveToThread(thread);
@@ -5803,7 +6030,8 @@ bool JoyButton::shouldInvokeMouseEvents()
 {
     bool result = false;
 
-    if (pendingMouseButtons.size() > 0 && staticMouseEventTimer.isActive())
+    if ((pendingMouseButtons.size() > 0 || pendingWheelButtons.size() > 0) &&
+        staticMouseEventTimer.isActive())
     {
         int timerInterval = staticMouseEventTimer.interval();
         if (timerInterval == 0)
@@ -5812,7 +6040,7 @@ bool JoyButton::shouldInvokeMouseEvents()
         }
         //else if (lastMouseTime.elapsed() >= timerInterval)
         //else if (lastMouseTime.hasExpired(timerInterval))
-        else if (testOldMouseTime.elapsed() >= timerInterval)
+        else if (currentMouseTime() - lastMouseTickTime >= timerInterval * static_cast<qint64>(1000000))
         {
             result = true;
         }
@@ -5844,20 +6072,12 @@ JoyButton::JoyExtraAccelerationCurve JoyButton::getExtraAccelerationCurve()
 
 void JoyButton::copyExtraAccelerationState(JoyButton *srcButton)
 {
-    this->currentAccelMulti = srcButton->currentAccelMulti;
-    this->oldAccelMulti = srcButton->oldAccelMulti;
-    this->accelTravel = srcButton->accelTravel;
+    this->accelState = srcButton->accelState;
 
     this->startingAccelerationDistance = srcButton->startingAccelerationDistance;
     this->lastAccelerationDistance = srcButton->lastAccelerationDistance;
     this->lastMouseDistance = srcButton->lastMouseDistance;
 
-    this->accelExtraDurationTime.setHMS(srcButton->accelExtraDurationTime.hour(),
-                                        srcButton->accelExtraDurationTime.minute(),
-                                        srcButton->accelExtraDurationTime.second(),
-                                        srcButton->accelExtraDurationTime.msec());
-
-    this->updateOldAccelMulti = srcButton->updateOldAccelMulti;
     this->updateStartingMouseDistance = srcButton->updateStartingMouseDistance;
     this->updateLastMouseDistance = srcButton->lastMouseDistance;
 }
@@ -26,13 +26,17 @@
 #include <QListIterator>
 #include <QHash>
 #include <QQueue>
+#include <QVector>
 #include <QReadWriteLock>
+#include <QAtomicInt>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 #include "joybuttonslot.h"
 #include "springmousemoveinfo.h"
 #include "joybuttonmousehelper.h"
+#include "activekeytable.h"
+#include "joyextraacceleration.h"
 
 #ifdef Q_OS_WIN
   #include "joykeyrepeathelper.h"
@@ -72,6 +76,7 @@ public:
     bool getToggleState();
     int getTurboInterval();
     bool isUsingTurbo();
+    double getAchievedTurboRate();
     void setCustomName(QString name);
     QString getCustomName();
 
@@ -83,9 +88,18 @@ public:
     virtual QString getPartialName(bool forceFullFormat=false, bool displayNames=false);
     virtual QString getSlotsSummary();
     virtual QString getSlotsString();
-    virtual QList<JoyButtonSlot*> getActiveZoneList();
+    // Copy of the slot data used for an active zone summary. The GUI keeps
+    // these instead of pointers to slots that the input thread may delete.
+    typedef struct _ActiveZoneSlotInfo
+    {
+        JoyButtonSlot::JoySlotInputAction mode;
+        QString label;
+    } ActiveZoneSlotInfo;
+
+    virtual QList<ActiveZoneSlotInfo> getActiveZoneList();
     virtual QString getActiveZoneSummary();
     virtual QString getCalculatedActiveZoneSummary();
+    int getActiveZoneVersion();
     virtual QString getName(bool forceFullFormat=false, bool displayNames=false);
     virtual QString getXmlName();
 
@@ -172,9 +186,11 @@ public:
 
     static void moveMouseCursor(int &movedX, int &movedY, int &movedElapsed);
     static void moveSpringMouse(int &movedX, int &movedY, bool &hasMoved);
+    static void moveMouseWheel();
 
     static JoyButtonMouseHelper* getMouseHelper();
     static QList<JoyButton*>* getPendingMouseButtons();
+    static QList<JoyButton*>* getPendingWheelButtons();
     static bool hasCursorEvents();
     static bool hasSpringEvents();
 
@@ -191,6 +207,7 @@ public:
     static void setSpringModeScreen(int screen);
 
     static void resetActiveButtonMouseDistances();
+    static void releaseAllActiveKeys();
     void resetAccelerationDistances();
 
     void setExtraAccelerationStatus(bool status);
@@ -226,6 +243,7 @@ public:
     static void setGamepadRefreshRate(int refresh);
 
     static void restartLastMouseTime();
+    static qint64 getMouseTickElapsed();
 
     static void setStaticMouseThread(QThread *thread);
     static void indirectStaticMouseThread(QThread *thread);
@@ -283,6 +301,7 @@ public:
     static const JoyExtraAccelerationCurve DEFAULTEXTRAACCELCURVE;
 
     static const int DEFAULTSPRINGRELEASERADIUS;
+    static const double DISTANCEZONEHYSTERESIS;
 
     static QList<double> mouseHistoryX;
     static QList<double> mouseHistoryY;
@@ -290,9 +309,24 @@ public:
     static double cursorRemainderX;
     static double cursorRemainderY;
 
+    static double wheelRemainderX;
+    static double wheelRemainderY;
+
 protected:
     double getTotalSlotDistance(JoyButtonSlot *slot);
     bool distanceEvent();
+
+    typedef struct _DistanceZoneSegment
+    {
+        // Cycle slot that starts the segment. 0 for the first segment.
+        JoyButtonSlot *cycleSlot;
+        // Distance where each zone starts. Sorted in ascending order.
+        QVector<double> thresholds;
+        QVector<JoyButtonSlot*> zoneSlots;
+    } DistanceZoneSegment;
+
+    void buildDistanceZones();
+    int findDistanceZone(const DistanceZoneSegment &segment, double distance);
     void clearAssignedSlots(bool signalEmit=true);
     void releaseSlotEvent();
     void findReleaseEventEnd();
@@ -303,12 +337,18 @@ protected:
     bool insertAssignedSlot(JoyButtonSlot *newSlot, bool updateActiveString=true);
     unsigned int getPreferredKeyPressTime();
     void checkTurboCondition(JoyButtonSlot *slot);
+    void startTurboSchedule();
+    void scheduleTurboEvent(int duration);
+    void turboPressEvent();
+    void turboReleaseEvent();
     static bool hasFutureSpringEvents();
     virtual double getCurrentSpringDeadCircle();
     void vdpadPassEvent(bool pressed, bool ignoresets=false);
 
-    QString buildActiveZoneSummary(QList<JoyButtonSlot*> &tempList);
+    QString buildActiveZoneSummary(QList<ActiveZoneSlotInfo> &tempList);
     void localBuildActiveZoneSummaryString();
+    void publishActiveZone();
+    int readActiveZoneSnapshot(JoyButtonSlot **slots);
 
     virtual bool readButtonConfig(QXmlStreamReader *xml);
 
@@ -318,6 +358,12 @@ protected:
         double code;
     } mouseCursorInfo;
 
+    void queueWheelSlot(JoyButtonSlot *slot);
+    static int takeWheelScroll(QList<mouseCursorInfo> &speeds, double &remainder,
+                               bool highResolution, JoyButtonSlot *&clickSlot);
+    static bool isVerticalWheelSlot(JoyButtonSlot *slot);
+    static bool isPositiveWheelSlot(JoyButtonSlot *slot);
+
     // Used to denote whether the actual joypad button is pressed
     bool isButtonPressed;
     // Used to denote whether the virtual key is pressed
@@ -334,8 +380,6 @@ protected:
     QTimer pauseWaitTimer;
     QTimer createDeskTimer;
     QTimer releaseDeskTimer;
-    QTimer mouseWheelVerticalEventTimer;
-    QTimer mouseWheelHorizontalEventTimer;
     QTimer setChangeTimer;
     QTimer keyPressTimer;
     QTimer delayTimer;
@@ -366,8 +410,6 @@ protected:
     JoyButtonSlot *currentDistance;
     JoyButtonSlot *currentMouseEvent;
     JoyButtonSlot *currentRelease;
-    JoyButtonSlot *currentWheelVerticalEvent;
-    JoyButtonSlot *currentWheelHorizontalEvent;
     JoyButtonSlot *currentKeyPress;
     JoyButtonSlot *currentDelay;
     JoyButtonSlot *currentSetChangeSlot;
@@ -379,11 +421,15 @@ protected:
     QTime buttonHeldRelease;
     QTime keyPressHold;
     QTime buttonDelay;
-    QTime turboHold;
-    QTime wheelVerticalTime;
-    QTime wheelHorizontalTime;
+    // Monotonic clock used for turbo deadlines. Started with each turbo run.
+    QElapsedTimer turboEpoch;
     //static QElapsedTimer lastMouseTime;
-    static QTime testOldMouseTime;
+    // Monotonic clock used to integrate cursor movement. Times are in ns.
+    static QElapsedTimer mouseClock;
+    static qint64 lastMouseTickTime;
+    // Time sampled for the current mouse tick. -1 when not sampled yet.
+    static qint64 mouseTickTime;
+    static qint64 currentMouseTime();
 
     QQueue<bool> ignoreSetQueue;
     QQueue<bool> isButtonPressedQueue;
@@ -391,6 +437,9 @@ protected:
     QQueue<JoyButtonSlot*> mouseEventQueue;
     QQueue<JoyButtonSlot*> mouseWheelVerticalEventQueue;
     QQueue<JoyButtonSlot*> mouseWheelHorizontalEventQueue;
+    // Full detent scrolled by each wheel slot activated since the
+    // previous mouse tick.
+    QList<mouseCursorInfo> wheelImpulses;
 
     int currentRawValue;
     VDPad *vdpad;
@@ -404,9 +453,9 @@ protected:
     bool smoothing;
     bool whileHeldStatus;
     double lastDistance;
-    double lastWheelVerticalDistance;
-    double lastWheelHorizontalDistance;
-    int tempTurboInterval;
+    // Time of the most recent turbo transition relative to turboEpoch.
+    qint64 turboDeadline;
+    int turboPressCount;
 
     // Keep track of the previous mouse distance from the previous gamepad
     // poll.
@@ -417,11 +466,8 @@ protected:
     double lastAccelerationDistance;
 
     // Multiplier and time used for acceleration easing.
-    double currentAccelMulti;
-    QTime accelExtraDurationTime;
+    JoyExtraAcceleration::State accelState;
     double accelDuration;
-    double oldAccelMulti;
-    double accelTravel; // Track travel when accel started
 
     // Should lastMouseDistance be updated. Set after mouse event.
     bool updateLastMouseDistance;
@@ -430,8 +476,6 @@ protected:
     // has finally been applied.
     bool updateStartingMouseDistance;
 
-    double updateOldAccelMulti;
-
     bool updateInitAccelValues;
 
     // Keep track of the current mouse distance after a poll. Used
@@ -441,6 +485,8 @@ protected:
     // Keep track of the current mouse distance after a poll. Used
     // to update lastMouseDistance later.
     double currentAccelerationDistance;
+    // Monotonic time in ns when currentAccelerationDistance was sampled.
+    qint64 currentDistanceTime;
 
     // Take into account when mouse acceleration started
     double startingAccelerationDistance;
@@ -475,12 +521,27 @@ protected:
     bool pendingEvent;
     bool pendingIgnoreSets;
 
-    QReadWriteLock activeZoneLock;
     QReadWriteLock assignmentsLock;
+
+    // Distance zones compiled from the assigned slots. Rebuilt whenever
+    // the assignments change. Protected by assignmentsLock.
+    QList<DistanceZoneSegment> distanceZoneSegments;
+    bool hasDistanceZones;
+    int currentDistanceZone;
     QReadWriteLock activeZoneStringLock;
 
     QString activeZoneString;
-    QTimer activeZoneTimer;
+    int activeZoneStringVersion;
+
+    // Copy of the first active slots published by the input thread.
+    // Protected by activeZoneSequence which is odd while the copy is
+    // being written.
+    static const int MAXACTIVEZONESLOTS = 8;
+    JoyButtonSlot *activeZoneSlots[MAXACTIVEZONESLOTS];
+    int activeZoneSlotCount;
+    QAtomicInt activeZoneSequence;
+    // Changed when button settings that affect the summary are changed.
+    QAtomicInt activeZoneConfigVersion;
 
     static double mouseSpeedModifier;
     static QList<JoyButtonSlot*> mouseSpeedModList;
@@ -493,8 +554,13 @@ protected:
 
     static QList<JoyButton*> pendingMouseButtons;
 
-    static QHash<unsigned int, int> activeKeys;
-    static QHash<unsigned int, int> activeMouseButtons;
+    // Scroll queued by every button during the current mouse tick.
+    static QList<mouseCursorInfo> wheelXSpeeds;
+    static QList<mouseCursorInfo> wheelYSpeeds;
+    static QList<JoyButton*> pendingWheelButtons;
+
+    static ActiveKeyTable activeKeys;
+    static ActiveKeyTable activeMouseButtons;
 #ifdef Q_OS_WIN
     static JoyKeyRepeatHelper repeatHelper;
 #endif
@@ -573,11 +639,10 @@ public slots:
     void disconnectPropertyUpdatedConnections();
 
     virtual void mouseEvent();
+    void wheelEvent();
 
 protected slots:
     virtual void turboEvent();
-    virtual void wheelEventVertical();
-    virtual void wheelEventHorizontal();
     void createDeskEvent();
     void releaseDeskEvent(bool skipsetchange=false);
     void buildActiveZoneSummaryString();
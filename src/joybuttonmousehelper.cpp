@@ -73,6 +73,16 @@ void JoyButtonMouseHelper::mouseEvent()
         }
     }
 
+    QList<JoyButton*> *wheelList = JoyButton::getPendingWheelButtons();
+    QListIterator<JoyButton*> iterWheel(*wheelList);
+    while (iterWheel.hasNext())
+    {
+        JoyButton *temp = iterWheel.next();
+        temp->wheelEvent();
+    }
+
+    JoyButton::moveMouseWheel();
+
     moveMouseCursor();
 
     if (JoyButton::hasSpringEvents())
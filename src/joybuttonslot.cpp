@@ -89,7 +89,9 @@ JoyButtonSlot::JoyButtonSlot(JoyButtonSlot *slot, QObject *parent) :
     distance = slot->distance;
     easingActive = false;
     textData = slot->getTextData();
+    textEntryEvents = slot->textEntryEvents;
     extraData = slot->getExtraData();
+    executeArguments = slot->executeArguments;
 }
 
 JoyButtonSlot::JoyButtonSlot(QString text, JoySlotInputAction mode, QObject *parent) :
@@ -145,6 +147,7 @@ int JoyButtonSlot::getSlotCode()
 void JoyButtonSlot::setSlotMode(JoySlotInputAction selectedMode)
 {
     mode = selectedMode;
+    textEntryEvents.clear();
 }
 
 JoyButtonSlot::JoySlotInputAction JoyButtonSlot::getSlotMode()
@@ -331,6 +334,10 @@ void JoyButtonSlot::readConfig(QXmlStreamReader *xml)
                 unsigned int temp = this->getSlotCode() - QtKeyMapperBase::nativeKeyPrefix;
                 this->setSlotCode(temp);
             }
+
+            // Resolve the output code now so the event handler does not
+            // have to do any lookups when the key is pressed.
+            resolveSlotOutputCode(this);
         }
         else if (this->getSlotMode() == JoyButtonSlot::JoyLoadProfile && !profile.isEmpty())
         {
@@ -354,6 +361,7 @@ void JoyButtonSlot::readConfig(QXmlStreamReader *xml)
         else if (this->getSlotMode() == JoyTextEntry && !tempStringData.isEmpty())
         {
             this->setTextData(tempStringData);
+            resolveSlotOutputCode(this);
         }
         else if (this->getSlotMode() == JoyExecute && !tempStringData.isEmpty())
         {
@@ -719,7 +727,7 @@ void JoyButtonSlot::setEasingStatus(bool isActive)
     easingActive = isActive;
 }
 
-QTime* JoyButtonSlot::getEasingTime()
+QElapsedTimer* JoyButtonSlot::getEasingTime()
 {
     return &easingTime;
 }
@@ -727,6 +735,7 @@ QTime* JoyButtonSlot::getEasingTime()
 void JoyButtonSlot::setTextData(QString textData)
 {
     this->textData = textData;
+    textEntryEvents.clear();
 }
 
 QString JoyButtonSlot::getTextData()
@@ -734,9 +743,32 @@ QString JoyButtonSlot::getTextData()
     return textData;
 }
 
+/**
+ * @brief Store the key events compiled by the active event handler for
+ *     the text of a text entry slot.
+ * @param Compiled key events
+ */
+void JoyButtonSlot::setTextEntryEvents(QVector<int> events)
+{
+    textEntryEvents = events;
+}
+
+QVector<int> JoyButtonSlot::getTextEntryEvents()
+{
+    return textEntryEvents;
+}
+
 void JoyButtonSlot::setExtraData(QVariant data)
 {
     this->extraData = data;
+
+    // Parse arguments now so an execute slot does not have to parse
+    // them every time it is activated.
+    executeArguments.clear();
+    if (!data.isNull() && data.canConvert<QString>())
+    {
+        executeArguments = PadderCommon::parseArgumentsString(data.toString());
+    }
 }
 
 QVariant JoyButtonSlot::getExtraData()
@@ -744,6 +776,16 @@ QVariant JoyButtonSlot::getExtraData()
     return extraData;
 }
 
+/**
+ * @brief Get the arguments used for an execute slot. The arguments are
+ *     parsed from the extra data when it is set.
+ * @return List of arguments
+ */
+QStringList JoyButtonSlot::getExecuteArguments()
+{
+    return executeArguments;
+}
+
 bool JoyButtonSlot::isValidSlot()
 {
     bool result = true;
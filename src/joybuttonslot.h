@@ -25,6 +25,8 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QVariant>
+#include <QVector>
+#include <QStringList>
 
 class JoyButtonSlot : public QObject
 {
@@ -66,13 +68,17 @@ public:
 
     bool isEasingActive();
     void setEasingStatus(bool isActive);
-    QTime* getEasingTime();
+    QElapsedTimer* getEasingTime();
 
     void setTextData(QString textData);
     QString getTextData();
 
+    void setTextEntryEvents(QVector<int> events);
+    QVector<int> getTextEntryEvents();
+
     void setExtraData(QVariant data);
     QVariant getExtraData();
+    QStringList getExecuteArguments();
 
     bool isValidSlot();
 
@@ -89,10 +95,12 @@ protected:
     double distance;
     double previousDistance;
     QElapsedTimer mouseInterval;
-    QTime easingTime;
+    QElapsedTimer easingTime;
     bool easingActive;
     QString textData;
+    QVector<int> textEntryEvents;
     QVariant extraData;
+    QStringList executeArguments;
 
     static const int MAXTEXTENTRYDISPLAYLENGTH;
 
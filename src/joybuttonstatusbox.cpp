@@ -18,6 +18,7 @@
 #include <QStyle>
 
 #include "joybuttonstatusbox.h"
+#include "inputstatesampler.h"
 
 JoyButtonStatusBox::JoyButtonStatusBox(JoyButton *button, QWidget *parent) :
     QPushButton(parent)
@@ -27,8 +28,12 @@ JoyButtonStatusBox::JoyButtonStatusBox(JoyButton *button, QWidget *parent) :
 
     setText(QString::number(button->getRealJoyNumber()));
 
-    connect(button, SIGNAL(clicked(int)), this, SLOT(flash()));
-    connect(button, SIGNAL(released(int)), this, SLOT(unflash()));
+    InputStateSampler::subscribe(this, SLOT(sampleButtonState()));
+}
+
+JoyButtonStatusBox::~JoyButtonStatusBox()
+{
+    InputStateSampler::unsubscribe(this);
 }
 
 JoyButton* JoyButtonStatusBox::getJoyButton()
@@ -60,3 +65,20 @@ void JoyButtonStatusBox::unflash()
 
     emit flashed(isflashing);
 }
+
+/**
+ * @brief Update the flash state of the box based on the current state
+ *     of the button. Called by the shared sample timer.
+ */
+void JoyButtonStatusBox::sampleButtonState()
+{
+    bool pressed = button->getButtonState();
+    if (pressed && !isflashing)
+    {
+        flash();
+    }
+    else if (!pressed && isflashing)
+    {
+        unflash();
+    }
+}
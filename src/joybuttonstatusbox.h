@@ -29,6 +29,7 @@ class JoyButtonStatusBox : public QPushButton
 
 public:
     explicit JoyButtonStatusBox(JoyButton *button, QWidget *parent = 0);
+    ~JoyButtonStatusBox();
     JoyButton* getJoyButton();
     bool isButtonFlashing();
 
@@ -42,6 +43,7 @@ signals:
 private slots:
     void flash();
     void unflash();
+    void sampleButtonState();
 };
 
 #endif // JOYBUTTONSTATUSBOX_H
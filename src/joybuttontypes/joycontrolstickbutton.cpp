@@ -225,12 +225,12 @@ double JoyControlStickButton::getAccelerationDistance()
  */
 QString JoyControlStickButton::getActiveZoneSummary()
 {
-    QList<JoyButtonSlot*> tempList;
+    QList<ActiveZoneSlotInfo> tempList;
     JoyControlStickModifierButton *tempButton = stick->getModifierButton();
     /*if (tempButton && tempButton->getButtonState() &&
           tempButton->hasActiveSlots() && getButtonState())
     {
-        QList<JoyButtonSlot*> activeModifierSlots = tempButton->getActiveZoneList();
+        QList<ActiveZoneSlotInfo> activeModifierSlots = tempButton->getActiveZoneList();
         tempList.append(activeModifierSlots);
     }
     */
@@ -27,7 +27,11 @@ JoyGradientButton::JoyGradientButton(int index, int originset, SetJoystick *pare
 }
 
 /**
- * @brief Activate a turbo event on a button.
+ * @brief Activate a turbo event on a button. Gradient and pulse turbo
+ *     work like PWM. The length of the current press or release phase is
+ *     computed from the current stick distance every time the timer
+ *     fires. The timer fires at least once per turbo interval so a
+ *     change in distance shortens a long phase without polling.
  */
 void JoyGradientButton::turboEvent()
 {
@@ -37,490 +41,99 @@ void JoyGradientButton::turboEvent()
     }
     else if (currentTurboMode == GradientTurbo || currentTurboMode == PulseTurbo)
     {
-        double diff = fabs(getMouseDistanceFromDeadZone() - lastDistance);
-        //qDebug() << "DIFF: " << QString::number(diff);
+        double distance = getMouseDistanceFromDeadZone();
 
-        bool changeState = false;
-        int checkmate = 0;
-        if (!turboTimer.isActive() && !isButtonPressed)
-        {
-            changeState = true;
-        }
-        else if (currentTurboMode == GradientTurbo && diff > 0 &&
-                 getMouseDistanceFromDeadZone() >= 1.0)
+        if (!turboTimer.isActive())
         {
+            // Turbo is finishing. Only change the key state.
             if (isKeyPressed)
             {
-                changeState = false;
-                if (!turboTimer.isActive() || turboTimer.interval() != 5)
-                {
-                    turboTimer.start(5);
-                }
-
-                turboHold.restart();
-                lastDistance = 1.0;
+                turboReleaseEvent();
             }
             else
             {
-                changeState = true;
+                turboPressEvent();
             }
         }
-
-        else if (turboHold.isNull() || lastDistance == 0.0 || turboHold.elapsed() > tempTurboInterval)
-        {
-            changeState = true;
-        }
-        else if (diff >= 0.1)
-        {
-            int tempInterval2 = 0;
-
-            if (isKeyPressed)
-            {
-                if (currentTurboMode == GradientTurbo)
-                {
-                    tempInterval2 = (int)floor((getMouseDistanceFromDeadZone() * turboInterval) + 0.5);
-                }
-                else
-                {
-                    tempInterval2 = (int)floor((turboInterval * 0.5) + 0.5);
-                }
-            }
-            else
-            {
-                if (currentTurboMode == GradientTurbo)
-                {
-                    tempInterval2 = (int)floor(((1 - getMouseDistanceFromDeadZone()) * turboInterval) + 0.5);
-                }
-                else
-                {
-                    double distance = getMouseDistanceFromDeadZone();
-                    if (distance > 0.0)
-                    {
-                        tempInterval2 = (int)floor(((turboInterval / getMouseDistanceFromDeadZone()) * 0.5) + 0.5);
-                    }
-                    else
-                    {
-                        tempInterval2 = 0;
-                    }
-                }
-            }
-
-            if (turboHold.elapsed() < tempInterval2)
-            {
-                // Still some valid time left. Continue current action with
-                // remaining time left.
-                tempTurboInterval = tempInterval2 - turboHold.elapsed();
-                int timerInterval = qMin(tempTurboInterval, 5);
-                if (!turboTimer.isActive() || turboTimer.interval() != timerInterval)
-                {
-                    turboTimer.start(timerInterval);
-                }
-
-                turboHold.restart();
-                changeState = false;
-                lastDistance = getMouseDistanceFromDeadZone();
-                //qDebug() << "diff tmpTurbo press: " << QString::number(tempTurboInterval);
-                //qDebug() << "diff timer press: " << QString::number(timerInterval);
-            }
-            else
-            {
-                // Elapsed time is greater than new interval. Change state.
-                //if (isKeyPressed)
-                //{
-                //    checkmate = turboHold.elapsed();
-                //}
-                changeState = true;
-                //qDebug() << "YOU GOT CHANGE";
-            }
-        }
-
-        if (changeState)
+        else
         {
-            if (!isKeyPressed)
+            qint64 now = turboEpoch.elapsed();
+            if (turboPressCount == 0 && !isKeyPressed)
             {
-                if (!isButtonPressedQueue.isEmpty())
-                {
-                    ignoreSetQueue.clear();
-                    isButtonPressedQueue.clear();
-
-                    ignoreSetQueue.enqueue(false);
-                    isButtonPressedQueue.enqueue(isButtonPressed);
-                }
-
-                createDeskEvent();
-
-                isKeyPressed = true;
-                if (turboTimer.isActive())
-                {
-                    if (currentTurboMode == GradientTurbo)
-                    {
-                        tempTurboInterval = (int)floor((getMouseDistanceFromDeadZone() * turboInterval) + 0.5);
-                    }
-                    else
-                    {
-                        tempTurboInterval = (int)floor((turboInterval * 0.5) + 0.5);
-                    }
-
-                    int timerInterval = qMin(tempTurboInterval, 5);
-                    //qDebug() << "tmpTurbo press: " << QString::number(tempTurboInterval);
-                    //qDebug() << "timer press: " << QString::number(timerInterval);
-                    if (turboTimer.interval() != timerInterval)
-                    {
-                        turboTimer.start(timerInterval);
-                    }
-
-                    turboHold.restart();
-                }
+                // Always start a turbo run with a press. The distance can
+                // still be close to zero right after leaving the dead zone.
+                turboPressEvent();
+                turboDeadline = now;
             }
             else
             {
-                if (!isButtonPressedQueue.isEmpty())
+                // turboDeadline holds the start of the current phase.
+                qint64 phaseEnd = turboDeadline + getTurboPhaseTime(distance, isKeyPressed);
+                if (now >= phaseEnd)
                 {
-                    ignoreSetQueue.enqueue(false);
-                    isButtonPressedQueue.enqueue(!isButtonPressed);
-                }
-
-                releaseDeskEvent();
-
-                isKeyPressed = false;
-                if (turboTimer.isActive())
-                {
-                    if (currentTurboMode == GradientTurbo)
-                    {
-                        tempTurboInterval = (int)floor(((1 - getMouseDistanceFromDeadZone()) * turboInterval) + 0.5);
-                    }
-                    else
+                    // Start the next phase from the deadline so event loop
+                    // latency does not accumulate. Restart from the current
+                    // time when more than a full cycle behind.
+                    turboDeadline = (now - phaseEnd > turboInterval) ? now : phaseEnd;
+
+                    // An empty phase means a duty cycle of 0 or 1. Stay in
+                    // the current state for another phase in that case.
+                    if (getTurboPhaseTime(distance, !isKeyPressed) > 0)
                     {
-                        double distance = getMouseDistanceFromDeadZone();
-                        if (distance > 0.0)
+                        if (isKeyPressed)
                         {
-                            tempTurboInterval = (int)floor(((turboInterval / getMouseDistanceFromDeadZone()) * 0.5) + 0.5);
+                            turboReleaseEvent();
                         }
                         else
                         {
-                            tempTurboInterval = 0;
+                            turboPressEvent();
                         }
                     }
-
-                    int timerInterval = qMin(tempTurboInterval, 5);
-                    //qDebug() << "tmpTurbo release: " << QString::number(tempTurboInterval);
-                    //qDebug() << "timer release: " << QString::number(timerInterval);
-                    if (turboTimer.interval() != timerInterval)
-                    {
-                        turboTimer.start(timerInterval);
-                    }
-
-                    turboHold.restart();
                 }
-
             }
 
-            lastDistance = getMouseDistanceFromDeadZone();
+            qint64 nextEvent = qMin(turboDeadline + getTurboPhaseTime(distance, isKeyPressed),
+                                    now + turboInterval);
+            turboTimer.start(static_cast<int>(qMax(nextEvent - now, static_cast<qint64>(0))));
         }
 
-        checkmate = 0;
+        lastDistance = distance;
     }
 }
 
-
-void JoyGradientButton::wheelEventVertical()
+/**
+ * @brief Get the length of a gradient or pulse turbo phase.
+ *     Gradient uses a duty cycle equal to the distance. Pulse keeps a
+ *     fixed press time and scales the release time.
+ * @param Distance of the stick from the dead zone
+ * @param Whether the length of the press phase is wanted
+ * @return Phase length in ms
+ */
+int JoyGradientButton::getTurboPhaseTime(double distance, bool pressPhase)
 {
-    JoyButtonSlot *buttonslot = 0;
-    bool activateEvent = false;
+    int result = 0;
+    double tempDistance = qMax(qMin(distance, 1.0), 0.0);
 
-    int tempInterval = 0;
-    double diff = fabs(getMouseDistanceFromDeadZone() - lastWheelVerticalDistance);
-    int oldInterval = 0;
-
-    if (wheelSpeedY != 0)
+    if (currentTurboMode == GradientTurbo)
     {
-        if (lastWheelVerticalDistance > 0.0)
+        if (pressPhase)
         {
-            oldInterval = 1000 / wheelSpeedY / lastWheelVerticalDistance;
+            result = (int)floor((tempDistance * turboInterval) + 0.5);
         }
         else
         {
-            oldInterval = 1000 / wheelSpeedY / 0.01;
+            result = (int)floor(((1.0 - tempDistance) * turboInterval) + 0.5);
         }
     }
-
-    if (currentWheelVerticalEvent)
+    else if (pressPhase || tempDistance <= 0.0)
     {
-        buttonslot = currentWheelVerticalEvent;
-        activateEvent = true;
-    }
-
-    if (!activateEvent)
-    {
-        if (!mouseWheelVerticalEventTimer.isActive())
-        {
-            activateEvent = true;
-        }
-        else if (wheelVerticalTime.elapsed() > oldInterval)
-        {
-            activateEvent = true;
-        }
-        else if (diff >= 0.1 && wheelSpeedY != 0)
-        {
-            double distance = getMouseDistanceFromDeadZone();
-            if (distance > 0.0)
-            {
-                tempInterval = static_cast<int>(1000 / wheelSpeedY / distance);
-            }
-            else
-            {
-                tempInterval = 0;
-            }
-
-            if (wheelVerticalTime.elapsed() < tempInterval)
-            {
-                // Still some valid time left. Continue current action with
-                // remaining time left.
-                tempInterval = tempInterval - wheelVerticalTime.elapsed();
-                tempInterval = qMin(tempInterval, 5);
-                if (!mouseWheelVerticalEventTimer.isActive() || mouseWheelVerticalEventTimer.interval() != tempInterval)
-                {
-                    mouseWheelVerticalEventTimer.start(tempInterval);
-                }
-            }
-            else
-            {
-                // Elapsed time is greater than new interval. Change state.
-                activateEvent = true;
-            }
-        }
-    }
-
-    if (buttonslot && wheelSpeedY != 0)
-    {
-        bool isActive = activeSlots.contains(buttonslot);
-        if (isActive && activateEvent)
-        {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
-            mouseWheelVerticalEventQueue.enqueue(buttonslot);
-            double distance = getMouseDistanceFromDeadZone();
-            if (distance > 0.0)
-            {
-                tempInterval = static_cast<int>(1000 / wheelSpeedY / distance);
-            }
-            else
-            {
-                tempInterval = 0;
-            }
-
-            tempInterval = qMin(tempInterval, 5);
-            if (!mouseWheelVerticalEventTimer.isActive() || mouseWheelVerticalEventTimer.interval() != tempInterval)
-            {
-                mouseWheelVerticalEventTimer.start(tempInterval);
-            }
-        }
-        else if (!isActive)
-        {
-            mouseWheelVerticalEventTimer.stop();
-        }
-    }
-    else if (!mouseWheelVerticalEventQueue.isEmpty() && wheelSpeedY != 0)
-    {
-        QQueue<JoyButtonSlot*> tempQueue;
-        while (!mouseWheelVerticalEventQueue.isEmpty())
-        {
-            buttonslot = mouseWheelVerticalEventQueue.dequeue();
-            bool isActive = activeSlots.contains(buttonslot);
-            if (isActive && activateEvent)
-            {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
-                tempQueue.enqueue(buttonslot);
-            }
-            else if (isActive)
-            {
-                tempQueue.enqueue(buttonslot);
-            }
-        }
-
-        if (!tempQueue.isEmpty())
-        {
-            mouseWheelVerticalEventQueue = tempQueue;
-            double distance = getMouseDistanceFromDeadZone();
-            if (distance > 0.0)
-            {
-                tempInterval = static_cast<int>(1000 / wheelSpeedY / distance);
-            }
-            else
-            {
-                tempInterval = 0;
-            }
-
-            tempInterval = qMin(tempInterval, 5);
-            if (!mouseWheelVerticalEventTimer.isActive() || mouseWheelVerticalEventTimer.interval() != tempInterval)
-            {
-                mouseWheelVerticalEventTimer.start(tempInterval);
-            }
-        }
-        else
-        {
-            mouseWheelVerticalEventTimer.stop();
-        }
+        result = (int)floor((turboInterval * 0.5) + 0.5);
     }
     else
     {
-        mouseWheelVerticalEventTimer.stop();
+        result = (int)floor(((turboInterval / tempDistance) * 0.5) + 0.5);
     }
 
-    if (activateEvent)
-    {
-        wheelVerticalTime.restart();
-        lastWheelVerticalDistance = getMouseDistanceFromDeadZone();
-    }
+    return result;
 }
 
-void JoyGradientButton::wheelEventHorizontal()
-{
-    JoyButtonSlot *buttonslot = 0;
-    bool activateEvent = false;
-
-    int tempInterval = 0;
-    double diff = fabs(getMouseDistanceFromDeadZone() - lastWheelHorizontalDistance);
-    int oldInterval = 0;
-
-    if (wheelSpeedX != 0)
-    {
-        if (lastWheelHorizontalDistance > 0.0)
-        {
-            oldInterval = 1000 / wheelSpeedX / lastWheelHorizontalDistance;
-        }
-        else
-        {
-            oldInterval = 1000 / wheelSpeedX / 0.01;
-        }
-    }
-
-    if (currentWheelHorizontalEvent)
-    {
-        buttonslot = currentWheelHorizontalEvent;
-        activateEvent = true;
-    }
-
-    if (!activateEvent)
-    {
-        if (!mouseWheelHorizontalEventTimer.isActive())
-        {
-            activateEvent = true;
-        }
-        else if (wheelHorizontalTime.elapsed() > oldInterval)
-        {
-            activateEvent = true;
-        }
-        else if (diff >= 0.1 && wheelSpeedX != 0)
-        {
-            double distance = getMouseDistanceFromDeadZone();
-            if (distance > 0.0)
-            {
-                tempInterval = static_cast<int>(1000 / wheelSpeedX / distance);
-            }
-            else
-            {
-                tempInterval = 0;
-            }
-
-            if (wheelHorizontalTime.elapsed() < tempInterval)
-            {
-                // Still some valid time left. Continue current action with
-                // remaining time left.
-                tempInterval = tempInterval - wheelHorizontalTime.elapsed();
-                tempInterval = qMin(tempInterval, 5);
-                if (!mouseWheelHorizontalEventTimer.isActive() || mouseWheelHorizontalEventTimer.interval() != tempInterval)
-                {
-                    mouseWheelHorizontalEventTimer.start(tempInterval);
-                }
-            }
-            else
-            {
-                // Elapsed time is greater than new interval. Change state.
-                activateEvent = true;
-            }
-        }
-    }
-
-    if (buttonslot && wheelSpeedX != 0)
-    {
-        bool isActive = activeSlots.contains(buttonslot);
-        if (isActive && activateEvent)
-        {
-            sendevent(buttonslot, true);
-            sendevent(buttonslot, false);
-            mouseWheelHorizontalEventQueue.enqueue(buttonslot);
-            double distance = getMouseDistanceFromDeadZone();
-            if (distance > 0.0)
-            {
-                tempInterval = static_cast<int>(1000 / wheelSpeedX / distance);
-            }
-            else
-            {
-                tempInterval = 0;
-            }
-
-            tempInterval = qMin(tempInterval, 5);
-
-            if (!mouseWheelHorizontalEventTimer.isActive() || mouseWheelVerticalEventTimer.interval() != tempInterval)
-            {
-                mouseWheelHorizontalEventTimer.start(tempInterval);
-            }
-        }
-        else if (!isActive)
-        {
-            mouseWheelHorizontalEventTimer.stop();
-        }
-    }
-    else if (!mouseWheelHorizontalEventQueue.isEmpty() && wheelSpeedX != 0)
-    {
-        QQueue<JoyButtonSlot*> tempQueue;
-        while (!mouseWheelHorizontalEventQueue.isEmpty())
-        {
-            buttonslot = mouseWheelHorizontalEventQueue.dequeue();
-            bool isActive = activeSlots.contains(buttonslot);
-            if (isActive)
-            {
-                sendevent(buttonslot, true);
-                sendevent(buttonslot, false);
-                tempQueue.enqueue(buttonslot);
-            }
-        }
-
-        if (!tempQueue.isEmpty())
-        {
-            mouseWheelHorizontalEventQueue = tempQueue;
-            double distance = getMouseDistanceFromDeadZone();
-            if (distance > 0.0)
-            {
-                tempInterval = static_cast<int>(1000 / wheelSpeedX / distance);
-            }
-            else
-            {
-                tempInterval = 0;
-            }
-
-            tempInterval = qMin(tempInterval, 5);
-
-            if (!mouseWheelHorizontalEventTimer.isActive() || mouseWheelVerticalEventTimer.interval() != tempInterval)
-            {
-                mouseWheelHorizontalEventTimer.start(tempInterval);
-            }
-        }
-        else
-        {
-            mouseWheelHorizontalEventTimer.stop();
-        }
-    }
-    else
-    {
-        mouseWheelHorizontalEventTimer.stop();
-    }
-
-    if (activateEvent)
-    {
-        wheelHorizontalTime.restart();
-        lastWheelHorizontalDistance = getMouseDistanceFromDeadZone();
-    }
-}
@@ -26,12 +26,13 @@ class JoyGradientButton : public JoyButton
 public:
     explicit JoyGradientButton(int index, int originset, SetJoystick *parentSet, QObject *parent=0);
 
+protected:
+    int getTurboPhaseTime(double distance, bool pressPhase);
+
 signals:
 
 protected slots:
     virtual void turboEvent();
-    virtual void wheelEventVertical();
-    virtual void wheelEventHorizontal();
 };
 
 #endif // JOYGRADIENTBUTTON_H
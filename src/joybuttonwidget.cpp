@@ -45,15 +45,13 @@ JoyButton* JoyButtonWidget::getJoyButton()
 
 void JoyButtonWidget::disableFlashes()
 {
-    disconnect(button, SIGNAL(clicked(int)), this, SLOT(flash()));
-    disconnect(button, SIGNAL(released(int)), this, SLOT(unflash()));
+    flashesEnabled = false;
     this->unflash();
 }
 
 void JoyButtonWidget::enableFlashes()
 {
-    connect(button, SIGNAL(clicked(int)), this, SLOT(flash()), Qt::QueuedConnection);
-    connect(button, SIGNAL(released(int)), this, SLOT(unflash()), Qt::QueuedConnection);
+    flashesEnabled = true;
 }
 
 QString JoyButtonWidget::generateLabel()
@@ -73,8 +71,18 @@ void JoyButtonWidget::showContextMenu(const QPoint &point)
 
 void JoyButtonWidget::tryFlash()
 {
-    if (button->getButtonState())
+    if (isInputActive())
     {
         flash();
     }
 }
+
+int JoyButtonWidget::getActiveZoneVersion()
+{
+    return button->getActiveZoneVersion();
+}
+
+bool JoyButtonWidget::isInputActive()
+{
+    return button->getButtonState();
+}
@@ -34,6 +34,8 @@ public:
     void tryFlash();
 
 protected:
+    virtual int getActiveZoneVersion();
+    virtual bool isInputActive();
     virtual QString generateLabel();
 
     JoyButton* button;
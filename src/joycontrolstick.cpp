@@ -147,8 +147,6 @@ void JoyControlStick::joyEvent(bool ignoresets)
         }
     }
 
-    emit moved(axisX->getCurrentRawValue(), axisY->getCurrentRawValue());
-
     pendingStickEvent = false;
 }
 
@@ -3049,6 +3047,16 @@ void JoyControlStick::clearPendingEvent()
     pendingStickEvent = false;
 }
 
+/**
+ * @brief Check if the queued stick event would move the stick into or out
+ *     of the dead zone.
+ * @return Whether the queued event changes the state of the stick
+ */
+bool JoyControlStick::hasPendingStateChange()
+{
+    return pendingStickEvent && (inDeadZone() == isActive);
+}
+
 void JoyControlStick::setButtonsExtraAccelerationStatus(bool enabled)
 {
     QHashIterator<JoyStickDirections, JoyControlStickButton*> iter(getApplicableButtons());
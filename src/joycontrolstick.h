@@ -171,6 +171,7 @@ public:
     bool hasPendingEvent();
     void activatePendingEvent();
     void clearPendingEvent();
+    bool hasPendingStateChange();
     //double calculateXDistanceFromDeadZone(int axisXValue, int axisYValue, bool interpolate=false);
 
     double getSpringDeadCircleX();
@@ -265,7 +266,6 @@ protected:
     JoyControlStickModifierButton *modifierButton;
 
 signals:
-    void moved(int xaxis, int yaxis);
     void active(int xaxis, int yaxis);
     void released(int axis, int yaxis);
     void deadZoneChanged(int value);
@@ -67,21 +67,13 @@ void JoyControlStickButtonPushButton::setButton(JoyControlStickButton *button)
 
 void JoyControlStickButtonPushButton::disableFlashes()
 {
-    if (button)
-    {
-        disconnect(button, SIGNAL(clicked(int)), this, SLOT(flash()));
-        disconnect(button, SIGNAL(released(int)), this, SLOT(unflash()));
-    }
+    flashesEnabled = false;
     this->unflash();
 }
 
 void JoyControlStickButtonPushButton::enableFlashes()
 {
-    if (button)
-    {
-        connect(button, SIGNAL(clicked(int)), this, SLOT(flash()), Qt::QueuedConnection);
-        connect(button, SIGNAL(released(int)), this, SLOT(unflash()), Qt::QueuedConnection);
-    }
+    flashesEnabled = true;
 }
 
 /**
@@ -116,8 +108,31 @@ void JoyControlStickButtonPushButton::showContextMenu(const QPoint &point)
 
 void JoyControlStickButtonPushButton::tryFlash()
 {
-    if (button->getButtonState())
+    if (isInputActive())
     {
         flash();
     }
 }
+
+int JoyControlStickButtonPushButton::getActiveZoneVersion()
+{
+    int result = lastActiveZoneVersion;
+    if (button)
+    {
+        result = button->getActiveZoneVersion() +
+                 button->getStick()->getModifierButton()->getActiveZoneVersion();
+    }
+
+    return result;
+}
+
+bool JoyControlStickButtonPushButton::isInputActive()
+{
+    bool result = false;
+    if (button)
+    {
+        result = button->getButtonState();
+    }
+
+    return result;
+}
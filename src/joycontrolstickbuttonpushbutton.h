@@ -36,6 +36,8 @@ public:
     void tryFlash();
 
 protected:
+    virtual int getActiveZoneVersion();
+    virtual bool isInputActive();
     virtual QString generateLabel();
 
     JoyControlStickButton *button;
@@ -29,6 +29,7 @@
 #include "buttoneditdialog.h"
 #include "inputdevice.h"
 #include "common.h"
+#include "inputstatesampler.h"
 
 JoyControlStickEditDialog::JoyControlStickEditDialog(JoyControlStick *stick, QWidget *parent) :
     QDialog(parent, Qt::Window),
@@ -134,17 +135,22 @@ JoyControlStickEditDialog::JoyControlStickEditDialog(JoyControlStick *stick, QWi
     connect(stick, SIGNAL(stickDelayChanged(int)), this, SLOT(updateStickDelaySpinBox(int)));
     connect(ui->stickDelayDoubleSpinBox, SIGNAL(valueChanged(double)), this, SLOT(updateStickDelaySlider(double)));
 
-    connect(stick, SIGNAL(moved(int,int)), this, SLOT(refreshStickStats(int,int)));
     connect(ui->mouseSettingsPushButton, SIGNAL(clicked()), this, SLOT(openMouseSettingsDialog()));
 
     connect(ui->stickNameLineEdit, SIGNAL(textEdited(QString)), stick, SLOT(setStickName(QString)));
     connect(stick, SIGNAL(stickNameChanged()), this, SLOT(updateWindowTitleStickName()));
     connect(ui->modifierPushButton, SIGNAL(clicked()), this, SLOT(openModifierEditDialog()));
     connect(stick->getModifierButton(), SIGNAL(slotsChanged()), this, SLOT(changeModifierSummary()));
+
+    lastSampledX = stick->getAxisX()->getPublishedRawValue();
+    lastSampledY = stick->getAxisY()->getPublishedRawValue();
+    InputStateSampler::subscribe(this, SLOT(sampleStickPosition()));
 }
 
 JoyControlStickEditDialog::~JoyControlStickEditDialog()
 {
+    InputStateSampler::unsubscribe(this);
+
     delete ui;
 }
 
@@ -330,6 +336,23 @@ void JoyControlStickEditDialog::refreshStickStats(int x, int y)
     PadderCommon::inputDaemonMutex.unlock();
 }
 
+/**
+ * @brief Check the raw axis values published by the input thread and
+ *     refresh the stick stats if the stick moved. Called by the shared
+ *     sample timer.
+ */
+void JoyControlStickEditDialog::sampleStickPosition()
+{
+    int x = stick->getAxisX()->getPublishedRawValue();
+    int y = stick->getAxisY()->getPublishedRawValue();
+    if (x != lastSampledX || y != lastSampledY)
+    {
+        lastSampledX = x;
+        lastSampledY = y;
+        refreshStickStats(x, y);
+    }
+}
+
 void JoyControlStickEditDialog::checkMaxZone(int value)
 {
     if (value > ui->deadZoneSpinBox->value())
@@ -40,6 +40,8 @@ protected:
 
     JoyControlStick *stick;
     JoyControlStickEditDialogHelper helper;
+    int lastSampledX;
+    int lastSampledY;
 
 private:
     Ui::JoyControlStickEditDialog *ui;
@@ -49,6 +51,7 @@ private slots:
     void implementModes(int index);
 
     void refreshStickStats(int x, int y);
+    void sampleStickPosition();
     void updateMouseMode(int index);
 
     void checkMaxZone(int value);
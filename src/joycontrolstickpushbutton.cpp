@@ -24,14 +24,13 @@ JoyControlStickPushButton::JoyControlStickPushButton(JoyControlStick *stick, boo
     this->stick = stick;
 
     refreshLabel();
+    enableFlashes();
 
     tryFlash();
 
     this->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(this, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(showContextMenu(const QPoint&)));
 
-    connect(stick, SIGNAL(active(int, int)), this, SLOT(flash()), Qt::QueuedConnection);
-    connect(stick, SIGNAL(released(int, int)), this, SLOT(unflash()), Qt::QueuedConnection);
     connect(stick, SIGNAL(stickNameChanged()), this, SLOT(refreshLabel()));
 }
 
@@ -61,15 +60,13 @@ QString JoyControlStickPushButton::generateLabel()
 
 void JoyControlStickPushButton::disableFlashes()
 {
-    disconnect(stick, SIGNAL(active(int, int)), this, SLOT(flash()));
-    disconnect(stick, SIGNAL(released(int, int)), this, SLOT(unflash()));
+    flashesEnabled = false;
     this->unflash();
 }
 
 void JoyControlStickPushButton::enableFlashes()
 {
-    connect(stick, SIGNAL(active(int, int)), this, SLOT(flash()), Qt::QueuedConnection);
-    connect(stick, SIGNAL(released(int, int)), this, SLOT(unflash()), Qt::QueuedConnection);
+    flashesEnabled = true;
 }
 
 void JoyControlStickPushButton::showContextMenu(const QPoint &point)
@@ -82,8 +79,13 @@ void JoyControlStickPushButton::showContextMenu(const QPoint &point)
 
 void JoyControlStickPushButton::tryFlash()
 {
-    if (stick->getCurrentDirection() != JoyControlStick::StickCentered)
+    if (isInputActive())
     {
         flash();
     }
 }
+
+bool JoyControlStickPushButton::isInputActive()
+{
+    return stick->getCurrentDirection() != JoyControlStick::StickCentered;
+}
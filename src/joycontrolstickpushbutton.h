@@ -35,6 +35,7 @@ public:
     
 protected:
     virtual QString generateLabel();
+    virtual bool isInputActive();
 
     JoyControlStick *stick;
 
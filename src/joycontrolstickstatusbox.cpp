@@ -24,24 +24,37 @@
 
 #include "joycontrolstickstatusbox.h"
 #include "common.h"
+#include "inputstatesampler.h"
 
 JoyControlStickStatusBox::JoyControlStickStatusBox(QWidget *parent) :
     QWidget(parent)
 {
     this->stick = 0;
+    lastSampledX = 0;
+    lastSampledY = 0;
+
+    InputStateSampler::subscribe(this, SLOT(sampleStickPosition()));
 }
 
 JoyControlStickStatusBox::JoyControlStickStatusBox(JoyControlStick *stick, QWidget *parent) :
     QWidget(parent)
 {
     this->stick = stick;
+    lastSampledX = 0;
+    lastSampledY = 0;
 
     connect(stick, SIGNAL(deadZoneChanged(int)), this, SLOT(update()));
-    connect(stick, SIGNAL(moved(int,int)), this, SLOT(update()));
     connect(stick, SIGNAL(diagonalRangeChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(maxZoneChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(joyModeChanged()), this, SLOT(update()));
     connect(stick, SIGNAL(circleAdjustChange(double)), this, SLOT(update()));
+
+    InputStateSampler::subscribe(this, SLOT(sampleStickPosition()));
+}
+
+JoyControlStickStatusBox::~JoyControlStickStatusBox()
+{
+    InputStateSampler::unsubscribe(this);
 }
 
 void JoyControlStickStatusBox::setStick(JoyControlStick *stick)
@@ -49,7 +62,6 @@ void JoyControlStickStatusBox::setStick(JoyControlStick *stick)
     if (stick)
     {
         disconnect(stick, SIGNAL(deadZoneChanged(int)), this, 0);
-        disconnect(stick, SIGNAL(moved(int,int)), this, 0);
         disconnect(stick, SIGNAL(diagonalRangeChanged(int)), this, 0);
         disconnect(stick, SIGNAL(maxZoneChanged(int)), this, 0);
         disconnect(stick, SIGNAL(joyModeChanged()), this, 0);
@@ -57,12 +69,30 @@ void JoyControlStickStatusBox::setStick(JoyControlStick *stick)
 
     this->stick = stick;
     connect(stick, SIGNAL(deadZoneChanged(int)), this, SLOT(update()));
-    connect(stick, SIGNAL(moved(int,int)), this, SLOT(update()));
     connect(stick, SIGNAL(diagonalRangeChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(maxZoneChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(joyModeChanged()), this, SLOT(update()));
 }
 
+/**
+ * @brief Repaint the box if the raw axis values published by the input
+ *     thread changed. Called by the shared sample timer.
+ */
+void JoyControlStickStatusBox::sampleStickPosition()
+{
+    if (stick && isVisible())
+    {
+        int x = stick->getAxisX()->getPublishedRawValue();
+        int y = stick->getAxisY()->getPublishedRawValue();
+        if (x != lastSampledX || y != lastSampledY)
+        {
+            lastSampledX = x;
+            lastSampledY = y;
+            update();
+        }
+    }
+}
+
 JoyControlStick* JoyControlStickStatusBox::getStick()
 {
     return stick;
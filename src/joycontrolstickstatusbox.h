@@ -30,6 +30,7 @@ class JoyControlStickStatusBox : public QWidget
 public:
     explicit JoyControlStickStatusBox(QWidget *parent = 0);
     explicit JoyControlStickStatusBox(JoyControlStick *stick, QWidget *parent = 0);
+    ~JoyControlStickStatusBox();
 
     void setStick(JoyControlStick *stick);
 
@@ -45,11 +46,16 @@ protected:
     void drawFourWayDiagonalBox();
 
     JoyControlStick *stick;
+    int lastSampledX;
+    int lastSampledY;
 
 signals:
     
 public slots:
     
+protected slots:
+    void sampleStickPosition();
+
 };
 
 #endif // JOYCONTROLSTICKSTATUSBOX_H
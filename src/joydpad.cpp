@@ -368,6 +368,32 @@ void JoyDPad::releaseButtonEvents()
     }
 }
 
+/**
+ * @brief Return the dpad and its buttons to their default settings. The
+ *     dpad name is kept since it is not part of the dpad element.
+ */
+void JoyDPad::reset()
+{
+    directionDelayTimer.stop();
+
+    currentMode = StandardMode;
+    dpadDelay = DEFAULTDPADDELAY;
+    activeDiagonalButton = 0;
+    prevDirection = JoyDPadButton::DpadCentered;
+    pendingDirection = prevDirection;
+
+    pendingEvent = false;
+    pendingEventDirection = prevDirection;
+    pendingIgnoreSets = false;
+
+    QHashIterator<int, JoyDPadButton*> iter(buttons);
+    while (iter.hasNext())
+    {
+        JoyDPadButton *button = iter.next().value();
+        button->reset();
+    }
+}
+
 QHash<int, JoyDPadButton*>* JoyDPad::getButtons()
 {
     return &buttons;
@@ -55,6 +55,7 @@ public:
     JoyMode getJoyMode();
 
     void releaseButtonEvents();
+    void reset();
 
     void setButtonsMouseMode(JoyButton::JoyMouseMovementMode mode);
     bool hasSameButtonsMouseMode();
@@ -0,0 +1,211 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <QElapsedTimer>
+
+#include "joyextraacceleration.h"
+
+const int JoyExtraAcceleration::EASINGTABLESIZE;
+
+// Travel between two gamepad polls is scaled to this interval so the same
+// stick movement gives the same acceleration at any poll rate. Matches
+// the default gamepad poll rate.
+const qint64 JoyExtraAcceleration::TRAVELREFERENCEINTERVAL = 10 * 1000000;
+const qint64 JoyExtraAcceleration::MINTRAVELINTERVAL = 1 * 1000000;
+const qint64 JoyExtraAcceleration::MAXTRAVELINTERVAL = 100 * 1000000;
+
+static const double PI = acos(-1.0);
+
+// Samples of the ease out curves in the range 0.0 - 1.0. The linear curve
+// is not stored.
+static double easingTables[3][JoyExtraAcceleration::EASINGTABLESIZE + 1];
+
+static bool buildEasingTables()
+{
+    for (int i=0; i <= JoyExtraAcceleration::EASINGTABLESIZE; i++)
+    {
+        double x = i / static_cast<double>(JoyExtraAcceleration::EASINGTABLESIZE);
+        easingTables[0][i] = sin(x * (PI / 2.0));
+        easingTables[1][i] = -(x * (x - 2));
+        easingTables[2][i] = ((x - 1) * (x - 1) * (x - 1)) + 1;
+    }
+
+    return true;
+}
+
+static QElapsedTimer startMonotonicClock()
+{
+    QElapsedTimer temp;
+    temp.start();
+    return temp;
+}
+
+static const bool easingTablesBuilt = buildEasingTables();
+static QElapsedTimer monotonicClock = startMonotonicClock();
+
+/**
+ * @brief Get the current time of the monotonic clock used for acceleration.
+ * @return Time in ns
+ */
+qint64 JoyExtraAcceleration::currentTime()
+{
+    return monotonicClock.nsecsElapsed();
+}
+
+void JoyExtraAcceleration::resetState(State &state, qint64 now)
+{
+    state.currentMulti = 0.0;
+    state.oldMulti = 0.0;
+    state.travel = 0.0;
+    state.multiplierTime = now;
+    state.lastDistanceTime = now;
+}
+
+/**
+ * @brief Update the state when the gamepad is polled. Must be called once
+ *     per poll so the state does not depend on the number of mouse ticks
+ *     that happen between two polls.
+ * @param Acceleration state of the button
+ */
+void JoyExtraAcceleration::advancePoll(State &state)
+{
+    state.oldMulti = state.currentMulti;
+}
+
+/**
+ * @brief Evaluate an ease out curve using the precomputed tables.
+ * @param Curve to use
+ * @param Value in the range 0.0 - 1.0. Clamped if outside of the range.
+ * @return Eased value
+ */
+double JoyExtraAcceleration::ease(EasingCurve curve, double value)
+{
+    double result = qBound(0.0, value, 1.0);
+    if (curve != LinearCurve && easingTablesBuilt)
+    {
+        const double *table = easingTables[curve - 1];
+        double position = result * EASINGTABLESIZE;
+        int index = qMin(static_cast<int>(position), EASINGTABLESIZE - 1);
+        double fraction = position - index;
+        result = table[index] + ((table[index + 1] - table[index]) * fraction);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Find the multiplier to apply to the mouse speed of a button.
+ * @param Acceleration settings of the button
+ * @param Acceleration state of the button. Updated by the call.
+ * @param Current distance of the element
+ * @param Distance sampled at the previous gamepad poll
+ * @param Distance where the current acceleration started
+ * @param Time in ns between the gamepad polls that sampled the last
+ *     distance and the current distance
+ * @param Current monotonic time in ns
+ * @param Set when the starting distance should be updated after the poll
+ * @return Multiplier for the mouse speed. 1.0 means no extra acceleration.
+ */
+double JoyExtraAcceleration::calculateMultiplier(const Parameters &params, State &state,
+                                                 double distance, double lastDistance,
+                                                 double startingDistance, qint64 sampleInterval,
+                                                 qint64 now, bool &updateStartingDistance)
+{
+    double result = 1.0;
+
+    double mintravel = params.minThreshold * 0.01;
+    double maxtravel = params.maxThreshold * 0.01;
+    double minstop = qMax(0.05, mintravel);
+    double minfactor = qMax(1.0, params.multiplier * (params.startMultiplier * 0.01));
+    double range = params.multiplier - minfactor;
+    double slope = (maxtravel > mintravel) ? (range / (maxtravel - mintravel)) : 0.0;
+    double intercept = minfactor - (slope * mintravel);
+
+    // Travel is measured between two gamepad polls. Scale it by the poll
+    // interval rather than the time of the mouse tick that evaluates it.
+    qint64 travelInterval = (sampleInterval > 0) ?
+                qBound(MINTRAVELINTERVAL, sampleInterval, MAXTRAVELINTERVAL) :
+                TRAVELREFERENCEINTERVAL;
+    double travel = fabs(distance - lastDistance) *
+            (TRAVELREFERENCEINTERVAL / static_cast<double>(travelInterval));
+
+    // Last check ensures that acceleration is only applied for the same direction.
+    if (travel >= mintravel && ((distance - lastDistance >= 0) == (distance >= 0)))
+    {
+        double intermediateTravel = qMin(maxtravel, travel);
+        if (state.oldMulti == 0.0)
+        {
+            // Boost the whole poll in which acceleration starts.
+            intermediateTravel = qMin(maxtravel, intermediateTravel + mintravel);
+        }
+
+        double multiDiff = (range > 0.0) ?
+                    (((slope * intermediateTravel + intercept) - minfactor) / range) : 1.0;
+        double currentMulti = (range * ease(params.curve, multiDiff)) + minfactor;
+
+        result = currentMulti;
+        state.currentMulti = currentMulti;
+        state.travel = intermediateTravel;
+        // Ease out is timed from the poll that sampled the travel rather
+        // than from the last mouse tick that used it.
+        state.multiplierTime = (sampleInterval > 0) ?
+                    (state.lastDistanceTime + sampleInterval) : now;
+    }
+    else if (params.duration > 0.0 && state.currentMulti > 0.0 &&
+             fabs(distance - startingDistance) < minstop)
+    {
+        updateStartingDistance = true;
+
+        double intermediateTravel = state.travel;
+        if ((distance - startingDistance >= 0) != (distance >= 0))
+        {
+            // Travelling towards dead zone. Decrease acceleration and duration.
+            intermediateTravel = qMax(intermediateTravel - fabs(distance - startingDistance), mintravel);
+        }
+
+        double multiDiff = (range > 0.0) ?
+                    (((slope * intermediateTravel + intercept) - minfactor) / range) : 1.0;
+        double eased = ease(params.curve, multiDiff);
+        double elapsedDuration = params.duration * eased;
+        double currentMulti = (range * eased) + minfactor;
+        double elapsed = (now - state.multiplierTime) * 0.000000001;
+
+        if (elapsedDuration > 0.0 && elapsed < elapsedDuration)
+        {
+            double elapsedDiff = elapsed / elapsedDuration;
+            result = (1.0 - currentMulti) * (elapsedDiff * elapsedDiff * elapsedDiff) + currentMulti;
+
+            // As acceleration is applied, do not update last
+            // distance values when not necessary.
+            updateStartingDistance = false;
+        }
+        else
+        {
+            state.currentMulti = 0.0;
+            state.travel = 0.0;
+        }
+    }
+    else
+    {
+        state.currentMulti = 0.0;
+        updateStartingDistance = true;
+        state.travel = 0.0;
+    }
+
+    return result;
+}
@@ -0,0 +1,78 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOYEXTRAACCELERATION_H
+#define JOYEXTRAACCELERATION_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Extra mouse acceleration applied when an axis or stick travels
+ *     quickly. All state for a button is kept in a State struct and time is
+ *     passed in explicitly so results only depend on the inputs.
+ */
+class JoyExtraAcceleration
+{
+public:
+    // Order matches JoyButton::JoyExtraAccelerationCurve.
+    enum EasingCurve {LinearCurve=0, EaseOutSineCurve, EaseOutQuadCurve,
+                      EaseOutCubicCurve};
+
+    typedef struct _Parameters
+    {
+        // Highest multiplier that can be applied.
+        double multiplier;
+        // Travel thresholds in percent of the full range.
+        double minThreshold;
+        double maxThreshold;
+        // Lowest multiplier in percent of multiplier.
+        double startMultiplier;
+        // Time in seconds used to ease out once travel stops.
+        double duration;
+        EasingCurve curve;
+    } Parameters;
+
+    typedef struct _State
+    {
+        double currentMulti;
+        // Multiplier when the current gamepad poll started. 0.0 when no
+        // acceleration was active.
+        double oldMulti;
+        // Travel used when acceleration started.
+        double travel;
+        // Monotonic time in ns when the current multiplier was set.
+        qint64 multiplierTime;
+        // Monotonic time in ns when the last distance was sampled.
+        qint64 lastDistanceTime;
+    } State;
+
+    static void resetState(State &state, qint64 now);
+    static void advancePoll(State &state);
+    static double calculateMultiplier(const Parameters &params, State &state,
+                                      double distance, double lastDistance,
+                                      double startingDistance, qint64 sampleInterval,
+                                      qint64 now, bool &updateStartingDistance);
+    static double ease(EasingCurve curve, double value);
+    static qint64 currentTime();
+
+    static const int EASINGTABLESIZE = 256;
+    static const qint64 TRAVELREFERENCEINTERVAL;
+    static const qint64 MINTRAVELINTERVAL;
+    static const qint64 MAXTRAVELINTERVAL;
+};
+
+#endif // JOYEXTRAACCELERATION_H
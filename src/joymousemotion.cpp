@@ -0,0 +1,64 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "joymousemotion.h"
+
+/**
+ * @brief Integrate a velocity over the time of one mouse tick.
+ * @param Velocity in pixels per second
+ * @param Time since the previous mouse tick in ns
+ * @return Displacement in pixels
+ */
+double JoyMouseMotion::displacement(double velocity, qint64 elapsed)
+{
+    return velocity * (elapsed * 0.000000001);
+}
+
+/**
+ * @brief Add the sub-pixel remainder of the previous tick to a
+ *     displacement. The remainder is dropped when the direction changed.
+ * @param Displacement of the current tick
+ * @param Remainder left by the previous tick
+ * @return Displacement including the remainder
+ */
+double JoyMouseMotion::carryRemainder(double displacement, double remainder)
+{
+    double result = displacement;
+    if ((remainder >= 0) == (displacement >= 0))
+    {
+        result += remainder;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Split a displacement into whole pixels and a sub-pixel remainder.
+ *     Rounds towards zero so the remainder keeps the sign of the
+ *     displacement.
+ * @param Displacement in pixels
+ * @param Set to the part of the displacement that was not used
+ * @return Whole pixels to move
+ */
+int JoyMouseMotion::takeWholePixels(double displacement, double &remainder)
+{
+    double whole = (displacement > 0) ? floor(displacement) : ceil(displacement);
+    remainder = displacement - whole;
+    return static_cast<int>(whole);
+}
@@ -0,0 +1,36 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOYMOUSEMOTION_H
+#define JOYMOUSEMOTION_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Steps used to turn a cursor velocity into whole pixel moves on
+ *     every mouse tick. Time is passed in explicitly so results only
+ *     depend on the inputs.
+ */
+class JoyMouseMotion
+{
+public:
+    static double displacement(double velocity, qint64 elapsed);
+    static double carryRemainder(double displacement, double remainder);
+    static int takeWholePixels(double displacement, double &remainder);
+};
+
+#endif // JOYMOUSEMOTION_H
@@ -26,6 +26,7 @@
 #include "joystickstatuswindow.h"
 #include "ui_joystickstatuswindow.h"
 #include "joybuttonstatusbox.h"
+#include "inputstatesampler.h"
 
 
 JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *parent) :
@@ -36,6 +37,7 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
     setAttribute(Qt::WA_DeleteOnClose);
 
     this->joystick = joystick;
+    this->sampling = false;
 
     PadderCommon::inputDaemonMutex.lock();
 
@@ -74,7 +76,8 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
             hbox->addSpacing(10);
             axesBox->addLayout(hbox);
 
-            connect(axis, SIGNAL(moved(int)), axisBar, SLOT(setValue(int)));
+            axes.append(axis);
+            axisBars.append(axisBar);
         }
     }
 
@@ -128,8 +131,8 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
             hbox->addSpacing(10);
             hatsBox->addLayout(hbox);
 
-            connect(dpad, SIGNAL(active(int)), dpadBar, SLOT(setValue(int)));
-            connect(dpad, SIGNAL(released(int)), dpadBar, SLOT(setValue(int)));
+            dpads.append(dpad);
+            dpadBars.append(dpadBar);
         }
     }
 
@@ -172,13 +175,68 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
 
     connect(joystick, SIGNAL(destroyed()), this, SLOT(obliterate()));
     connect(this, SIGNAL(finished(int)), this, SLOT(restoreButtonStates(int)));
+
+    InputStateSampler::subscribe(this, SLOT(sampleInputState()));
+    sampling = true;
 }
 
 JoystickStatusWindow::~JoystickStatusWindow()
 {
+    stopSampling();
+
     delete ui;
 }
 
+InputDevice* JoystickStatusWindow::getJoystick()
+{
+    return joystick;
+}
+
+/**
+ * @brief Stop reading the state of the device. Has to be called from the
+ *     GUI thread before the device is handed off for deletion.
+ */
+void JoystickStatusWindow::stopSampling()
+{
+    if (sampling)
+    {
+        InputStateSampler::unsubscribe(this);
+        sampling = false;
+    }
+
+    axes.clear();
+    dpads.clear();
+}
+
+/**
+ * @brief Update axis and hat bars using the values published by the
+ *     input thread. Called by the shared sample timer. The elements stay
+ *     valid because MainWindow calls stopSampling before the device is
+ *     removed.
+ */
+void JoystickStatusWindow::sampleInputState()
+{
+    for (int i=0; i < axes.size(); i++)
+    {
+        int value = axes.at(i)->getPublishedRawValue();
+        QProgressBar *axisBar = axisBars.at(i);
+        if (axisBar->value() != value)
+        {
+            axisBar->setValue(value);
+        }
+    }
+
+    for (int i=0; i < dpads.size(); i++)
+    {
+        int value = dpads.at(i)->getCurrentDirection();
+        QProgressBar *dpadBar = dpadBars.at(i);
+        if (dpadBar->value() != value)
+        {
+            dpadBar->setValue(value);
+        }
+    }
+}
+
 void JoystickStatusWindow::restoreButtonStates(int code)
 {
     if (code == QDialogButtonBox::AcceptRole)
@@ -19,6 +19,8 @@
 #define JOYSTICKSTATUSWINDOW_H
 
 #include <QDialog>
+#include <QList>
+#include <QProgressBar>
 
 #include "inputdevice.h"
 
@@ -34,14 +36,25 @@ public:
     explicit JoystickStatusWindow(InputDevice *joystick, QWidget *parent = 0);
     ~JoystickStatusWindow();
 
+    InputDevice* getJoystick();
+    void stopSampling();
+
 protected:
     InputDevice *joystick;
+    // Elements are owned by the input thread. stopSampling has to be
+    // called before the device is deleted.
+    QList<JoyAxis*> axes;
+    QList<QProgressBar*> axisBars;
+    QList<JoyDPad*> dpads;
+    QList<QProgressBar*> dpadBars;
+    bool sampling;
 
 private:
     Ui::JoystickStatusWindow *ui;
 
 private slots:
     void restoreButtonStates(int code);
+    void sampleInputState();
     void obliterate();
 };
 
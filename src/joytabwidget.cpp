@@ -23,6 +23,9 @@
 #include <QTextStream>
 #include <QStringListIterator>
 #include <QMenu>
+#include <QFile>
+#include <QCryptographicHash>
+#include <QXmlStreamReader>
 
 #include "joytabwidget.h"
 #include "joyaxiswidget.h"
@@ -37,6 +40,7 @@
 #include "stickpushbuttongroup.h"
 #include "dpadpushbuttongroup.h"
 #include "common.h"
+#include "logger.h"
 
 #ifdef USE_SDL_2
 #include "gamecontroller/gamecontroller.h"
@@ -54,6 +58,12 @@ JoyTabWidget::JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, Q
 
     comboBoxIndex = 0;
     hideEmptyButtons = false;
+    profileReloadRetried = false;
+
+    profileReloadTimer.setSingleShot(true);
+    profileReloadTimer.setInterval(PROFILERELOADDELAY);
+    connect(&profileWatcher, SIGNAL(fileChanged(QString)), this, SLOT(profileFileChanged(QString)));
+    connect(&profileReloadTimer, SIGNAL(timeout()), this, SLOT(reloadWatchedProfile()));
 
     verticalLayout = new QVBoxLayout (this);
     verticalLayout->setContentsMargins(4, 4, 4, 4);
@@ -540,7 +550,7 @@ void JoyTabWidget::openConfigFileDialog()
         settings->getLock()->lock();
 
         settings->setValue("LastProfileDir", outputFilename);
-        settings->sync();
+        settings->scheduleSync();
 
         settings->getLock()->unlock();
     }
@@ -678,6 +688,7 @@ void JoyTabWidget::saveConfigFile()
 
                 //PadderCommon::inputDaemonMutex.unlock();
 
+                updateProfileWatch();
                 emit joystickConfigChanged(joystick->getJoyNumber());
             }
             else
@@ -695,6 +706,7 @@ void JoyTabWidget::saveConfigFile()
 
                 //PadderCommon::inputDaemonMutex.unlock();
 
+                updateProfileWatch();
                 emit joystickConfigChanged(joystick->getJoyNumber());
             }
         }
@@ -857,6 +869,7 @@ void JoyTabWidget::saveAsConfig()
 
                 configBox->setCurrentIndex(1);
                 saveDeviceSettings(true);
+                updateProfileWatch();
                 emit joystickConfigChanged(joystick->getJoyNumber());
             }
             else
@@ -869,6 +882,7 @@ void JoyTabWidget::saveAsConfig()
 
                 configBox->setItemIcon(existingIndex, QIcon());
                 saveDeviceSettings(true);
+                updateProfileWatch();
                 emit joystickConfigChanged(joystick->getJoyNumber());
             }
         }
@@ -944,6 +958,7 @@ void JoyTabWidget::changeJoyConfig(int index)
     }
 
     comboBoxIndex = index;
+    updateProfileWatch();
 
     connect(joystick, SIGNAL(profileUpdated()), this, SLOT(displayProfileEditNotification()));
 }
@@ -1316,8 +1331,16 @@ void JoyTabWidget::showStickAssignmentDialog()
     dialog->show();
 }
 
-void JoyTabWidget::loadConfigFile(QString fileLocation)
+/**
+ * @brief Select a profile in the profile list. The profile is read when
+ *     the selection changes.
+ * @param Path to the profile
+ * @return Whether the profile is now loaded without errors
+ */
+bool JoyTabWidget::loadConfigFile(QString fileLocation)
 {
+    bool result = false;
+
     checkForUnsavedProfile(-1);
 
     if (!joystick->isDeviceEdited())
@@ -1350,8 +1373,14 @@ void JoyTabWidget::loadConfigFile(QString fileLocation)
                 configBox->setCurrentIndex(searchIndex);
                 emit joystickConfigChanged(joystick->getJoyNumber());
             }
+
+            result = configBox->itemData(configBox->currentIndex()).toString() ==
+                     fileinfo.absoluteFilePath() &&
+                     tabHelper.hasReader() && !tabHelper.getReader()->hasError();
         }
     }
+
+    return result;
 }
 
 void JoyTabWidget::showQuickSetDialog()
@@ -1429,7 +1458,7 @@ void JoyTabWidget::saveDeviceSettings(bool sync)
     settings->endGroup();
     if (sync)
     {
-        settings->sync();
+        settings->scheduleSync();
     }
     settings->getLock()->unlock();
 }
@@ -1821,6 +1850,147 @@ void JoyTabWidget::checkHideEmptyOption()
     }
 }
 
+void JoyTabWidget::checkProfileWatchOption()
+{
+    updateProfileWatch();
+}
+
+/**
+ * @brief Watch the currently selected profile file for changes made by
+ *     other programs when enabled in the settings.
+ */
+void JoyTabWidget::updateProfileWatch()
+{
+    QStringList watchedFiles = profileWatcher.files();
+    if (!watchedFiles.isEmpty())
+    {
+        profileWatcher.removePaths(watchedFiles);
+    }
+
+    profileReloadTimer.stop();
+    profileReloadRetried = false;
+    watchedProfileHash.clear();
+
+    bool reloadProfiles = settings->value("ReloadChangedProfiles", false).toBool();
+    int index = configBox->currentIndex();
+    if (reloadProfiles && index > 0)
+    {
+        QString filename = configBox->itemData(index).toString();
+        QFile profileFile(filename);
+        if (!filename.isEmpty() && profileFile.open(QFile::ReadOnly))
+        {
+            watchedProfileHash = QCryptographicHash::hash(profileFile.readAll(),
+                                                          QCryptographicHash::Md5);
+            profileFile.close();
+            profileWatcher.addPath(filename);
+        }
+    }
+}
+
+void JoyTabWidget::profileFileChanged(QString path)
+{
+    Q_UNUSED(path);
+
+    // Wait for an editor to finish writing the file.
+    profileReloadRetried = false;
+    profileReloadTimer.start();
+}
+
+/**
+ * @brief Load the watched profile again after it has been changed on disk.
+ *     The profile is checked before it is applied. The current profile
+ *     stays active when the new file cannot be parsed or when the device
+ *     has unsaved changes. A missing or unreadable file is checked once
+ *     more after the reload delay.
+ */
+void JoyTabWidget::reloadWatchedProfile()
+{
+    int index = configBox->currentIndex();
+    QString filename;
+    if (index > 0)
+    {
+        filename = configBox->itemData(index).toString();
+    }
+
+    QFile profileFile(filename);
+    if (!filename.isEmpty() && profileFile.open(QFile::ReadOnly))
+    {
+        QByteArray profileData = profileFile.readAll();
+        profileFile.close();
+
+        // Editors that save by replacing the file remove it from the watcher.
+        if (!profileWatcher.files().contains(filename))
+        {
+            profileWatcher.addPath(filename);
+        }
+
+        QByteArray profileHash = QCryptographicHash::hash(profileData, QCryptographicHash::Md5);
+        if (profileHash == watchedProfileHash)
+        {
+            // Contents did not change. Usually caused by saving the profile
+            // from this program.
+        }
+        else if (joystick->isDeviceEdited())
+        {
+            Logger::LogWarning(tr("Profile %1 was changed on disk but has unsaved changes. "
+                                  "Not reloading.").arg(filename));
+        }
+        else if (!isValidProfileData(profileData))
+        {
+            Logger::LogWarning(tr("Profile %1 was changed on disk but could not be read. "
+                                  "Keeping the current profile.").arg(filename));
+        }
+        else
+        {
+            Logger::LogInfo(tr("Reloading changed profile %1.").arg(filename));
+            changeJoyConfig(index);
+        }
+    }
+    else if (!filename.isEmpty())
+    {
+        // Editors that save through a temporary file and a rename leave
+        // a short window where the profile does not exist.
+        if (QFile::exists(filename) && !profileWatcher.files().contains(filename))
+        {
+            profileWatcher.addPath(filename);
+        }
+
+        if (!profileReloadRetried)
+        {
+            profileReloadRetried = true;
+            profileReloadTimer.start();
+        }
+        else if (!profileWatcher.files().contains(filename))
+        {
+            Logger::LogWarning(tr("Profile %1 could not be read after it was changed on disk. "
+                                  "It will no longer be reloaded automatically.").arg(filename));
+        }
+        else
+        {
+            Logger::LogWarning(tr("Profile %1 could not be read after it was changed on disk. "
+                                  "Keeping the current profile.").arg(filename));
+        }
+    }
+}
+
+/**
+ * @brief Check that profile data is well formed XML for a known device type.
+ */
+bool JoyTabWidget::isValidProfileData(const QByteArray &profileData)
+{
+    QXmlStreamReader reader(profileData);
+    bool result = reader.readNextStartElement() &&
+            (reader.name() == Joystick::xmlName || reader.name() == joystick->getXmlName());
+
+    while (result && !reader.atEnd())
+    {
+        reader.readNext();
+    }
+
+    result = result && !reader.hasError();
+    return result;
+}
+
 void JoyTabWidget::fillSetButtons(SetJoystick *set)
 {
     int row = 0;
@@ -30,6 +30,9 @@
 #include <QStackedWidget>
 #include <QScrollArea>
 #include <QIcon>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QByteArray>
 
 #include "uihelpers/joytabwidgethelper.h"
 
@@ -57,6 +60,7 @@ public:
     bool isDisplayingNames();
     bool discardUnsavedProfileChanges();
     void checkHideEmptyOption();
+    void checkProfileWatchOption();
     void refreshHelperThread();
 
 #ifdef Q_OS_WIN
@@ -75,6 +79,9 @@ protected:
     void fillSetButtons(SetJoystick *set);
     void removeSetButtons(SetJoystick *set);
 
+    void updateProfileWatch();
+    bool isValidProfileData(const QByteArray &profileData);
+
     QVBoxLayout *verticalLayout;
     QHBoxLayout *configHorizontalLayout;
     QPushButton *removeButton;
@@ -146,7 +153,13 @@ protected:
 
     JoyTabWidgetHelper tabHelper;
 
+    QFileSystemWatcher profileWatcher;
+    QTimer profileReloadTimer;
+    QByteArray watchedProfileHash;
+    bool profileReloadRetried;
+
     static const int DEFAULTNUMBERPROFILES = 5;
+    static const int PROFILERELOADDELAY = 500;
 
 signals:
     void joystickConfigChanged(int index);
@@ -164,7 +177,7 @@ public slots:
     void loadDeviceSettings();
     void changeNameDisplay(bool displayNames);
     void changeCurrentSet(int index);
-    void loadConfigFile(QString fileLocation);
+    bool loadConfigFile(QString fileLocation);
     void refreshButtons();
 
 private slots:
@@ -207,6 +220,8 @@ private slots:
     void performSetCopy();
     void disableCopyCurrentSet();
     void refreshSetButtons();
+    void profileFileChanged(QString path);
+    void reloadWatchedProfile();
 
 #ifdef USE_SDL_2
     void openGameControllerMappingWindow();
@@ -16,15 +16,32 @@
  */
 
 #include <QTextStream>
-#include <QLocalSocket>
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QMapIterator>
 
 #include "localantimicroserver.h"
+#include "joybutton.h"
 #include "common.h"
+#include "logger.h"
+
+// Commands are small. Anything larger is treated as a protocol error.
+const int LocalAntiMicroServer::MAXFRAMESIZE = 64 * 1024;
+
+static const QDataStream::Version FRAMESTREAMVERSION = QDataStream::Qt_4_6;
 
 LocalAntiMicroServer::LocalAntiMicroServer(QObject *parent) :
     QObject(parent)
 {
     localServer = new QLocalServer(this);
+    joysticks = 0;
+    commandCount = 0;
+    profileLoadResult = false;
+}
+
+void LocalAntiMicroServer::setJoysticks(QMap<SDL_JoystickID, InputDevice *> *joysticks)
+{
+    this->joysticks = joysticks;
 }
 
 void LocalAntiMicroServer::startLocalServer()
@@ -40,6 +57,7 @@ void LocalAntiMicroServer::startLocalServer()
     }
     else
     {
+        uptime.start();
         connect(localServer, SIGNAL(newConnection()), this, SLOT(handleOutsideConnection()));
     }
 }
@@ -49,6 +67,8 @@ void LocalAntiMicroServer::handleOutsideConnection()
     QLocalSocket *socket = localServer->nextPendingConnection();
     if (socket)
     {
+        socketBuffers.insert(socket, QByteArray());
+        connect(socket, SIGNAL(readyRead()), this, SLOT(readSocketData()));
         connect(socket, SIGNAL(disconnected()), this, SLOT(handleSocketDisconnect()));
         connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
     }
@@ -56,10 +76,357 @@ void LocalAntiMicroServer::handleOutsideConnection()
 
 void LocalAntiMicroServer::handleSocketDisconnect()
 {
-    emit clientdisconnect();
+    QLocalSocket *socket = static_cast<QLocalSocket*>(sender());
+    bool sentCommands = commandClients.contains(socket);
+
+    socketBuffers.remove(socket);
+    commandClients.remove(socket);
+
+    // Older clients save their options to the settings file and then
+    // disconnect. Have the settings reloaded for them.
+    if (!sentCommands)
+    {
+        emit clientdisconnect();
+    }
+}
+
+void LocalAntiMicroServer::readSocketData()
+{
+    QLocalSocket *socket = static_cast<QLocalSocket*>(sender());
+    if (socketBuffers.contains(socket))
+    {
+        socketBuffers[socket].append(socket->readAll());
+        processFrames(socket);
+    }
+}
+
+/**
+ * @brief Execute all complete command frames that have been received
+ *     from a client and write a reply frame for each one. A command can
+ *     run a nested event loop, so the receive buffer is looked up again
+ *     for every frame and the client may be gone afterwards.
+ * @param Client socket
+ */
+void LocalAntiMicroServer::processFrames(QLocalSocket *socket)
+{
+    // Data that arrives while a command of this client is running is
+    // handled by the outer call.
+    if (!processingClients.contains(socket))
+    {
+        processingClients.insert(socket);
+
+        QByteArray payload;
+        bool invalid = false;
+        bool done = false;
+        while (!done)
+        {
+            QHash<QLocalSocket*, QByteArray>::iterator iter = socketBuffers.find(socket);
+            if (iter == socketBuffers.end())
+            {
+                // Client disconnected while a command was running.
+                done = true;
+            }
+            else if (!takeFrame(iter.value(), payload, invalid))
+            {
+                done = true;
+                if (invalid)
+                {
+                    Logger::LogWarning(tr("Dropping client that sent an invalid command frame."));
+                    iter.value().clear();
+                    socket->abort();
+                }
+            }
+            else
+            {
+                QDataStream stream(payload);
+                stream.setVersion(FRAMESTREAMVERSION);
+
+                quint32 command = 0;
+                QStringList arguments;
+                stream >> command >> arguments;
+
+                bool ok = false;
+                QString message;
+                if (stream.status() == QDataStream::Ok)
+                {
+                    commandClients.insert(socket);
+                    message = executeCommand(static_cast<int>(command), arguments, ok);
+                }
+                else
+                {
+                    message = tr("Malformed command");
+                }
+
+                if (socketBuffers.contains(socket))
+                {
+                    QByteArray replyPayload;
+                    QDataStream replyStream(&replyPayload, QIODevice::WriteOnly);
+                    replyStream.setVersion(FRAMESTREAMVERSION);
+                    replyStream << static_cast<quint32>(ok ? CommandOk : CommandError) << message;
+                    socket->write(buildFrame(replyPayload));
+                }
+            }
+        }
+
+        processingClients.remove(socket);
+    }
+}
+
+/**
+ * @brief Apply a command sent by another antimicro instance or a script.
+ * @param Command type
+ * @param Command arguments
+ * @param Set to whether the command was accepted
+ * @return Reply text sent back to the client
+ */
+QString LocalAntiMicroServer::executeCommand(int command, QStringList arguments, bool &ok)
+{
+    QString result;
+    ok = true;
+    commandCount++;
+
+    QString controller;
+
+    switch (command)
+    {
+        case LoadProfileCommand:
+        {
+            if (!arguments.isEmpty() && !arguments.at(0).isEmpty())
+            {
+                controller = arguments.value(1);
+
+                // Receiver reports the outcome through setProfileLoadResult.
+                profileLoadResult = false;
+                emit profileLoadRequested(arguments.at(0), controller);
+                if (profileLoadResult)
+                {
+                    result = tr("Loaded profile %1").arg(arguments.at(0));
+                }
+                else
+                {
+                    ok = false;
+                    result = tr("Could not load profile %1").arg(arguments.at(0));
+                }
+            }
+            else
+            {
+                ok = false;
+                result = tr("No profile specified");
+            }
+
+            break;
+        }
+        case UnloadProfileCommand:
+        {
+            controller = arguments.value(0);
+            emit profileUnloadRequested(controller);
+            result = tr("Unloaded profile");
+            break;
+        }
+        case SetStartSetCommand:
+        {
+            unsigned int setNumber = arguments.value(0).toUInt(&ok);
+            if (ok && setNumber >= 1 && setNumber <= static_cast<unsigned int>(InputDevice::NUMBER_JOYSETS))
+            {
+                controller = arguments.value(1);
+                emit startSetRequested(setNumber, controller);
+                result = tr("Changed to set %1").arg(setNumber);
+            }
+            else
+            {
+                ok = false;
+                result = tr("Invalid set number");
+            }
+
+            break;
+        }
+        case QueryStateCommand:
+        {
+            result = generateStateReport();
+            break;
+        }
+        case StatsCommand:
+        {
+            result = generateStatsReport();
+            break;
+        }
+        default:
+        {
+            ok = false;
+            result = tr("Unknown command %1").arg(command);
+            break;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Generate a line for every connected controller with its number,
+ *     identifier, active set and name.
+ */
+QString LocalAntiMicroServer::generateStateReport()
+{
+    QStringList lines;
+
+    if (joysticks)
+    {
+        QMutexLocker tempLocker(&PadderCommon::inputDaemonMutex);
+
+        QMapIterator<SDL_JoystickID, InputDevice*> iter(*joysticks);
+        while (iter.hasNext())
+        {
+            InputDevice *device = iter.next().value();
+            lines.append(QString("%1\t%2\t%3\t%4")
+                         .arg(device->getRealJoyNumber())
+                         .arg(device->getStringIdentifier())
+                         .arg(device->getActiveSetNumber() + 1)
+                         .arg(device->getSDLName()));
+        }
+    }
+
+    return lines.join("\n");
+}
+
+QString LocalAntiMicroServer::generateStatsReport()
+{
+    QStringList lines;
+
+    int deviceCount = 0;
+    if (joysticks)
+    {
+        QMutexLocker tempLocker(&PadderCommon::inputDaemonMutex);
+        deviceCount = joysticks->size();
+    }
+
+    lines.append(QString("Devices\t%1").arg(deviceCount));
+    lines.append(QString("MouseRefreshRate\t%1").arg(JoyButton::getMouseRefreshRate()));
+    lines.append(QString("GamepadPollRate\t%1").arg(JoyButton::getGamepadRefreshRate()));
+    lines.append(QString("CommandsProcessed\t%1").arg(commandCount));
+    lines.append(QString("Uptime\t%1").arg(uptime.isValid() ? uptime.elapsed() / 1000 : 0));
+
+    return lines.join("\n");
 }
 
 void LocalAntiMicroServer::close()
 {
     localServer->close();
 }
+
+/**
+ * @brief Record whether the last profile load request succeeded. Has to
+ *     be connected directly so the result is known before the reply
+ *     frame is written.
+ * @param Whether the profile was loaded
+ */
+void LocalAntiMicroServer::setProfileLoadResult(bool loaded)
+{
+    profileLoadResult = loaded;
+}
+
+QByteArray LocalAntiMicroServer::buildFrame(const QByteArray &payload)
+{
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setVersion(FRAMESTREAMVERSION);
+    stream << static_cast<quint32>(payload.size());
+    result.append(payload);
+
+    return result;
+}
+
+/**
+ * @brief Remove the first complete frame from a receive buffer.
+ * @param Receive buffer
+ * @param Set to the payload of the frame
+ * @param Set to true if the buffer holds a frame with an invalid size
+ * @return Whether a complete frame was taken
+ */
+bool LocalAntiMicroServer::takeFrame(QByteArray &buffer, QByteArray &payload, bool &invalid)
+{
+    bool result = false;
+    const int headerSize = static_cast<int>(sizeof(quint32));
+
+    if (!invalid && buffer.size() >= headerSize)
+    {
+        QDataStream stream(buffer);
+        stream.setVersion(FRAMESTREAMVERSION);
+        quint32 frameSize = 0;
+        stream >> frameSize;
+
+        if (frameSize > static_cast<quint32>(MAXFRAMESIZE))
+        {
+            invalid = true;
+        }
+        else if (buffer.size() - headerSize >= static_cast<int>(frameSize))
+        {
+            payload = buffer.mid(headerSize, static_cast<int>(frameSize));
+            buffer.remove(0, headerSize + static_cast<int>(frameSize));
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Build the frame for a command. Used by clients.
+ * @param Command type
+ * @param Command arguments
+ * @return Frame that can be written to the server socket
+ */
+QByteArray LocalAntiMicroServer::buildCommandFrame(InstanceCommand command,
+                                                   QStringList arguments)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(FRAMESTREAMVERSION);
+    stream << static_cast<quint32>(command) << arguments;
+
+    return buildFrame(payload);
+}
+
+/**
+ * @brief Send a command to a running instance and wait for the reply.
+ *     Used by clients.
+ * @param Socket connected to the server
+ * @param Command type
+ * @param Command arguments
+ * @param Set to the reply text
+ * @param Time in ms to wait for the reply
+ * @return Whether the command was accepted by the running instance
+ */
+bool LocalAntiMicroServer::sendCommand(QLocalSocket *socket, InstanceCommand command,
+                                       QStringList arguments, QString &reply,
+                                       int timeout)
+{
+    bool result = false;
+
+    socket->write(buildCommandFrame(command, arguments));
+    socket->waitForBytesWritten(timeout);
+
+    QByteArray buffer;
+    QByteArray payload;
+    bool invalid = false;
+    bool received = false;
+    while (!received && !invalid && socket->waitForReadyRead(timeout))
+    {
+        buffer.append(socket->readAll());
+        received = takeFrame(buffer, payload, invalid);
+    }
+
+    if (received)
+    {
+        QDataStream stream(payload);
+        stream.setVersion(FRAMESTREAMVERSION);
+        quint32 status = CommandError;
+        stream >> status >> reply;
+        result = (stream.status() == QDataStream::Ok) && (status == CommandOk);
+    }
+    else
+    {
+        reply = tr("No reply from running instance");
+    }
+
+    return result;
+}
@@ -20,6 +20,16 @@
 
 #include <QObject>
 #include <QLocalServer>
+#include <QLocalSocket>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QMap>
+#include <QElapsedTimer>
+
+#include "inputdevice.h"
 
 class LocalAntiMicroServer : public QObject
 {
@@ -27,17 +37,61 @@ class LocalAntiMicroServer : public QObject
 public:
     explicit LocalAntiMicroServer(QObject *parent = 0);
 
+    enum InstanceCommand {
+        LoadProfileCommand = 1, UnloadProfileCommand, SetStartSetCommand,
+        QueryStateCommand, StatsCommand
+    };
+
+    enum CommandStatus {
+        CommandOk = 0, CommandError
+    };
+
+    void setJoysticks(QMap<SDL_JoystickID, InputDevice*> *joysticks);
+
+    static QByteArray buildCommandFrame(InstanceCommand command,
+                                        QStringList arguments=QStringList());
+    static bool sendCommand(QLocalSocket *socket, InstanceCommand command,
+                            QStringList arguments, QString &reply,
+                            int timeout=1000);
+
+    static const int MAXFRAMESIZE;
+
 protected:
+    void processFrames(QLocalSocket *socket);
+    QString executeCommand(int command, QStringList arguments, bool &ok);
+    QString generateStateReport();
+    QString generateStatsReport();
+
+    static QByteArray buildFrame(const QByteArray &payload);
+    static bool takeFrame(QByteArray &buffer, QByteArray &payload, bool &invalid);
+
     QLocalServer *localServer;
+    QMap<SDL_JoystickID, InputDevice*> *joysticks;
+    QHash<QLocalSocket*, QByteArray> socketBuffers;
+    // Clients that have sent at least one command. Clients that only
+    // connect and disconnect use the legacy settings reload path.
+    QSet<QLocalSocket*> commandClients;
+    // Clients with a frame being executed.
+    QSet<QLocalSocket*> processingClients;
+    QElapsedTimer uptime;
+    unsigned int commandCount;
+    bool profileLoadResult;
 
 signals:
     void clientdisconnect();
+    void profileLoadRequested(QString fileLocation, QString controller);
+    void profileUnloadRequested(QString controller);
+    void startSetRequested(unsigned int setNumber, QString controller);
 
 public slots:
     void startLocalServer();
     void handleOutsideConnection();
     void handleSocketDisconnect();
     void close();
+    void setProfileLoadResult(bool loaded);
+
+protected slots:
+    void readSocketData();
 };
 
 #endif // LOCALANTIMICROSERVER_H
@@ -58,6 +58,7 @@
 #include "applaunchhelper.h"
 
 #include "eventhandlerfactory.h"
+#include "processlauncher.h"
 
 #ifndef Q_OS_WIN
 #include <signal.h>
@@ -109,6 +110,96 @@ void deleteInputDevices(QMap<SDL_JoystickID, InputDevice*> *joysticks)
     joysticks->clear();
 }
 
+static bool sendInstanceCommand(QLocalSocket *socket,
+                                LocalAntiMicroServer::InstanceCommand command,
+                                QStringList arguments)
+{
+    QString reply;
+    bool result = LocalAntiMicroServer::sendCommand(socket, command, arguments, reply);
+    if (!result)
+    {
+        Logger::LogError(reply, true, true);
+    }
+    else if (!reply.isEmpty())
+    {
+        Logger::LogInfo(reply, true, true);
+    }
+
+    return result;
+}
+
+static QString instanceControllerString(ControllerOptionsInfo &info)
+{
+    QString result;
+    if (info.hasControllerNumber())
+    {
+        result = QString::number(info.getControllerNumber());
+    }
+    else if (info.hasControllerID())
+    {
+        result = info.getControllerID();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Pass profile changes requested on the command-line to an
+ *     instance that is already running.
+ * @param Socket connected to the running instance
+ * @param Parsed command-line options
+ * @return Exit code
+ */
+static int sendInstanceCommands(QLocalSocket *socket, CommandLineUtility *cmdutility)
+{
+    bool success = true;
+
+    if (cmdutility->hasProfile())
+    {
+        QString controller;
+        if (cmdutility->hasControllerNumber())
+        {
+            controller = QString::number(cmdutility->getControllerNumber());
+        }
+        else if (cmdutility->hasControllerID())
+        {
+            controller = cmdutility->getControllerID();
+        }
+
+        success = sendInstanceCommand(socket, LocalAntiMicroServer::LoadProfileCommand,
+                                      QStringList() << cmdutility->getProfileLocation()
+                                                    << controller) && success;
+    }
+
+    QListIterator<ControllerOptionsInfo> optionIter(*cmdutility->getControllerOptionsList());
+    while (optionIter.hasNext())
+    {
+        ControllerOptionsInfo temp = optionIter.next();
+        QString controller = instanceControllerString(temp);
+
+        if (temp.hasProfile())
+        {
+            success = sendInstanceCommand(socket, LocalAntiMicroServer::LoadProfileCommand,
+                                          QStringList() << temp.getProfileLocation()
+                                                        << controller) && success;
+        }
+        else if (temp.isUnloadRequested())
+        {
+            success = sendInstanceCommand(socket, LocalAntiMicroServer::UnloadProfileCommand,
+                                          QStringList() << controller) && success;
+        }
+
+        if (temp.getStartSetNumber() > 0)
+        {
+            success = sendInstanceCommand(socket, LocalAntiMicroServer::SetStartSetCommand,
+                                          QStringList() << QString::number(temp.getStartSetNumber())
+                                                        << controller) && success;
+        }
+    }
+
+    return success ? 0 : 1;
+}
+
 int main(int argc, char *argv[])
 {
     qRegisterMetaType<JoyButtonSlot*>();
@@ -208,61 +299,22 @@ int main(int argc, char *argv[])
     QMap<SDL_JoystickID, InputDevice*> *joysticks = new QMap<SDL_JoystickID, InputDevice*>();
     QThread *inputEventThread = 0;
 
-    // Cross-platform way of performing IPC. Currently,
-    // only establish a connection and then disconnect.
-    // In the future, there might be a reason to actually send
-    // messages to the QLocalServer.
+    // Cross-platform way of performing IPC. If an instance is already
+    // running, pass the requested profile changes to it as commands.
     QLocalSocket socket;
     socket.connectToServer(PadderCommon::localSocketKey);
     socket.waitForConnected(1000);
     if (socket.state() == QLocalSocket::ConnectedState)
     {
         // An instance of this program is already running.
-        // Save app config and exit.
-        AntiMicroSettings settings(PadderCommon::configFilePath(), QSettings::IniFormat);
-	
-	// Update log info based on config values
-	if( cmdutility.getCurrentLogLevel() == Logger::LOG_NONE &&
-	    settings.contains("LogLevel")) {
-	  appLogger.setLogLevel( (Logger::LogLevel) settings.value("LogLevel").toInt() );
-	}
-	if( cmdutility.getCurrentLogFile().isEmpty() &&
-	    settings.contains("LogFile")) {
-	  appLogger.setCurrentLogFile( settings.value("LogFile").toString() );
-	  appLogger.setCurrentErrorStream(NULL);
-	}
-
-        InputDaemon *joypad_worker = new InputDaemon(joysticks, &settings, false);
-        MainWindow w(joysticks, &cmdutility, &settings, false);
-        w.fillButtons();
-        w.alterConfigFromSettings();
-
-        if (!cmdutility.hasError() &&
-           (cmdutility.hasProfile() || cmdutility.hasProfileInOptions()))
-        {
-            w.saveAppConfig();
-        }
-        else if (!cmdutility.hasError() && cmdutility.isUnloadRequested())
-        {
-            w.saveAppConfig();
-        }
-
-        w.removeJoyTabs();
-        QObject::connect(&a, SIGNAL(aboutToQuit()), joypad_worker, SLOT(quit()));
-        QTimer::singleShot(50, &a, SLOT(quit()));
+        // Send commands and exit.
+        int result = sendInstanceCommands(&socket, &cmdutility);
 
-        int result = a.exec();
-
-        settings.sync();
         socket.disconnectFromServer();
 
-        deleteInputDevices(joysticks);
         delete joysticks;
         joysticks = 0;
 
-        delete joypad_worker;
-        joypad_worker = 0;
-
         return result;
     }
 
@@ -628,6 +680,14 @@ int main(int argc, char *argv[])
     }
 #endif
 
+    // Absolute pointer range is fixed once the event handler creates
+    // its devices.
+    int absPointerResolution = settings->value("Mouse/AbsPointerResolution", 0).toInt();
+    if (absPointerResolution > 0)
+    {
+        BaseEventHandler::setAbsPointerResolution(absPointerResolution);
+    }
+
     bool status = true;
     QString eventGeneratorIdentifier;
     AntKeyMapper *keyMapper = 0;
@@ -714,6 +774,9 @@ int main(int argc, char *argv[])
                           .arg(factory->handler()->getName()));
     }
 
+    // Start the launcher thread before the input thread can ask for it.
+    ProcessLauncher::getInstance();
+
     PadderCommon::mouseHelperObj.initDeskWid();
     InputDaemon *joypad_worker = new InputDaemon(joysticks, settings);
     inputEventThread = new QThread();
@@ -746,6 +809,15 @@ int main(int argc, char *argv[])
     QObject::connect(&a, SIGNAL(aboutToQuit()), &mainAppHelper, SLOT(appQuitPointerPrecision()));
 #endif
     QObject::connect(localServer, SIGNAL(clientdisconnect()), w, SLOT(handleInstanceDisconnect()));
+    QObject::connect(localServer, SIGNAL(profileLoadRequested(QString,QString)),
+                     w, SLOT(loadInstanceProfile(QString,QString)));
+    QObject::connect(w, SIGNAL(instanceProfileLoaded(bool)),
+                     localServer, SLOT(setProfileLoadResult(bool)), Qt::DirectConnection);
+    QObject::connect(localServer, SIGNAL(profileUnloadRequested(QString)),
+                     w, SLOT(unloadInstanceProfile(QString)));
+    QObject::connect(localServer, SIGNAL(startSetRequested(unsigned int,QString)),
+                     w, SLOT(changeInstanceSet(unsigned int,QString)));
+    localServer->setJoysticks(joysticks);
 
 #ifdef USE_SDL_2
     QObject::connect(w, SIGNAL(mappingUpdated(QString,InputDevice*)),
@@ -804,6 +876,7 @@ int main(int argc, char *argv[])
     joysticks = 0;
 
     AntKeyMapper::getInstance()->deleteInstance();
+    ProcessLauncher::deleteInstance();
 
 #if defined(Q_OS_UNIX) && defined(WITH_X11)
     #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
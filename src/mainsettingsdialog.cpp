@@ -244,6 +244,12 @@ MainSettingsDialog::MainSettingsDialog(AntiMicroSettings *settings,
         ui->autoLoadPreviousCheckBox->setChecked(false);
     }
 
+    bool reloadProfiles = settings->value("ReloadChangedProfiles", false).toBool();
+    if (reloadProfiles)
+    {
+        ui->reloadProfilesCheckBox->setChecked(true);
+    }
+
     bool launchInTray = settings->value("LaunchInTray", false).toBool();
     if (launchInTray)
     {
@@ -692,6 +698,9 @@ void MainSettingsDialog::saveNewSettings()
     bool autoOpenLastProfile = ui->autoLoadPreviousCheckBox->isChecked();
     settings->setValue("AutoOpenLastProfile", autoOpenLastProfile ? "1" : "0");
 
+    bool reloadProfiles = ui->reloadProfilesCheckBox->isChecked();
+    settings->setValue("ReloadChangedProfiles", reloadProfiles ? "1" : "0");
+
     bool launchInTray = ui->launchInTrayCheckBox->isChecked();
     settings->setValue("LaunchInTray", launchInTray ? "1" : "0");
 
@@ -805,8 +814,8 @@ void MainSettingsDialog::saveNewSettings()
 
     PadderCommon::unlockInputDevices();
 
-    settings->sync();
     settings->getLock()->unlock();
+    settings->flushSettings();
 }
 
 void MainSettingsDialog::selectDefaultProfileDir()
@@ -448,6 +448,12 @@ void MainWindow::fillButtons(QMap<SDL_JoystickID, InputDevice *> *joysticks)
 // Intermediate slot to be used in Form Designer
 void MainWindow::startJoystickRefresh()
 {
+#ifdef USE_SDL_2
+    // Devices are refreshed in place. Tabs of devices that were added or
+    // removed are updated through the deviceAdded and deviceRemoved
+    // signals. Tabs of other devices stay untouched.
+    emit joystickRefreshRequested();
+#else
     ui->stackedWidget->setCurrentIndex(0);
     ui->actionUpdate_Joysticks->setEnabled(false);
     ui->actionHide->setEnabled(false);
@@ -455,6 +461,7 @@ void MainWindow::startJoystickRefresh()
     removeJoyTabs();
 
     emit joystickRefreshRequested();
+#endif
 }
 
 void MainWindow::populateTrayIcon()
@@ -978,14 +985,23 @@ void MainWindow::openAboutDialog()
     aboutDialog->show();
 }
 
-void MainWindow::loadConfigFile(QString fileLocation, int joystickIndex)
+/**
+ * @brief Load a profile for one controller or for all controllers.
+ * @param Path to the profile
+ * @param Controller number starting at 1. 0 loads the profile for all
+ *     controllers.
+ * @return Whether the profile was loaded for at least one controller
+ */
+bool MainWindow::loadConfigFile(QString fileLocation, int joystickIndex)
 {
+    bool result = false;
+
     if (joystickIndex > 0 && joysticks->contains(joystickIndex-1))
     {
         JoyTabWidget *widget = static_cast<JoyTabWidget*>(ui->tabWidget->widget(joystickIndex-1));
         if (widget)
         {
-            widget->loadConfigFile(fileLocation);
+            result = widget->loadConfigFile(fileLocation);
         }
     }
     else if (joystickIndex <= 0)
@@ -993,16 +1009,20 @@ void MainWindow::loadConfigFile(QString fileLocation, int joystickIndex)
         for (int i=0; i < ui->tabWidget->count(); i++)
         {
             JoyTabWidget *widget = static_cast<JoyTabWidget*>(ui->tabWidget->widget(i));
-            if (widget)
+            if (widget && widget->loadConfigFile(fileLocation))
             {
-                widget->loadConfigFile(fileLocation);
+                result = true;
             }
         }
     }
+
+    return result;
 }
 
-void MainWindow::loadConfigFile(QString fileLocation, QString controllerID)
+bool MainWindow::loadConfigFile(QString fileLocation, QString controllerID)
 {
+    bool result = false;
+
     if (!controllerID.isEmpty())
     {
         QListIterator<JoyTabWidget*> iter(ui->tabWidget->findChildren<JoyTabWidget*>());
@@ -1012,13 +1032,16 @@ void MainWindow::loadConfigFile(QString fileLocation, QString controllerID)
             if (tab)
             {
                 InputDevice *tempdevice = tab->getJoystick();
-                if (controllerID == tempdevice->getStringIdentifier())
+                if (controllerID == tempdevice->getStringIdentifier() &&
+                    tab->loadConfigFile(fileLocation))
                 {
-                    tab->loadConfigFile(fileLocation);
+                    result = true;
                 }
             }
         }
     }
+
+    return result;
 }
 
 void MainWindow::removeJoyTabs()
@@ -1037,10 +1060,83 @@ void MainWindow::removeJoyTabs()
 
 void MainWindow::handleInstanceDisconnect()
 {
+    // Pick up changes written by the other instance.
     settings->sync();
+    settings->flushSettings();
     loadAppConfig(true);
 }
 
+/**
+ * @brief Load a profile requested through the local server.
+ * @param Path to the profile
+ * @param Controller number or identifier. Empty to use all controllers.
+ */
+void MainWindow::loadInstanceProfile(QString fileLocation, QString controller)
+{
+    bool isNumber = false;
+    int joystickIndex = controller.toInt(&isNumber);
+    bool loaded = false;
+
+    if (controller.isEmpty())
+    {
+        loaded = loadConfigFile(fileLocation);
+    }
+    else if (isNumber)
+    {
+        loaded = loadConfigFile(fileLocation, joystickIndex);
+    }
+    else
+    {
+        loaded = loadConfigFile(fileLocation, controller);
+    }
+
+    emit instanceProfileLoaded(loaded);
+}
+
+void MainWindow::unloadInstanceProfile(QString controller)
+{
+    bool isNumber = false;
+    int joystickIndex = controller.toInt(&isNumber);
+
+    if (controller.isEmpty())
+    {
+        unloadCurrentConfig(0);
+    }
+    else if (isNumber)
+    {
+        unloadCurrentConfig(joystickIndex);
+    }
+    else
+    {
+        unloadCurrentConfig(controller);
+    }
+}
+
+/**
+ * @brief Change the active set of a controller through the local server.
+ * @param Set number starting at 1
+ * @param Controller number or identifier. Empty to use all controllers.
+ */
+void MainWindow::changeInstanceSet(unsigned int setNumber, QString controller)
+{
+    bool isNumber = false;
+    unsigned int joystickIndex = controller.toUInt(&isNumber);
+    unsigned int joySetNumber = setNumber > 0 ? setNumber - 1 : 0;
+
+    if (controller.isEmpty())
+    {
+        changeStartSetNumber(joySetNumber);
+    }
+    else if (isNumber)
+    {
+        changeStartSetNumber(joySetNumber, joystickIndex);
+    }
+    else
+    {
+        changeStartSetNumber(joySetNumber, controller);
+    }
+}
+
 void MainWindow::openJoystickStatusWindow()
 {
     int index = ui->tabWidget->currentIndex();
@@ -1209,6 +1305,7 @@ void MainWindow::openMainSettingsDialog()
 
     connect(dialog, SIGNAL(accepted()), this, SLOT(populateTrayIcon()));
     connect(dialog, SIGNAL(accepted()), this, SLOT(checkHideEmptyOption()));
+    connect(dialog, SIGNAL(accepted()), this, SLOT(checkProfileWatchOption()));
 
 #ifdef Q_OS_WIN
     connect(dialog, SIGNAL(accepted()), this, SLOT(checkKeyRepeatOptions()));
@@ -1367,6 +1464,18 @@ void MainWindow::checkHideEmptyOption()
     }
 }
 
+void MainWindow::checkProfileWatchOption()
+{
+    for (int i=0; i < ui->tabWidget->count(); i++)
+    {
+        JoyTabWidget *tab = static_cast<JoyTabWidget*>(ui->tabWidget->widget(i));
+        if (tab)
+        {
+            tab->checkProfileWatchOption();
+        }
+    }
+}
+
 
 #ifdef Q_OS_WIN
 void MainWindow::checkKeyRepeatOptions()
@@ -1502,6 +1611,19 @@ void MainWindow::removeJoyTab(SDL_JoystickID deviceID)
             // the tab before deleting tab.
             ui->tabWidget->disableFlashes(tab->getJoystick());
             ui->tabWidget->removeTab(i);
+
+            // Status windows sample the device from a GUI timer. Stop them
+            // before the device can be deleted in the input thread.
+            QList<JoystickStatusWindow*> statusWindows = findChildren<JoystickStatusWindow*>();
+            for (int j=0; j < statusWindows.size(); j++)
+            {
+                JoystickStatusWindow *statusWindow = statusWindows.at(j);
+                if (statusWindow->getJoystick() == tab->getJoystick())
+                {
+                    statusWindow->stopSampling();
+                }
+            }
+
             QMetaObject::invokeMethod(tab->getJoystick(), "finalRemoval");
             delete tab;
             tab = 0;
@@ -64,8 +64,8 @@ protected:
     virtual void changeEvent(QEvent *event);
     virtual void closeEvent(QCloseEvent *event);
     void retranslateUi();
-    void loadConfigFile(QString fileLocation, int joystickIndex=0);
-    void loadConfigFile(QString fileLocation, QString controllerID);
+    bool loadConfigFile(QString fileLocation, int joystickIndex=0);
+    bool loadConfigFile(QString fileLocation, QString controllerID);
     void unloadCurrentConfig(int joystickIndex=0);
     void unloadCurrentConfig(QString controllerID);
     void changeStartSetNumber(unsigned int startSetNumber, QString controllerID);
@@ -97,6 +97,7 @@ private:
 signals:
     void joystickRefreshRequested();
     void readConfig(int index);
+    void instanceProfileLoaded(bool loaded);
 
 #ifdef USE_SDL_2
     void mappingUpdated(QString mapping, InputDevice *device);
@@ -140,6 +141,9 @@ private slots:
     void populateTrayIcon();
     void openAboutDialog();
     void handleInstanceDisconnect();
+    void loadInstanceProfile(QString fileLocation, QString controller);
+    void unloadInstanceProfile(QString controller);
+    void changeInstanceSet(unsigned int setNumber, QString controller);
     void openJoystickStatusWindow();
     void openKeyCheckerDialog();
     void openGitHubPage();
@@ -149,6 +153,7 @@ private slots:
     void openMainSettingsDialog();
     void showStickAssignmentDialog();
     void checkHideEmptyOption();
+    void checkProfileWatchOption();
 
 #ifdef Q_OS_WIN
     void checkKeyRepeatOptions();
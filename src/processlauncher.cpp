@@ -0,0 +1,250 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QMutexLocker>
+#include <QMetaObject>
+
+#ifdef Q_OS_UNIX
+  #include <QFile>
+  #include <QByteArray>
+  #include <QVector>
+
+  #include <spawn.h>
+  #include <sys/types.h>
+  #include <sys/wait.h>
+
+extern char **environ;
+#else
+  #include <QProcess>
+#endif
+
+#include "processlauncher.h"
+#include "common.h"
+#include "logger.h"
+
+const int ProcessLauncher::MAXQUEUESIZE = 16;
+const int ProcessLauncher::LAUNCHINTERVAL = 100;
+const int ProcessLauncher::REAPINTERVAL = 1000;
+
+ProcessLauncher* ProcessLauncher::_instance = 0;
+QThread* ProcessLauncher::launcherThread = 0;
+QMutex ProcessLauncher::instanceLock;
+
+ProcessLauncher::ProcessLauncher(QObject *parent) :
+    QObject(parent)
+{
+    queueScheduled = false;
+
+    launchTimer = new QTimer(this);
+    launchTimer->setSingleShot(true);
+    connect(launchTimer, SIGNAL(timeout()), this, SLOT(processQueue()));
+
+    reapTimer = new QTimer(this);
+    reapTimer->setInterval(REAPINTERVAL);
+    connect(reapTimer, SIGNAL(timeout()), this, SLOT(reapProcesses()));
+}
+
+/**
+ * @brief Get the launcher, creating it and its thread on first use.
+ *     The instance is created at startup but this stays safe to call
+ *     from the input and GUI threads.
+ * @return Launcher instance
+ */
+ProcessLauncher* ProcessLauncher::getInstance()
+{
+    QMutexLocker tempLocker(&instanceLock);
+    if (!_instance)
+    {
+        launcherThread = new QThread();
+        _instance = new ProcessLauncher();
+        _instance->moveToThread(launcherThread);
+        connect(launcherThread, SIGNAL(finished()), _instance, SLOT(deleteLater()));
+        launcherThread->start(QThread::LowPriority);
+    }
+
+    return _instance;
+}
+
+void ProcessLauncher::deleteInstance()
+{
+    QMutexLocker tempLocker(&instanceLock);
+    if (_instance)
+    {
+        launcherThread->quit();
+        launcherThread->wait();
+        _instance = 0;
+
+        delete launcherThread;
+        launcherThread = 0;
+    }
+}
+
+/**
+ * @brief Queue a program to be started. Safe to call from any thread.
+ * @param Path to program
+ * @param Arguments passed to the program
+ * @return Whether the request was queued. Requests are dropped when
+ *     the queue is full.
+ */
+bool ProcessLauncher::launch(QString program, QStringList arguments)
+{
+    bool result = false;
+
+    QMutexLocker tempLocker(&queueLock);
+    if (pendingLaunches.size() < MAXQUEUESIZE)
+    {
+        LaunchRequest request;
+        request.program = program;
+        request.arguments = arguments;
+        pendingLaunches.enqueue(request);
+        result = true;
+
+        if (!queueScheduled)
+        {
+            queueScheduled = true;
+            QMetaObject::invokeMethod(this, "processQueue", Qt::QueuedConnection);
+        }
+    }
+    else
+    {
+        Logger::LogWarning(tr("Launch queue is full. Not starting %1").arg(program));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Start queued programs. Programs are started at most once every
+ *     LAUNCHINTERVAL ms. Runs in the launcher thread.
+ */
+void ProcessLauncher::processQueue()
+{
+    bool done = false;
+    while (!done)
+    {
+        LaunchRequest request;
+
+        queueLock.lock();
+        if (pendingLaunches.isEmpty())
+        {
+            queueScheduled = false;
+            done = true;
+        }
+        else if (lastLaunchTime.isValid() && lastLaunchTime.elapsed() < LAUNCHINTERVAL)
+        {
+            // Wait for the launch timer to fire before starting another
+            // program. Queue stays scheduled.
+            launchTimer->start(LAUNCHINTERVAL - lastLaunchTime.elapsed());
+            done = true;
+        }
+        else
+        {
+            request = pendingLaunches.dequeue();
+        }
+        queueLock.unlock();
+
+        if (!done)
+        {
+            startProcess(request);
+            lastLaunchTime.restart();
+        }
+    }
+}
+
+bool ProcessLauncher::startProcess(const LaunchRequest &request)
+{
+    bool result = false;
+
+    QString program = request.program;
+    QStringList arguments = request.arguments;
+    if (arguments.isEmpty())
+    {
+        // Slots without separate arguments may hold a full command line
+        // in the program field. Split it like QProcess::startDetached
+        // did for a single command string.
+        QStringList commandLine = PadderCommon::parseArgumentsString(program);
+        if (!commandLine.isEmpty())
+        {
+            program = commandLine.takeFirst();
+            arguments = commandLine;
+        }
+    }
+
+#ifdef Q_OS_UNIX
+    QList<QByteArray> argumentBytes;
+    argumentBytes.append(QFile::encodeName(program));
+    for (int i=0; i < arguments.size(); i++)
+    {
+        argumentBytes.append(arguments.at(i).toLocal8Bit());
+    }
+
+    QVector<char*> argv(argumentBytes.size() + 1);
+    for (int i=0; i < argumentBytes.size(); i++)
+    {
+        argv[i] = argumentBytes[i].data();
+    }
+    argv[argumentBytes.size()] = 0;
+
+    pid_t pid = 0;
+    int status = posix_spawnp(&pid, argv[0], 0, 0, argv.data(), environ);
+    if (status == 0)
+    {
+        runningProcesses.append(pid);
+        if (!reapTimer->isActive())
+        {
+            reapTimer->start();
+        }
+
+        result = true;
+    }
+#else
+    result = QProcess::startDetached(program, arguments);
+#endif
+
+    if (!result)
+    {
+        Logger::LogWarning(tr("Could not start %1").arg(request.program));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Collect the exit status of started programs that have finished
+ *     so they do not remain as zombie processes.
+ */
+void ProcessLauncher::reapProcesses()
+{
+#ifdef Q_OS_UNIX
+    QMutableListIterator<qint64> iter(runningProcesses);
+    while (iter.hasNext())
+    {
+        pid_t pid = static_cast<pid_t>(iter.next());
+        int status = 0;
+        pid_t result = waitpid(pid, &status, WNOHANG);
+        if (result == pid || result < 0)
+        {
+            iter.remove();
+        }
+    }
+#endif
+
+    if (runningProcesses.isEmpty())
+    {
+        reapTimer->stop();
+    }
+}
@@ -0,0 +1,82 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROCESSLAUNCHER_H
+#define PROCESSLAUNCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QQueue>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+
+/**
+ * @brief Starts programs for execute slots from a dedicated thread so
+ *     a slow process launch never delays input processing. Requests are
+ *     kept in a bounded queue and launches are rate limited.
+ */
+class ProcessLauncher : public QObject
+{
+    Q_OBJECT
+public:
+    static ProcessLauncher* getInstance();
+    static void deleteInstance();
+
+    bool launch(QString program, QStringList arguments);
+
+    static const int MAXQUEUESIZE;
+    static const int LAUNCHINTERVAL;
+    static const int REAPINTERVAL;
+
+protected:
+    explicit ProcessLauncher(QObject *parent = 0);
+
+    typedef struct _LaunchRequest
+    {
+        QString program;
+        QStringList arguments;
+    } LaunchRequest;
+
+    bool startProcess(const LaunchRequest &request);
+
+    QQueue<LaunchRequest> pendingLaunches;
+    QMutex queueLock;
+    bool queueScheduled;
+
+    QTimer *launchTimer;
+    QTimer *reapTimer;
+    QElapsedTimer lastLaunchTime;
+    QList<qint64> runningProcesses;
+
+    static ProcessLauncher *_instance;
+    static QThread *launcherThread;
+    static QMutex instanceLock;
+
+signals:
+
+public slots:
+
+protected slots:
+    void processQueue();
+    void reapProcesses();
+};
+
+#endif // PROCESSLAUNCHER_H
@@ -15,12 +15,48 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QtAlgorithms>
+#include <QHashIterator>
+
 #include "qtkeymapperbase.h"
 
 const unsigned int QtKeyMapperBase::customQtKeyPrefix;
 const unsigned int QtKeyMapperBase::customKeyPrefix;
 const unsigned int QtKeyMapperBase::nativeKeyPrefix;
 
+static bool keyMappingLessThan(const QtKeyMapperBase::keyMappingEntry &entry1,
+                               const QtKeyMapperBase::keyMappingEntry &entry2)
+{
+    return entry1.key < entry2.key;
+}
+
+/**
+ * @brief Sort table by key. When a key is listed more than once, the
+ *     entry that was added last is kept.
+ * @param Table to sort in place
+ */
+static void sortMappingTable(QVector<QtKeyMapperBase::keyMappingEntry> &table)
+{
+    qStableSort(table.begin(), table.end(), keyMappingLessThan);
+
+    int current = -1;
+    for (int i=0; i < table.size(); i++)
+    {
+        if (current >= 0 && table.at(current).key == table.at(i).key)
+        {
+            table[current] = table.at(i);
+        }
+        else
+        {
+            current++;
+            table[current] = table.at(i);
+        }
+    }
+
+    table.resize(current + 1);
+    table.squeeze();
+}
+
 QtKeyMapperBase::QtKeyMapperBase(QObject *parent) :
     QObject(parent)
 {
@@ -30,12 +66,130 @@ unsigned int QtKeyMapperBase::returnQtKey(unsigned int key, unsigned int scancod
 {
     Q_UNUSED(scancode);
 
-    return virtualKeyToQtKey.value(key);
+    return findMapping(virtualKeyTable, key);
 }
 
 unsigned int QtKeyMapperBase::returnVirtualKey(unsigned int qkey)
 {
-    return qtKeyToVirtualKey.value(qkey);
+    return findMapping(qtKeyTable, qkey);
+}
+
+/**
+ * @brief Binary search a sorted mapping table.
+ * @param Table sorted by key
+ * @param Key to find
+ * @return Mapped value or 0 if the key is not in the table.
+ */
+unsigned int QtKeyMapperBase::findMapping(const QVector<keyMappingEntry> &table,
+                                          unsigned int key)
+{
+    unsigned int result = 0;
+
+    keyMappingEntry temp;
+    temp.key = key;
+    temp.value = 0;
+
+    QVector<keyMappingEntry>::const_iterator iter =
+            qLowerBound(table.constBegin(), table.constEnd(), temp, keyMappingLessThan);
+    if (iter != table.constEnd() && iter->key == key)
+    {
+        result = iter->value;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Build the lookup tables from a constant list of mappings. Later
+ *     entries take precedence over earlier entries for the same key.
+ * @param Qt key to native key mappings
+ * @param Number of elements in mappings
+ * @param Extra native key to Qt key mappings used in place of the
+ *     values obtained by flipping the first list.
+ * @param Number of elements in overrides
+ */
+void QtKeyMapperBase::buildMappingTables(const keyMappingRange *mappings, unsigned int mappingCount,
+                                         const keyMappingRange *overrides, unsigned int overrideCount)
+{
+    qtKeyTable.clear();
+    virtualKeyTable.clear();
+
+    for (unsigned int i=0; i < mappingCount; i++)
+    {
+        const keyMappingRange &range = mappings[i];
+        for (unsigned int j=0; j < range.count; j++)
+        {
+            keyMappingEntry temp;
+            temp.key = range.qtkey + j;
+            temp.value = range.virtualkey + j;
+            qtKeyTable.append(temp);
+        }
+    }
+
+    sortMappingTable(qtKeyTable);
+
+    // Flip key and value so mapping goes VK -> Qt Key.
+    virtualKeyTable.reserve(qtKeyTable.size() + overrideCount);
+    for (int i=0; i < qtKeyTable.size(); i++)
+    {
+        keyMappingEntry temp;
+        temp.key = qtKeyTable.at(i).value;
+        temp.value = qtKeyTable.at(i).key;
+        virtualKeyTable.append(temp);
+    }
+
+    for (unsigned int i=0; i < overrideCount; i++)
+    {
+        const keyMappingRange &range = overrides[i];
+        for (unsigned int j=0; j < range.count; j++)
+        {
+            keyMappingEntry temp;
+            temp.key = range.virtualkey + j;
+            temp.value = range.qtkey + j;
+            virtualKeyTable.append(temp);
+        }
+    }
+
+    sortMappingTable(virtualKeyTable);
+}
+
+/**
+ * @brief Build the lookup tables from the temporary hashes used by mappers
+ *     that determine their mappings at runtime. The hashes are cleared
+ *     afterwards.
+ */
+void QtKeyMapperBase::buildMappingTablesFromHashes()
+{
+    qtKeyTable.clear();
+    virtualKeyTable.clear();
+
+    qtKeyTable.reserve(qtKeyToVirtualKey.size());
+    QHashIterator<unsigned int, unsigned int> iter(qtKeyToVirtualKey);
+    while (iter.hasNext())
+    {
+        iter.next();
+        keyMappingEntry temp;
+        temp.key = iter.key();
+        temp.value = iter.value();
+        qtKeyTable.append(temp);
+    }
+
+    virtualKeyTable.reserve(virtualKeyToQtKey.size());
+    QHashIterator<unsigned int, unsigned int> iter2(virtualKeyToQtKey);
+    while (iter2.hasNext())
+    {
+        iter2.next();
+        keyMappingEntry temp;
+        temp.key = iter2.key();
+        temp.value = iter2.value();
+        virtualKeyTable.append(temp);
+    }
+
+    sortMappingTable(qtKeyTable);
+    sortMappingTable(virtualKeyTable);
+
+    qtKeyToVirtualKey.clear();
+    virtualKeyToQtKey.clear();
 }
 
 bool QtKeyMapperBase::isModifier(unsigned int qkey)
@@ -20,6 +20,7 @@
 
 #include <QObject>
 #include <QHash>
+#include <QVector>
 
 class QtKeyMapperBase : public QObject
 {
@@ -33,6 +34,21 @@ public:
         unsigned int virtualkey;
     } charKeyInformation;
 
+    typedef struct _keyMappingEntry
+    {
+        unsigned int key;
+        unsigned int value;
+    } keyMappingEntry;
+
+    // Maps count consecutive Qt keys starting at qtkey onto consecutive
+    // native keys starting at virtualkey.
+    typedef struct _keyMappingRange
+    {
+        unsigned int qtkey;
+        unsigned int virtualkey;
+        unsigned int count;
+    } keyMappingRange;
+
     virtual unsigned int returnVirtualKey(unsigned int qkey);
     virtual unsigned int returnQtKey(unsigned int key, unsigned int scancode=0);
     virtual bool isModifier(unsigned int qkey);
@@ -78,9 +94,20 @@ public:
     };
 
 protected:
-    virtual void populateMappingHashes() = 0;
+    virtual void populateMappingTables() = 0;
     virtual void populateCharKeyInformation() = 0;
 
+    void buildMappingTables(const keyMappingRange *mappings, unsigned int mappingCount,
+                            const keyMappingRange *overrides=0, unsigned int overrideCount=0);
+    void buildMappingTablesFromHashes();
+    static unsigned int findMapping(const QVector<keyMappingEntry> &table, unsigned int key);
+
+    // Sorted lookup tables used after the mapper has been populated.
+    QVector<keyMappingEntry> qtKeyTable;
+    QVector<keyMappingEntry> virtualKeyTable;
+
+    // Only used as temporary storage by mappers that need to determine
+    // mappings at runtime. Emptied by buildMappingTablesFromHashes.
     QHash<unsigned int, unsigned int> qtKeyToVirtualKey;
     QHash<unsigned int, unsigned int> virtualKeyToQtKey;
     // Unicode representation -> VK+Modifier information
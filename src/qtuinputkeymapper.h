@@ -30,14 +30,9 @@ public:
     explicit QtUInputKeyMapper(QObject *parent = 0);
 
 protected:
-    void populateMappingHashes();
+    void populateMappingTables();
     void populateCharKeyInformation();
 
-    void populateAlphaHashes();
-    void populateFKeyHashes();
-    void populateNumPadHashes();
-    void populateSpecialCharHashes();
-
 signals:
 
 public slots:
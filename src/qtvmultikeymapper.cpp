@@ -23,12 +23,12 @@ QtVMultiKeyMapper::QtVMultiKeyMapper(QObject *parent) :
     QtKeyMapperBase(parent)
 {
     identifier = "vmulti";
-    populateMappingHashes();
+    populateMappingTables();
 }
 
-void QtVMultiKeyMapper::populateMappingHashes()
+void QtVMultiKeyMapper::populateMappingTables()
 {
-    if (qtKeyToVirtualKey.isEmpty())
+    if (qtKeyTable.isEmpty())
     {
         // Map A - Z keys
         for (int i=0; i <= (Qt::Key_Z - Qt::Key_A); i++)
@@ -172,6 +172,8 @@ void QtVMultiKeyMapper::populateMappingHashes()
             iter.next();
             virtualKeyToQtKey[iter.value()] = iter.key();
         }
+
+        buildMappingTablesFromHashes();
     }
 }
 
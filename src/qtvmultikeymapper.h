@@ -33,7 +33,7 @@ public:
     static const unsigned int consumerUsagePagePrefix = 0x12000;
 
 protected:
-    void populateMappingHashes();
+    void populateMappingTables();
     void populateCharKeyInformation();
 
     //static QtWinKeyMapper nativeKeyMapper;
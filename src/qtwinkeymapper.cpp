@@ -114,13 +114,13 @@ QtWinKeyMapper::QtWinKeyMapper(QObject *parent) :
     QtKeyMapperBase(parent)
 {
     identifier = "sendinput";
-    populateMappingHashes();
+    populateMappingTables();
     populateCharKeyInformation();
 }
 
-void QtWinKeyMapper::populateMappingHashes()
+void QtWinKeyMapper::populateMappingTables()
 {
-    if (qtKeyToVirtualKey.isEmpty())
+    if (qtKeyTable.isEmpty())
     {
         qtKeyToVirtualKey[Qt::Key_Cancel] = VK_CANCEL;
         qtKeyToVirtualKey[Qt::Key_Backspace] = VK_BACK;
@@ -327,12 +327,14 @@ void QtWinKeyMapper::populateMappingHashes()
         virtualKeyToQtKey[VK_SHIFT] = Qt::Key_Shift;
         virtualKeyToQtKey[VK_CONTROL] =  Qt::Key_Control;
         virtualKeyToQtKey[VK_MENU] = Qt::Key_Alt;
+
+        buildMappingTablesFromHashes();
     }
 }
 
 unsigned int QtWinKeyMapper::returnQtKey(unsigned int key, unsigned int scancode)
 {
-    unsigned int tempkey = virtualKeyToQtKey.value(key);
+    unsigned int tempkey = findMapping(virtualKeyTable, key);
     int extended = scancode & WinExtras::EXTENDED_FLAG;
     if (key == VK_RETURN && extended)
     {
@@ -33,7 +33,7 @@ public:
     virtual unsigned int returnQtKey(unsigned int key, unsigned int scancode=0);
 
 protected:
-    void populateMappingHashes();
+    void populateMappingTables();
     void populateCharKeyInformation();
 
 signals:
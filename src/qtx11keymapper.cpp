@@ -22,7 +22,6 @@
 
 //#include <QDebug>
 #include <QApplication>
-#include <QHashIterator>
 
 #include <X11/keysymdef.h>
 #include <X11/XF86keysym.h>
@@ -32,277 +31,253 @@
 #include "qtx11keymapper.h"
 #include "x11extras.h"
 
-QtX11KeyMapper::QtX11KeyMapper(QObject *parent) :
-    QtKeyMapperBase(parent)
-{
-    identifier = "xtest";
-    populateMappingHashes();
-    populateCharKeyInformation();
-}
-
 /*
  * The following mappings are mainly taken from qkeymapper_x11.cpp.
  * There are portions of the mapping that are customized to work around
  * some of the ambiguity introduced with some Qt keys
- * (XK_Alt_L and XK_Alt_R become Qt::Key_Alt in Qt).
+ * (XK_Alt_L and XK_Alt_R become Qt::Key_Alt in Qt). Later entries take
+ * precedence over earlier entries for the same key.
  */
-void QtX11KeyMapper::populateMappingHashes()
-{
-    if (qtKeyToVirtualKey.isEmpty())
-    {
-        // misc keys
-        qtKeyToVirtualKey[Qt::Key_Escape] = XK_Escape;
-        qtKeyToVirtualKey[Qt::Key_Tab] = XK_Tab;
-        qtKeyToVirtualKey[Qt::Key_Backtab] = XK_ISO_Left_Tab;
-        qtKeyToVirtualKey[Qt::Key_Backspace] = XK_BackSpace;
-        qtKeyToVirtualKey[Qt::Key_Return] = XK_Return;
-        qtKeyToVirtualKey[Qt::Key_Insert] = XK_Insert;
-        qtKeyToVirtualKey[Qt::Key_Delete] = XK_Delete;
-        qtKeyToVirtualKey[Qt::Key_Delete] = XK_Delete;
-        //qtKeyToX11KeySym[Qt::Key_Delete] = XK_Clear;
-        qtKeyToVirtualKey[Qt::Key_Pause] = XK_Pause;
-        qtKeyToVirtualKey[Qt::Key_Print] = XK_Print;
-
-        // cursor movement
-        qtKeyToVirtualKey[Qt::Key_Home] = XK_Home;
-        qtKeyToVirtualKey[Qt::Key_End] = XK_End;
-        qtKeyToVirtualKey[Qt::Key_Left] = XK_Left;
-        qtKeyToVirtualKey[Qt::Key_Up] = XK_Up;
-        qtKeyToVirtualKey[Qt::Key_Right] = XK_Right;
-        qtKeyToVirtualKey[Qt::Key_Down] = XK_Down;
-        qtKeyToVirtualKey[Qt::Key_PageUp] = XK_Prior;
-        qtKeyToVirtualKey[Qt::Key_PageDown] = XK_Next;
-
-        // modifiers
-        qtKeyToVirtualKey[Qt::Key_Shift] = XK_Shift_L;
-        //qtKeyToX11KeySym[Qt::Key_Shift] = XK_Shift_R;
-        //qtKeyToX11KeySym[Qt::Key_Shift] = XK_Shift_Lock;
-        qtKeyToVirtualKey[Qt::Key_Control] = XK_Control_L;
-        //qtKeyToX11KeySym[Qt::Key_Control] = XK_Control_R;
-        //qtKeyToVirtualKey[Qt::Key_Meta] = XK_Meta_L;
-        //qtKeyToX11KeySym[Qt::Key_Meta] = XK_Meta_R;
-        qtKeyToVirtualKey[Qt::Key_Alt] = XK_Alt_L;
-        //qtKeyToX11KeySym[Qt::Key_Alt] = XK_Alt_R;
-
-        qtKeyToVirtualKey[Qt::Key_CapsLock] = XK_Caps_Lock;
-        qtKeyToVirtualKey[Qt::Key_NumLock] = XK_Num_Lock;
-        qtKeyToVirtualKey[Qt::Key_ScrollLock] = XK_Scroll_Lock;
-        qtKeyToVirtualKey[Qt::Key_Meta] = XK_Super_L;
-        qtKeyToVirtualKey[AntKey_Meta_R] = XK_Super_R;
-        //qtKeyToVirtualKey[Qt::Key_Super_L] = XK_Super_L;
-        //qtKeyToVirtualKey[Qt::Key_Super_R] = XK_Super_R;
-        qtKeyToVirtualKey[Qt::Key_Menu] = XK_Menu;
-        qtKeyToVirtualKey[Qt::Key_Hyper_L] = XK_Hyper_L;
-        qtKeyToVirtualKey[Qt::Key_Hyper_R] = XK_Hyper_R;
-        qtKeyToVirtualKey[Qt::Key_Help] = XK_Help;
-
-        // numeric and function keypad keys
-        //qtKeyToVirtualKey[Qt::Key_Space] = XK_KP_Space;
-        //qtKeyToX11KeySym[Qt::Key_Tab] = XK_KP_Tab;
-        qtKeyToVirtualKey[Qt::Key_Enter] = XK_KP_Enter;
-        qtKeyToVirtualKey[AntKey_KP_Home] = XK_KP_Home;
-        //qtKeyToX11KeySym[Qt::Key_Home] = XK_KP_Home;
-        qtKeyToVirtualKey[AntKey_KP_Left] = XK_KP_Left;
-        qtKeyToVirtualKey[AntKey_KP_Up] = XK_KP_Up;
-        qtKeyToVirtualKey[AntKey_KP_Right] = XK_KP_Right;
-        qtKeyToVirtualKey[AntKey_KP_Down] = XK_KP_Down;
-        qtKeyToVirtualKey[AntKey_KP_Prior] = XK_KP_Prior;
-        qtKeyToVirtualKey[AntKey_KP_Next] = XK_KP_Next;
-        qtKeyToVirtualKey[AntKey_KP_End] = XK_KP_End;
-        qtKeyToVirtualKey[AntKey_KP_Begin] = XK_KP_Begin;
-        qtKeyToVirtualKey[AntKey_KP_Insert] = XK_KP_Insert;
-        qtKeyToVirtualKey[AntKey_KP_Delete] = XK_KP_Delete;
-        //qtKeyToX11KeySym[AntKey_KP_Equal] = XK_KP_Equal;
-        qtKeyToVirtualKey[AntKey_KP_Add] = XK_KP_Add;
-        //qtKeyToX11KeySym[AntKey_KP_Separator] = XK_KP_Separator;
-        qtKeyToVirtualKey[AntKey_KP_Subtract] = XK_KP_Subtract;
-
-        qtKeyToVirtualKey[AntKey_KP_Decimal] = XK_KP_Decimal;
-        qtKeyToVirtualKey[AntKey_KP_Divide] = XK_KP_Divide;
-
-        // International input method support keys
-
-        // International & multi-key character composition
-        qtKeyToVirtualKey[Qt::Key_AltGr] = XK_ISO_Level3_Shift;
-        qtKeyToVirtualKey[Qt::Key_Multi_key] = XK_Multi_key;
-        qtKeyToVirtualKey[Qt::Key_Codeinput] = XK_Codeinput;
-        qtKeyToVirtualKey[Qt::Key_SingleCandidate] = XK_SingleCandidate;
-        qtKeyToVirtualKey[Qt::Key_MultipleCandidate] = XK_MultipleCandidate;
-        qtKeyToVirtualKey[Qt::Key_PreviousCandidate] = XK_PreviousCandidate;
-
-        // Misc Functions
-        qtKeyToVirtualKey[Qt::Key_Mode_switch] = XK_Mode_switch;
-        //qtKeyToX11KeySym[Qt::Key_Mode_switch] = XK_script_switch;
-
-        // Japanese keyboard support
-        qtKeyToVirtualKey[Qt::Key_Kanji] = XK_Kanji;
-        qtKeyToVirtualKey[Qt::Key_Muhenkan] = XK_Muhenkan;
-        qtKeyToVirtualKey[Qt::Key_Henkan] = XK_Henkan_Mode;
-        //qtKeyToX11KeySym[Qt::Key_Henkan] = XK_Henkan;
-        qtKeyToVirtualKey[Qt::Key_Romaji] = XK_Romaji;
-        qtKeyToVirtualKey[Qt::Key_Hiragana] = XK_Hiragana;
-        qtKeyToVirtualKey[Qt::Key_Katakana] = XK_Katakana;
-        qtKeyToVirtualKey[Qt::Key_Hiragana_Katakana] = XK_Hiragana_Katakana;
-        qtKeyToVirtualKey[Qt::Key_Zenkaku] = XK_Zenkaku;
-        qtKeyToVirtualKey[Qt::Key_Hankaku] = XK_Hankaku;
-        qtKeyToVirtualKey[Qt::Key_Zenkaku_Hankaku] = XK_Zenkaku_Hankaku;
-        qtKeyToVirtualKey[Qt::Key_Touroku] = XK_Touroku;
-        qtKeyToVirtualKey[Qt::Key_Massyo] = XK_Massyo;
-        qtKeyToVirtualKey[Qt::Key_Kana_Lock] = XK_Kana_Lock;
-        qtKeyToVirtualKey[Qt::Key_Kana_Shift] = XK_Kana_Shift;
-        qtKeyToVirtualKey[Qt::Key_Eisu_Shift] = XK_Eisu_Shift;
-        qtKeyToVirtualKey[Qt::Key_Eisu_toggle] = XK_Eisu_toggle;
-        qtKeyToVirtualKey[Qt::Key_Codeinput] = XK_Kanji_Bangou;
-        //qtKeyToX11KeySym[Qt::Key_MultipleCandidate] = XK_Zen_Koho;
-        //qtKeyToX11KeySym[Qt::Key_PreviousCandidate] = XK_Mae_Koho;
+static const QtKeyMapperBase::keyMappingRange x11KeyMappings[] = {
+    // misc keys
+    {Qt::Key_Escape, XK_Escape, 1},
+    {Qt::Key_Tab, XK_Tab, 1},
+    {Qt::Key_Backtab, XK_ISO_Left_Tab, 1},
+    {Qt::Key_Backspace, XK_BackSpace, 1},
+    {Qt::Key_Return, XK_Return, 1},
+    {Qt::Key_Insert, XK_Insert, 1},
+    {Qt::Key_Delete, XK_Delete, 1},
+    {Qt::Key_Delete, XK_Delete, 1},
+    //qtKeyToX11KeySym[Qt::Key_Delete] = XK_Clear;
+    {Qt::Key_Pause, XK_Pause, 1},
+    {Qt::Key_Print, XK_Print, 1},
+
+    // cursor movement
+    {Qt::Key_Home, XK_Home, 1},
+    {Qt::Key_End, XK_End, 1},
+    {Qt::Key_Left, XK_Left, 1},
+    {Qt::Key_Up, XK_Up, 1},
+    {Qt::Key_Right, XK_Right, 1},
+    {Qt::Key_Down, XK_Down, 1},
+    {Qt::Key_PageUp, XK_Prior, 1},
+    {Qt::Key_PageDown, XK_Next, 1},
+
+    // modifiers
+    {Qt::Key_Shift, XK_Shift_L, 1},
+    //qtKeyToX11KeySym[Qt::Key_Shift] = XK_Shift_R;
+    //qtKeyToX11KeySym[Qt::Key_Shift] = XK_Shift_Lock;
+    {Qt::Key_Control, XK_Control_L, 1},
+    //qtKeyToX11KeySym[Qt::Key_Control] = XK_Control_R;
+    //qtKeyToVirtualKey[Qt::Key_Meta] = XK_Meta_L;
+    //qtKeyToX11KeySym[Qt::Key_Meta] = XK_Meta_R;
+    {Qt::Key_Alt, XK_Alt_L, 1},
+    //qtKeyToX11KeySym[Qt::Key_Alt] = XK_Alt_R;
+
+    {Qt::Key_CapsLock, XK_Caps_Lock, 1},
+    {Qt::Key_NumLock, XK_Num_Lock, 1},
+    {Qt::Key_ScrollLock, XK_Scroll_Lock, 1},
+    {Qt::Key_Meta, XK_Super_L, 1},
+    {QtKeyMapperBase::AntKey_Meta_R, XK_Super_R, 1},
+    //qtKeyToVirtualKey[Qt::Key_Super_L] = XK_Super_L;
+    //qtKeyToVirtualKey[Qt::Key_Super_R] = XK_Super_R;
+    {Qt::Key_Menu, XK_Menu, 1},
+    {Qt::Key_Hyper_L, XK_Hyper_L, 1},
+    {Qt::Key_Hyper_R, XK_Hyper_R, 1},
+    {Qt::Key_Help, XK_Help, 1},
+
+    // numeric and function keypad keys
+    //qtKeyToVirtualKey[Qt::Key_Space] = XK_KP_Space;
+    //qtKeyToX11KeySym[Qt::Key_Tab] = XK_KP_Tab;
+    {Qt::Key_Enter, XK_KP_Enter, 1},
+    {QtKeyMapperBase::AntKey_KP_Home, XK_KP_Home, 1},
+    //qtKeyToX11KeySym[Qt::Key_Home] = XK_KP_Home;
+    {QtKeyMapperBase::AntKey_KP_Left, XK_KP_Left, 1},
+    {QtKeyMapperBase::AntKey_KP_Up, XK_KP_Up, 1},
+    {QtKeyMapperBase::AntKey_KP_Right, XK_KP_Right, 1},
+    {QtKeyMapperBase::AntKey_KP_Down, XK_KP_Down, 1},
+    {QtKeyMapperBase::AntKey_KP_Prior, XK_KP_Prior, 1},
+    {QtKeyMapperBase::AntKey_KP_Next, XK_KP_Next, 1},
+    {QtKeyMapperBase::AntKey_KP_End, XK_KP_End, 1},
+    {QtKeyMapperBase::AntKey_KP_Begin, XK_KP_Begin, 1},
+    {QtKeyMapperBase::AntKey_KP_Insert, XK_KP_Insert, 1},
+    {QtKeyMapperBase::AntKey_KP_Delete, XK_KP_Delete, 1},
+    //qtKeyToX11KeySym[AntKey_KP_Equal] = XK_KP_Equal;
+    {QtKeyMapperBase::AntKey_KP_Add, XK_KP_Add, 1},
+    //qtKeyToX11KeySym[AntKey_KP_Separator] = XK_KP_Separator;
+    {QtKeyMapperBase::AntKey_KP_Subtract, XK_KP_Subtract, 1},
+
+    {QtKeyMapperBase::AntKey_KP_Decimal, XK_KP_Decimal, 1},
+    {QtKeyMapperBase::AntKey_KP_Divide, XK_KP_Divide, 1},
+
+    // International input method support keys
+
+    // International & multi-key character composition
+    {Qt::Key_AltGr, XK_ISO_Level3_Shift, 1},
+    {Qt::Key_Multi_key, XK_Multi_key, 1},
+    {Qt::Key_Codeinput, XK_Codeinput, 1},
+    {Qt::Key_SingleCandidate, XK_SingleCandidate, 1},
+    {Qt::Key_MultipleCandidate, XK_MultipleCandidate, 1},
+    {Qt::Key_PreviousCandidate, XK_PreviousCandidate, 1},
+
+    // Misc Functions
+    {Qt::Key_Mode_switch, XK_Mode_switch, 1},
+    //qtKeyToX11KeySym[Qt::Key_Mode_switch] = XK_script_switch;
+
+    // Japanese keyboard support
+    {Qt::Key_Kanji, XK_Kanji, 1},
+    {Qt::Key_Muhenkan, XK_Muhenkan, 1},
+    {Qt::Key_Henkan, XK_Henkan_Mode, 1},
+    //qtKeyToX11KeySym[Qt::Key_Henkan] = XK_Henkan;
+    {Qt::Key_Romaji, XK_Romaji, 1},
+    {Qt::Key_Hiragana, XK_Hiragana, 1},
+    {Qt::Key_Katakana, XK_Katakana, 1},
+    {Qt::Key_Hiragana_Katakana, XK_Hiragana_Katakana, 1},
+    {Qt::Key_Zenkaku, XK_Zenkaku, 1},
+    {Qt::Key_Hankaku, XK_Hankaku, 1},
+    {Qt::Key_Zenkaku_Hankaku, XK_Zenkaku_Hankaku, 1},
+    {Qt::Key_Touroku, XK_Touroku, 1},
+    {Qt::Key_Massyo, XK_Massyo, 1},
+    {Qt::Key_Kana_Lock, XK_Kana_Lock, 1},
+    {Qt::Key_Kana_Shift, XK_Kana_Shift, 1},
+    {Qt::Key_Eisu_Shift, XK_Eisu_Shift, 1},
+    {Qt::Key_Eisu_toggle, XK_Eisu_toggle, 1},
+    {Qt::Key_Codeinput, XK_Kanji_Bangou, 1},
+    //qtKeyToX11KeySym[Qt::Key_MultipleCandidate] = XK_Zen_Koho;
+    //qtKeyToX11KeySym[Qt::Key_PreviousCandidate] = XK_Mae_Koho;
 
 #ifdef XK_KOREAN
-        qtKeyToVirtualKey[Qt::Key_Hangul] = XK_Hangul;
-        qtKeyToVirtualKey[Qt::Key_Hangul_Start] = XK_Hangul_Start;
-        qtKeyToVirtualKey[Qt::Key_Hangul_End] = XK_Hangul_End;
-        qtKeyToVirtualKey[Qt::Key_Hangul_Hanja] = XK_Hangul_Hanja;
-        qtKeyToVirtualKey[Qt::Key_Hangul_Jamo] = XK_Hangul_Jamo;
-        qtKeyToVirtualKey[Qt::Key_Hangul_Romaja] = XK_Hangul_Romaja;
-        //qtKeyToX11KeySym[Qt::Key_Codeinput] = XK_Hangul_Codeinput;
-        qtKeyToVirtualKey[Qt::Key_Hangul_Jeonja] = XK_Hangul_Jeonja;
-        qtKeyToVirtualKey[Qt::Key_Hangul_Banja] = XK_Hangul_Banja;
-        qtKeyToVirtualKey[Qt::Key_Hangul_PreHanja] = XK_Hangul_PreHanja;
-        qtKeyToVirtualKey[Qt::Key_Hangul_PostHanja] = XK_Hangul_PostHanja;
-        //qtKeyToX11KeySym[Qt::Key_SingleCandidate] = XK_Hangul_SingleCandidate;
-        //qtKeyToX11KeySym[Qt::Key_MultipleCandidate] = XK_Hangul_MultipleCandidate;
-        //qtKeyToX11KeySym[Qt::Key_PreviousCandidate] = XK_Hangul_PreviousCandidate;
-        qtKeyToVirtualKey[Qt::Key_Hangul_Special] = XK_Hangul_Special;
-        //qtKeyToX11KeySym[Qt::Key_Mode_switch] = XK_Hangul_switch;
+    {Qt::Key_Hangul, XK_Hangul, 1},
+    {Qt::Key_Hangul_Start, XK_Hangul_Start, 1},
+    {Qt::Key_Hangul_End, XK_Hangul_End, 1},
+    {Qt::Key_Hangul_Hanja, XK_Hangul_Hanja, 1},
+    {Qt::Key_Hangul_Jamo, XK_Hangul_Jamo, 1},
+    {Qt::Key_Hangul_Romaja, XK_Hangul_Romaja, 1},
+    //qtKeyToX11KeySym[Qt::Key_Codeinput] = XK_Hangul_Codeinput;
+    {Qt::Key_Hangul_Jeonja, XK_Hangul_Jeonja, 1},
+    {Qt::Key_Hangul_Banja, XK_Hangul_Banja, 1},
+    {Qt::Key_Hangul_PreHanja, XK_Hangul_PreHanja, 1},
+    {Qt::Key_Hangul_PostHanja, XK_Hangul_PostHanja, 1},
+    //qtKeyToX11KeySym[Qt::Key_SingleCandidate] = XK_Hangul_SingleCandidate;
+    //qtKeyToX11KeySym[Qt::Key_MultipleCandidate] = XK_Hangul_MultipleCandidate;
+    //qtKeyToX11KeySym[Qt::Key_PreviousCandidate] = XK_Hangul_PreviousCandidate;
+    {Qt::Key_Hangul_Special, XK_Hangul_Special, 1},
+    //qtKeyToX11KeySym[Qt::Key_Mode_switch] = XK_Hangul_switch;
 
 #endif // XK_KOREAN
 
-        // dead keys
-        qtKeyToVirtualKey[Qt::Key_Dead_Grave] = XK_dead_grave;
-        qtKeyToVirtualKey[Qt::Key_Dead_Acute] = XK_dead_acute;
-        qtKeyToVirtualKey[Qt::Key_Dead_Circumflex] = XK_dead_circumflex;
-        qtKeyToVirtualKey[Qt::Key_Dead_Tilde] = XK_dead_tilde;
-        qtKeyToVirtualKey[Qt::Key_Dead_Macron] = XK_dead_macron;
-        qtKeyToVirtualKey[Qt::Key_Dead_Breve] = XK_dead_breve;
-        qtKeyToVirtualKey[Qt::Key_Dead_Abovedot] = XK_dead_abovedot;
-        qtKeyToVirtualKey[Qt::Key_Dead_Diaeresis] = XK_dead_diaeresis;
-        qtKeyToVirtualKey[Qt::Key_Dead_Abovering] = XK_dead_abovering;
-        qtKeyToVirtualKey[Qt::Key_Dead_Doubleacute] = XK_dead_doubleacute;
-        qtKeyToVirtualKey[Qt::Key_Dead_Caron] = XK_dead_caron;
-        qtKeyToVirtualKey[Qt::Key_Dead_Cedilla] = XK_dead_cedilla;
-        qtKeyToVirtualKey[Qt::Key_Dead_Ogonek] = XK_dead_ogonek;
-        qtKeyToVirtualKey[Qt::Key_Dead_Iota] = XK_dead_iota;
-        qtKeyToVirtualKey[Qt::Key_Dead_Voiced_Sound] = XK_dead_voiced_sound;
-        qtKeyToVirtualKey[Qt::Key_Dead_Semivoiced_Sound] = XK_dead_semivoiced_sound;
-        qtKeyToVirtualKey[Qt::Key_Dead_Belowdot] = XK_dead_belowdot;
-        qtKeyToVirtualKey[Qt::Key_Dead_Hook] = XK_dead_hook;
-        qtKeyToVirtualKey[Qt::Key_Dead_Horn] = XK_dead_horn;
-
-        // Special multimedia keys
-        // currently only tested with MS internet keyboard
-
-        // browsing keys
-        qtKeyToVirtualKey[Qt::Key_Back] = XF86XK_Back;
-        qtKeyToVirtualKey[Qt::Key_Forward] = XF86XK_Forward;
-        qtKeyToVirtualKey[Qt::Key_Stop] = XF86XK_Stop;
-        qtKeyToVirtualKey[Qt::Key_Refresh] = XF86XK_Refresh;
-        qtKeyToVirtualKey[Qt::Key_Favorites] = XF86XK_Favorites;
-        qtKeyToVirtualKey[Qt::Key_LaunchMedia] = XF86XK_AudioMedia;
-        qtKeyToVirtualKey[Qt::Key_OpenUrl] = XF86XK_OpenURL;
-        qtKeyToVirtualKey[Qt::Key_HomePage] = XF86XK_HomePage;
-        qtKeyToVirtualKey[Qt::Key_Search] = XF86XK_Search;
-
-        // media keys
-        qtKeyToVirtualKey[Qt::Key_VolumeDown] = XF86XK_AudioLowerVolume;
-        qtKeyToVirtualKey[Qt::Key_VolumeMute] = XF86XK_AudioMute;
-        qtKeyToVirtualKey[Qt::Key_VolumeUp] = XF86XK_AudioRaiseVolume;
-        qtKeyToVirtualKey[Qt::Key_MediaPlay] = XF86XK_AudioPlay;
-        qtKeyToVirtualKey[Qt::Key_MediaStop] = XF86XK_AudioStop;
-        qtKeyToVirtualKey[Qt::Key_MediaPrevious] = XF86XK_AudioPrev;
-        qtKeyToVirtualKey[Qt::Key_MediaNext] = XF86XK_AudioNext;
-        qtKeyToVirtualKey[Qt::Key_MediaRecord] = XF86XK_AudioRecord;
-
-        // launch keys
-        qtKeyToVirtualKey[Qt::Key_LaunchMail] = XF86XK_Mail;
-        qtKeyToVirtualKey[Qt::Key_Launch0] = XF86XK_MyComputer;
-        qtKeyToVirtualKey[Qt::Key_Launch1] = XF86XK_Calculator;
-        qtKeyToVirtualKey[Qt::Key_Standby] = XF86XK_Standby;
-
-        qtKeyToVirtualKey[Qt::Key_Launch2] = XF86XK_Launch0;
-        qtKeyToVirtualKey[Qt::Key_Launch3] = XF86XK_Launch1;
-        qtKeyToVirtualKey[Qt::Key_Launch4] = XF86XK_Launch2;
-        qtKeyToVirtualKey[Qt::Key_Launch5] = XF86XK_Launch3;
-        qtKeyToVirtualKey[Qt::Key_Launch6] = XF86XK_Launch4;
-        qtKeyToVirtualKey[Qt::Key_Launch7] = XF86XK_Launch5;
-        qtKeyToVirtualKey[Qt::Key_Launch8] = XF86XK_Launch6;
-        qtKeyToVirtualKey[Qt::Key_Launch9] = XF86XK_Launch7;
-        qtKeyToVirtualKey[Qt::Key_LaunchA] = XF86XK_Launch8;
-        qtKeyToVirtualKey[Qt::Key_LaunchB] = XF86XK_Launch9;
-        qtKeyToVirtualKey[Qt::Key_LaunchC] = XF86XK_LaunchA;
-        qtKeyToVirtualKey[Qt::Key_LaunchD] = XF86XK_LaunchB;
-        qtKeyToVirtualKey[Qt::Key_LaunchE] = XF86XK_LaunchC;
-        qtKeyToVirtualKey[Qt::Key_LaunchF] = XF86XK_LaunchD;
-
-        // Map initial ASCII keys
-        for (int i=0; i <= (XK_at - XK_space); i++)
-        {
-            qtKeyToVirtualKey[Qt::Key_Space + i] = XK_space + i;
-        }
-
-        // Map lowercase alpha keys
-        for (int i=0; i <= (XK_z - XK_a); i++)
-        {
-            qtKeyToVirtualKey[Qt::Key_A + i] = XK_a + i;
-        }
-
-        // Map [ to ` ASCII keys
-        for (int i=0; i <= (XK_grave - XK_bracketleft); i++)
-        {
-            qtKeyToVirtualKey[Qt::Key_BracketLeft + i] = XK_bracketleft + i;
-        }
-
-        // Map { to ~ ASCII keys
-        for (int i=0; i <= (XK_asciitilde - XK_braceleft); i++)
-        {
-            qtKeyToVirtualKey[Qt::Key_BraceLeft + i] = XK_braceleft + i;
-        }
-
-        // Map function keys
-        for (int i=0; i <= (XK_F35 - XK_F1); i++)
-        {
-            qtKeyToVirtualKey[Qt::Key_F1 + i] = XK_F1 + i;
-        }
-
-        // Misc
-        //qtKeyToVirtualKey[Qt::KeyBri]
+    // dead keys
+    {Qt::Key_Dead_Grave, XK_dead_grave, 1},
+    {Qt::Key_Dead_Acute, XK_dead_acute, 1},
+    {Qt::Key_Dead_Circumflex, XK_dead_circumflex, 1},
+    {Qt::Key_Dead_Tilde, XK_dead_tilde, 1},
+    {Qt::Key_Dead_Macron, XK_dead_macron, 1},
+    {Qt::Key_Dead_Breve, XK_dead_breve, 1},
+    {Qt::Key_Dead_Abovedot, XK_dead_abovedot, 1},
+    {Qt::Key_Dead_Diaeresis, XK_dead_diaeresis, 1},
+    {Qt::Key_Dead_Abovering, XK_dead_abovering, 1},
+    {Qt::Key_Dead_Doubleacute, XK_dead_doubleacute, 1},
+    {Qt::Key_Dead_Caron, XK_dead_caron, 1},
+    {Qt::Key_Dead_Cedilla, XK_dead_cedilla, 1},
+    {Qt::Key_Dead_Ogonek, XK_dead_ogonek, 1},
+    {Qt::Key_Dead_Iota, XK_dead_iota, 1},
+    {Qt::Key_Dead_Voiced_Sound, XK_dead_voiced_sound, 1},
+    {Qt::Key_Dead_Semivoiced_Sound, XK_dead_semivoiced_sound, 1},
+    {Qt::Key_Dead_Belowdot, XK_dead_belowdot, 1},
+    {Qt::Key_Dead_Hook, XK_dead_hook, 1},
+    {Qt::Key_Dead_Horn, XK_dead_horn, 1},
+
+    // Special multimedia keys
+    // currently only tested with MS internet keyboard
+
+    // browsing keys
+    {Qt::Key_Back, XF86XK_Back, 1},
+    {Qt::Key_Forward, XF86XK_Forward, 1},
+    {Qt::Key_Stop, XF86XK_Stop, 1},
+    {Qt::Key_Refresh, XF86XK_Refresh, 1},
+    {Qt::Key_Favorites, XF86XK_Favorites, 1},
+    {Qt::Key_LaunchMedia, XF86XK_AudioMedia, 1},
+    {Qt::Key_OpenUrl, XF86XK_OpenURL, 1},
+    {Qt::Key_HomePage, XF86XK_HomePage, 1},
+    {Qt::Key_Search, XF86XK_Search, 1},
+
+    // media keys
+    {Qt::Key_VolumeDown, XF86XK_AudioLowerVolume, 1},
+    {Qt::Key_VolumeMute, XF86XK_AudioMute, 1},
+    {Qt::Key_VolumeUp, XF86XK_AudioRaiseVolume, 1},
+    {Qt::Key_MediaPlay, XF86XK_AudioPlay, 1},
+    {Qt::Key_MediaStop, XF86XK_AudioStop, 1},
+    {Qt::Key_MediaPrevious, XF86XK_AudioPrev, 1},
+    {Qt::Key_MediaNext, XF86XK_AudioNext, 1},
+    {Qt::Key_MediaRecord, XF86XK_AudioRecord, 1},
+
+    // launch keys
+    {Qt::Key_LaunchMail, XF86XK_Mail, 1},
+    {Qt::Key_Launch0, XF86XK_MyComputer, 1},
+    {Qt::Key_Launch1, XF86XK_Calculator, 1},
+    {Qt::Key_Standby, XF86XK_Standby, 1},
+
+    {Qt::Key_Launch2, XF86XK_Launch0, 1},
+    {Qt::Key_Launch3, XF86XK_Launch1, 1},
+    {Qt::Key_Launch4, XF86XK_Launch2, 1},
+    {Qt::Key_Launch5, XF86XK_Launch3, 1},
+    {Qt::Key_Launch6, XF86XK_Launch4, 1},
+    {Qt::Key_Launch7, XF86XK_Launch5, 1},
+    {Qt::Key_Launch8, XF86XK_Launch6, 1},
+    {Qt::Key_Launch9, XF86XK_Launch7, 1},
+    {Qt::Key_LaunchA, XF86XK_Launch8, 1},
+    {Qt::Key_LaunchB, XF86XK_Launch9, 1},
+    {Qt::Key_LaunchC, XF86XK_LaunchA, 1},
+    {Qt::Key_LaunchD, XF86XK_LaunchB, 1},
+    {Qt::Key_LaunchE, XF86XK_LaunchC, 1},
+    {Qt::Key_LaunchF, XF86XK_LaunchD, 1},
+    // Map initial ASCII keys
+    {Qt::Key_Space, XK_space, (XK_at - XK_space) + 1},
+
+    // Map lowercase alpha keys
+    {Qt::Key_A, XK_a, (XK_z - XK_a) + 1},
+
+    // Map [ to ` ASCII keys
+    {Qt::Key_BracketLeft, XK_bracketleft, (XK_grave - XK_bracketleft) + 1},
+
+    // Map { to ~ ASCII keys
+    {Qt::Key_BraceLeft, XK_braceleft, (XK_asciitilde - XK_braceleft) + 1},
+
+    // Map function keys
+    {Qt::Key_F1, XK_F1, (XK_F35 - XK_F1) + 1},
+
+    // Misc
+    //qtKeyToVirtualKey[Qt::KeyBri]
+
+    // Map custom defined keys
+    {QtKeyMapperBase::AntKey_Shift_R, XK_Shift_R, 1},
+    {QtKeyMapperBase::AntKey_Control_R, XK_Control_R, 1},
+    //qtKeyToX11KeySym[AntKey_Shift_Lock] = XK_Shift_Lock;
+    //qtKeyToVirtualKey[AntKey_Meta_R] = XK_Meta_R;
+    {QtKeyMapperBase::AntKey_Alt_R, XK_Alt_R, 1},
+    {QtKeyMapperBase::AntKey_KP_Multiply, XK_KP_Multiply, 1},
+
+    // Map 0 to 9
+    {QtKeyMapperBase::AntKey_KP_0, XK_KP_0, (XK_KP_9 - XK_KP_0) + 1},
+
+    // Map lower-case latin characters to their capital equivalents
+    {Qt::Key_Agrave, XK_agrave, (XK_odiaeresis - XK_agrave) + 1},
+    {Qt::Key_Ooblique, XK_oslash, (XK_thorn - XK_oslash) + 1}
+};
 
-        // Map custom defined keys
-        qtKeyToVirtualKey[AntKey_Shift_R] = XK_Shift_R;
-        qtKeyToVirtualKey[AntKey_Control_R] = XK_Control_R;
-        //qtKeyToX11KeySym[AntKey_Shift_Lock] = XK_Shift_Lock;
-        //qtKeyToVirtualKey[AntKey_Meta_R] = XK_Meta_R;
-        qtKeyToVirtualKey[AntKey_Alt_R] = XK_Alt_R;
-        qtKeyToVirtualKey[AntKey_KP_Multiply] = XK_KP_Multiply;
-
-	// Map 0 to 9
-        for (int i=0; i <= (XK_KP_9 - XK_KP_0); i++)
-        {
-            qtKeyToVirtualKey[AntKey_KP_0 + i] = XK_KP_0 + i;
-        }
-
-	// Map lower-case latin characters to their capital equivalents
-	for( int i=0; i <= (XK_odiaeresis - XK_agrave); i++) {
-	  qtKeyToVirtualKey[ Qt::Key_Agrave + i ] = XK_agrave + i;
-	}
-	for( int i=0; i <= (XK_thorn - XK_oslash); i++) {
-	  qtKeyToVirtualKey[ Qt::Key_Ooblique + i ] = XK_oslash + i;
-	}
+QtX11KeyMapper::QtX11KeyMapper(QObject *parent) :
+    QtKeyMapperBase(parent)
+{
+    identifier = "xtest";
+    populateMappingTables();
+    populateCharKeyInformation();
+}
 
-        QHashIterator<unsigned int, unsigned int> iter(qtKeyToVirtualKey);
-        while (iter.hasNext())
-        {
-            iter.next();
-            virtualKeyToQtKey[iter.value()] = iter.key();
-        }
+void QtX11KeyMapper::populateMappingTables()
+{
+    if (qtKeyTable.isEmpty())
+    {
+        buildMappingTables(x11KeyMappings,
+                           sizeof(x11KeyMappings) / sizeof(x11KeyMappings[0]));
     }
 }
 
@@ -31,7 +31,7 @@ public:
     explicit QtX11KeyMapper(QObject *parent = 0);
 
 protected:
-    void populateMappingHashes();
+    void populateMappingTables();
     void populateCharKeyInformation();
 
 signals:
@@ -30,10 +30,8 @@ SDLEventReader::SDLEventReader(QMap<SDL_JoystickID, InputDevice *> *joysticks,
 {
     this->joysticks = joysticks;
     this->settings = settings;
-    settings->getLock()->lock();
-    this->pollRate = settings->value("GamepadPollRate",
-                                     AntiMicroSettings::defaultSDLGamepadPollRate).toUInt();
-    settings->getLock()->unlock();
+    this->pollRate = settings->cachedValue("GamepadPollRate",
+                                           AntiMicroSettings::defaultSDLGamepadPollRate).toUInt();
 
     pollRateTimer.setParent(this);
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
@@ -68,27 +66,8 @@ void SDLEventReader::initSDL()
     sdlIsOpen = true;
 
 #ifdef USE_SDL_2
-    //QSettings settings(PadderCommon::configFilePath, QSettings::IniFormat);
-    settings->getLock()->lock();
-    settings->beginGroup("Mappings");
-    QStringList mappings = settings->allKeys();
-    QStringListIterator iter(mappings);
-    while (iter.hasNext())
-    {
-        QString tempstring = iter.next();
-        QString mappingSetting = settings->value(tempstring, QString()).toString();
-        if (!mappingSetting.isEmpty())
-        {
-            QByteArray temparray = mappingSetting.toUtf8();
-            char *mapping = temparray.data();
-            SDL_GameControllerAddMapping(mapping); // Let SDL take care of validation
-        }
-    }
-
-    settings->endGroup();
-    settings->getLock()->unlock();
-
-    //SDL_GameControllerAddMapping("03000000100800000100000010010000,Twin USB Joystick,a:b2,b:b1,x:b3,y:b0,back:b8,start:b9,leftshoulder:b6,rightshoulder:b7,leftstick:b10,rightstick:b11,leftx:a0,lefty:a1,rightx:a3,righty:a2,lefttrigger:b4,righttrigger:b5,dpup:h0.1,dpleft:h0.8,dpdown:h0.4,dpright:h0.2");
+    // Mappings are handed to SDL by InputDaemon when a matching device
+    // is found.
 #endif
 
     pollRateTimer.stop();
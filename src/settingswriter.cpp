@@ -0,0 +1,119 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QMutexLocker>
+#include <QMetaObject>
+#include <QHashIterator>
+#include <QSettings>
+#include <QFile>
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+  #include <QLockFile>
+#endif
+
+#include "settingswriter.h"
+#include "common.h"
+#include "logger.h"
+
+SettingsWriter::SettingsWriter(QString fileName, QObject *parent) :
+    QObject(parent)
+{
+    this->fileName = fileName;
+    pendingWrite = false;
+}
+
+/**
+ * @brief Queue a snapshot of every setting to be written. Safe to call
+ *     from any thread. Replaces any snapshot that has not been written yet.
+ * @param Full key paths and values of all settings
+ */
+void SettingsWriter::queueSnapshot(const QHash<QString, QVariant> &snapshot)
+{
+    QMutexLocker tempLocker(&pendingLock);
+    pendingSnapshot = snapshot;
+    if (!pendingWrite)
+    {
+        pendingWrite = true;
+        QMetaObject::invokeMethod(this, "writePending", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief Write the newest queued snapshot. Runs in the writer thread.
+ */
+void SettingsWriter::writePending()
+{
+    QHash<QString, QVariant> snapshot;
+
+    pendingLock.lock();
+    bool shouldWrite = pendingWrite;
+    if (shouldWrite)
+    {
+        snapshot = pendingSnapshot;
+        pendingSnapshot.clear();
+        pendingWrite = false;
+    }
+    pendingLock.unlock();
+
+    if (shouldWrite)
+    {
+        QString targetFileName = PadderCommon::resolveReplaceTarget(fileName);
+        QString tempFileName = QString(targetFileName).append(".tmp");
+        QFile::remove(tempFileName);
+
+        bool written = false;
+        {
+            QSettings tempSettings(tempFileName, QSettings::IniFormat);
+            QHashIterator<QString, QVariant> iter(snapshot);
+            while (iter.hasNext())
+            {
+                iter.next();
+                tempSettings.setValue(iter.key(), iter.value());
+            }
+
+            tempSettings.sync();
+            written = tempSettings.status() == QSettings::NoError;
+        }
+
+        if (written)
+        {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+            // QSettings holds this lock file while it syncs the same
+            // file. Take it so the rename cannot happen in the middle of
+            // a QSettings read or write.
+            QLockFile lockFile(QString(fileName).append(".lock"));
+            if (lockFile.lock())
+            {
+                written = PadderCommon::replaceFile(tempFileName, targetFileName);
+                lockFile.unlock();
+            }
+            else
+            {
+                written = false;
+            }
+#else
+            written = PadderCommon::replaceFile(tempFileName, targetFileName);
+#endif
+        }
+
+        if (!written)
+        {
+            Logger::LogWarning(tr("Could not write settings to %1").arg(fileName));
+            QFile::remove(tempFileName);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SETTINGSWRITER_H
+#define SETTINGSWRITER_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QVariant>
+#include <QMutex>
+
+/**
+ * @brief Writes settings snapshots to disk from its own thread. Snapshots
+ *     queued before a write starts are coalesced so only the newest one
+ *     gets written. The INI file is written to a temporary file first and
+ *     then renamed over the real file.
+ */
+class SettingsWriter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SettingsWriter(QString fileName, QObject *parent = 0);
+
+    void queueSnapshot(const QHash<QString, QVariant> &snapshot);
+
+protected:
+    QString fileName;
+    QHash<QString, QVariant> pendingSnapshot;
+    bool pendingWrite;
+    QMutex pendingLock;
+
+signals:
+
+public slots:
+
+protected slots:
+    void writePending();
+};
+
+#endif // SETTINGSWRITER_H
@@ -92,7 +92,14 @@ bool JoyTabWidgetHelper::readConfigFile(QString filepath)
 
     this->reader = new XMLConfigReader;
     this->reader->setFileName(filepath);
-    this->reader->configJoystick(device);
+    this->reader->setJoystick(device);
+
+    // Only rebuild the elements that differ from the loaded profile when
+    // possible. Fall back to reading the whole profile.
+    if (!this->reader->readChanges())
+    {
+        this->reader->configJoystick(device);
+    }
 
     device->establishPropertyUpdatedConnection();
 
@@ -17,13 +17,28 @@
 
 //#include <QDebug>
 #include <QDir>
+#include <QFileInfo>
 #include <QStringList>
+#include <QBuffer>
+#include <QByteArray>
+#include <QXmlStreamWriter>
+#include <QXmlStreamAttributes>
+#include <QVector>
+#include <QtAlgorithms>
 
 #include "xmlconfigreader.h"
 #include "xmlconfigmigration.h"
 #include "xmlconfigwriter.h"
 #include "common.h"
+#include "logger.h"
 
+static bool attributeLessThan(const QXmlStreamAttribute &attr1, const QXmlStreamAttribute &attr2)
+{
+    return attr1.qualifiedName().toString() < attr2.qualifiedName().toString();
+}
+
+QHash<QString, XMLConfigReader::CachedProfile> XMLConfigReader::profileCache;
+QMutex XMLConfigReader::profileCacheLock;
 
 XMLConfigReader::XMLConfigReader(QObject *parent) :
     QObject(parent)
@@ -163,6 +178,387 @@ bool XMLConfigReader::read()
     return error;
 }
 
+/**
+ * @brief Apply the profile by only reading the set elements that differ
+ *     from the profile currently loaded on the device. Unchanged elements
+ *     keep their held outputs and acceleration state. The element map of
+ *     the file is kept per device GUID, so a device that is plugged in
+ *     again does not parse an unchanged profile file again.
+ * @return Whether the profile was applied. False when the device level
+ *     data differs or the profile is in an older format. A full read is
+ *     required in that case.
+ */
+bool XMLConfigReader::readChanges()
+{
+    bool result = false;
+    changedElements.clear();
+
+    if (configFile && configFile->exists() && joystick)
+    {
+        QHash<QString, QString> newElements;
+        QHash<QString, QString> currentElements;
+        bool usable = false;
+
+        QFileInfo fileInfo(*configFile);
+        QString cacheKey = QString("%1/%2").arg(joystick->getXmlName())
+                .arg(joystick->getGUIDString());
+
+        profileCacheLock.lock();
+        if (profileCache.contains(cacheKey))
+        {
+            CachedProfile cached = profileCache.value(cacheKey);
+            if (cached.fileName == fileInfo.absoluteFilePath() &&
+                cached.size == fileInfo.size() &&
+                cached.modified == fileInfo.lastModified())
+            {
+                newElements = cached.elements;
+                usable = true;
+            }
+        }
+        profileCacheLock.unlock();
+
+        if (!usable)
+        {
+            xml->clear();
+            if (configFile->open(QFile::ReadOnly | QFile::Text))
+            {
+                xml->setDevice(configFile);
+                xml->readNextStartElement();
+
+                int configVersion = xml->attributes().value("configversion").toString().toInt();
+                if (xml->name() == joystick->getXmlName() &&
+                    configVersion == PadderCommon::LATESTCONFIGFILEVERSION)
+                {
+                    usable = buildElementMap(xml, newElements);
+                }
+
+                configFile->close();
+            }
+
+            xml->clear();
+
+            if (usable)
+            {
+                CachedProfile cached;
+                cached.fileName = fileInfo.absoluteFilePath();
+                cached.size = fileInfo.size();
+                cached.modified = fileInfo.lastModified();
+                cached.elements = newElements;
+
+                profileCacheLock.lock();
+                profileCache.insert(cacheKey, cached);
+                profileCacheLock.unlock();
+            }
+        }
+
+        if (usable)
+        {
+            QByteArray currentProfile;
+            QBuffer buffer(&currentProfile);
+            buffer.open(QIODevice::WriteOnly);
+
+            QXmlStreamWriter writer(&buffer);
+            writer.writeStartDocument();
+            joystick->writeConfig(&writer);
+            writer.writeEndDocument();
+            buffer.close();
+
+            QXmlStreamReader currentReader(currentProfile);
+            currentReader.readNextStartElement();
+            usable = buildElementMap(&currentReader, currentElements);
+        }
+
+        if (usable && newElements.value("device") == currentElements.value("device"))
+        {
+            QStringList keys = newElements.keys();
+            QHashIterator<QString, QString> iter(currentElements);
+            while (iter.hasNext())
+            {
+                iter.next();
+                if (!newElements.contains(iter.key()))
+                {
+                    keys.append(iter.key());
+                }
+            }
+
+            keys.removeAll("device");
+            keys.removeAll("profilename");
+            keys.sort();
+
+            QHash<int, QString> setFragments;
+            QStringListIterator keyIter(keys);
+            while (keyIter.hasNext())
+            {
+                QString key = keyIter.next();
+                if (newElements.value(key) != currentElements.value(key))
+                {
+                    changedElements.append(key);
+
+                    // Key format is set<index>/<element name>/<element index>
+                    QStringList parts = key.split("/");
+                    int setIndex = parts.at(0).mid(3).toInt();
+                    SetJoystick *set = joystick->getSetJoystick(setIndex - 1);
+                    if (set)
+                    {
+                        resetSetElement(set, parts.at(1), parts.at(2).toInt());
+                        setFragments[setIndex].append(newElements.value(key));
+                    }
+                }
+            }
+
+            QHashIterator<int, QString> fragIter(setFragments);
+            while (fragIter.hasNext())
+            {
+                fragIter.next();
+                QString fragment = QString("<set index=\"%1\">").arg(fragIter.key());
+                fragment.append(fragIter.value()).append("</set>");
+
+                QXmlStreamReader setReader(fragment);
+                setReader.readNextStartElement();
+                joystick->getSetJoystick(fragIter.key() - 1)->readConfig(&setReader);
+            }
+
+            // Held elements of the active set were queued again by
+            // resetSetElement. Activate them now like reInitButtons does
+            // after a full read.
+            joystick->activatePossibleControlStickEvents();
+            joystick->activatePossibleAxisEvents();
+            joystick->activatePossibleDPadEvents();
+            joystick->activatePossibleVDPadEvents();
+            joystick->activatePossibleButtonEvents();
+
+            joystick->setProfileName(newElements.value("profilename"));
+            joystick->revertProfileEdited();
+
+            Logger::LogInfo(tr("Profile %1 applied with %2 changed elements")
+                            .arg(configFile->fileName()).arg(changedElements.size()));
+            if (Logger::getInstance()->getCurrentLogLevel() >= Logger::LOG_DEBUG)
+            {
+                Logger::LogDebug(changedElements.join(", "));
+            }
+
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Get the set elements that were changed by the last call to
+ *     readChanges.
+ * @return Element keys in the form set<index>/<element name>/<element index>
+ */
+QStringList XMLConfigReader::getChangedElements()
+{
+    return changedElements;
+}
+
+/**
+ * @brief Split a device profile into separate canonical XML strings for
+ *     every set element. Everything outside of the sets except for the
+ *     informational elements is combined under the "device" key.
+ * @param Reader positioned at the root element of the profile
+ * @param Destination for the element strings
+ * @return Whether the profile could be parsed
+ */
+bool XMLConfigReader::buildElementMap(QXmlStreamReader *reader, QHash<QString, QString> &elements)
+{
+    QString deviceElements;
+    QString rootName = reader->name().toString();
+
+    reader->readNextStartElement();
+    while (!reader->atEnd() && (!reader->isEndElement() && reader->name() != rootName))
+    {
+        if (reader->name() == "sets" && reader->isStartElement())
+        {
+            reader->readNextStartElement();
+            while (!reader->atEnd() && (!reader->isEndElement() && reader->name() != "sets"))
+            {
+                if (reader->name() == "set" && reader->isStartElement())
+                {
+                    QString setKey = QString("set%1").arg(reader->attributes().value("index").toString());
+
+                    reader->readNextStartElement();
+                    while (!reader->atEnd() && (!reader->isEndElement() && reader->name() != "set"))
+                    {
+                        QString key = QString("%1/%2/%3").arg(setKey)
+                                .arg(reader->name().toString())
+                                .arg(reader->attributes().value("index").toString().toInt());
+                        elements.insert(key, canonicalElement(reader));
+                        reader->readNextStartElement();
+                    }
+                }
+                else
+                {
+                    reader->skipCurrentElement();
+                }
+
+                reader->readNextStartElement();
+            }
+        }
+        else if (reader->name() == "profilename" && reader->isStartElement())
+        {
+            elements.insert("profilename", reader->readElementText());
+        }
+        else if ((reader->name() == "sdlname" || reader->name() == "guid") &&
+                 reader->isStartElement())
+        {
+            reader->skipCurrentElement();
+        }
+        else
+        {
+            deviceElements.append(canonicalElement(reader));
+        }
+
+        reader->readNextStartElement();
+    }
+
+    elements.insert("device", deviceElements);
+
+    return !reader->hasError() || reader->error() == QXmlStreamReader::PrematureEndOfDocumentError;
+}
+
+/**
+ * @brief Write the element at the current reader position without
+ *     comments or formatting and with sorted attributes so equal
+ *     elements always produce equal strings. The reader is left at the
+ *     end of the element.
+ */
+QString XMLConfigReader::canonicalElement(QXmlStreamReader *reader)
+{
+    QString result;
+    QXmlStreamWriter writer(&result);
+    int depth = 0;
+
+    do
+    {
+        if (reader->isStartElement())
+        {
+            QVector<QXmlStreamAttribute> attributes = reader->attributes();
+            qSort(attributes.begin(), attributes.end(), attributeLessThan);
+
+            writer.writeStartElement(reader->name().toString());
+            for (int i=0; i < attributes.size(); i++)
+            {
+                const QXmlStreamAttribute &attribute = attributes.at(i);
+                writer.writeAttribute(attribute.qualifiedName().toString(),
+                                      attribute.value().toString());
+            }
+
+            depth++;
+        }
+        else if (reader->isEndElement())
+        {
+            writer.writeEndElement();
+            depth--;
+        }
+        else if (reader->isCharacters() && !reader->isWhitespace())
+        {
+            writer.writeCharacters(reader->text().toString());
+        }
+
+        if (depth > 0)
+        {
+            reader->readNext();
+        }
+    } while (depth > 0 && !reader->atEnd());
+
+    return result;
+}
+
+/**
+ * @brief Return a set element to its default settings before its new
+ *     settings are read. The current physical state of the element is
+ *     queued again when the set is active.
+ */
+void XMLConfigReader::resetSetElement(SetJoystick *set, QString name, int index)
+{
+    bool activeSet = set == joystick->getActiveSetJoystick();
+
+    if (name == "button")
+    {
+        JoyButton *button = set->getJoyButton(index - 1);
+        if (button)
+        {
+            bool pressed = button->getButtonState();
+            button->reset();
+            if (activeSet && pressed)
+            {
+                button->queuePendingEvent(pressed);
+            }
+        }
+    }
+    else if (name == "axis" || name == "trigger")
+    {
+        int axisIndex = index - 1;
+#ifdef USE_SDL_2
+        if (name == "trigger")
+        {
+            axisIndex += SDL_CONTROLLER_AXIS_TRIGGERLEFT;
+        }
+#endif
+
+        JoyAxis *axis = set->getJoyAxis(axisIndex);
+        if (axis)
+        {
+            int value = axis->getCurrentRawValue();
+            QString axisName = axis->getAxisName();
+            axis->reset();
+            axis->setAxisName(axisName);
+            if (activeSet)
+            {
+                axis->queuePendingEvent(value);
+            }
+        }
+    }
+    else if (name == "stick")
+    {
+        JoyControlStick *stick = set->getJoyStick(index - 1);
+        if (stick)
+        {
+            QString stickName = stick->getStickName();
+            stick->reset();
+            stick->setStickName(stickName);
+            if (activeSet)
+            {
+                stick->getAxisX()->queuePendingEvent(stick->getAxisX()->getCurrentRawValue());
+                stick->getAxisY()->queuePendingEvent(stick->getAxisY()->getCurrentRawValue());
+            }
+        }
+    }
+    else if (name == "dpad" || name == "vdpad")
+    {
+        JoyDPad *dpad = 0;
+#ifdef USE_SDL_2
+        if (name == "vdpad" || joystick->getXmlName() == GameController::xmlName)
+#else
+        if (name == "vdpad")
+#endif
+        {
+            dpad = set->getVDPad(index - 1);
+        }
+        else
+        {
+            dpad = set->getJoyDPad(index - 1);
+        }
+
+        if (dpad)
+        {
+            int direction = dpad->getCurrentDirection();
+            dpad->reset();
+            if (activeSet && name == "dpad" && direction != JoyDPadButton::DpadCentered)
+            {
+                dpad->queuePendingEvent(direction);
+            }
+        }
+    }
+    else if (name == "name")
+    {
+        set->setName(QString());
+    }
+}
+
 QString XMLConfigReader::getErrorString()
 {
     QString temp;
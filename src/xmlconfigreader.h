@@ -21,6 +21,10 @@
 #include <QObject>
 #include <QXmlStreamReader>
 #include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QDateTime>
+#include <QMutex>
 
 #include "inputdevice.h"
 #include "joystick.h"
@@ -42,15 +46,34 @@ public:
     QString getErrorString();
     bool hasError();
     bool read();
+    bool readChanges();
+    QStringList getChangedElements();
 
 protected:
     void initDeviceTypes();
+    bool buildElementMap(QXmlStreamReader *reader, QHash<QString, QString> &elements);
+    QString canonicalElement(QXmlStreamReader *reader);
+    void resetSetElement(SetJoystick *set, QString name, int index);
+
+    typedef struct _CachedProfile
+    {
+        QString fileName;
+        qint64 size;
+        QDateTime modified;
+        QHash<QString, QString> elements;
+    } CachedProfile;
+
+    // Element maps of the last profile read for each device type and GUID.
+    // Used when a device is plugged in again and loads the same profile.
+    static QHash<QString, CachedProfile> profileCache;
+    static QMutex profileCacheLock;
 
     QXmlStreamReader *xml;
     QString fileName;
     QFile *configFile;
     InputDevice* joystick;
     QStringList deviceTypes;
+    QStringList changedElements;
 
 signals:
     
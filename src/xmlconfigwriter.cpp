@@ -16,32 +16,32 @@
  */
 
 #include <QDir>
+#include <QFile>
+#include <QBuffer>
+#include <QElapsedTimer>
+
+#ifdef Q_OS_UNIX
+  #include <unistd.h>
+#endif
 
 #include "xmlconfigwriter.h"
+#include "logger.h"
+
+const int XMLConfigWriter::DEFAULTBUFFERSIZE = 64 * 1024;
+
+int XMLConfigWriter::bufferSizeHint = XMLConfigWriter::DEFAULTBUFFERSIZE;
 
 XMLConfigWriter::XMLConfigWriter(QObject *parent) :
     QObject(parent)
 {
     xml = new QXmlStreamWriter();
     xml->setAutoFormatting(true);
-    configFile = 0;
     joystick = 0;
     writerError = false;
 }
 
 XMLConfigWriter::~XMLConfigWriter()
 {
-    if (configFile)
-    {
-        if (configFile->isOpen())
-        {
-            configFile->close();
-        }
-
-        delete configFile;
-        configFile = 0;
-    }
-
     if (xml)
     {
         delete xml;
@@ -49,39 +49,84 @@ XMLConfigWriter::~XMLConfigWriter()
     }
 }
 
+/**
+ * @brief Serialize a device profile into memory and then save it. The
+ *     profile file is only replaced once the complete document has been
+ *     written so a failed save leaves the old profile intact.
+ * @param Device whose profile will be saved
+ */
 void XMLConfigWriter::write(InputDevice *joystick)
 {
     writerError = false;
 
-    if (!configFile->isOpen())
-    {
-        configFile->open(QFile::WriteOnly | QFile::Text);
-        xml->setDevice(configFile);
-    }
-    else
+    QElapsedTimer saveTimer;
+    saveTimer.start();
+
+    QByteArray output;
+    output.reserve(bufferSizeHint);
+
+    QBuffer buffer(&output);
+    buffer.open(QIODevice::WriteOnly | QIODevice::Text);
+    xml->setDevice(&buffer);
+
+    xml->writeStartDocument();
+    joystick->writeConfig(xml);
+    xml->writeEndDocument();
+
+    xml->setDevice(0);
+    buffer.close();
+
+    bufferSizeHint = qMax(DEFAULTBUFFERSIZE, output.size() + (output.size() / 4));
+
+    if (!commitFile(output))
     {
         writerError = true;
-        writerErrorString = tr("Could not write to profile at %1.").arg(configFile->fileName());
+        writerErrorString = tr("Could not write to profile at %1.").arg(fileName);
     }
 
-    if (!writerError)
+    if (Logger::getInstance()->getCurrentLogLevel() >= Logger::LOG_DEBUG)
     {
-        xml->writeStartDocument();
-        joystick->writeConfig(xml);
-        xml->writeEndDocument();
+        Logger::LogDebug(QString("Saved profile %1 (%2 bytes) in %3 ms")
+                         .arg(fileName).arg(output.size()).arg(saveTimer.elapsed()));
     }
+}
 
-    if (configFile->isOpen())
+/**
+ * @brief Write a serialized profile to a temporary file next to the
+ *     profile, flush it to disk and move it over the profile. When the
+ *     profile is a symbolic link, the file it points to is replaced.
+ * @param Serialized profile
+ * @return Whether the profile was replaced
+ */
+bool XMLConfigWriter::commitFile(const QByteArray &output)
+{
+    bool result = false;
+
+    QString targetFileName = PadderCommon::resolveReplaceTarget(fileName);
+    QString tempFileName = QString(targetFileName).append(".tmp");
+    QFile tempFile(tempFileName);
+    if (tempFile.open(QFile::WriteOnly | QFile::Truncate))
     {
-        configFile->close();
+        result = tempFile.write(output) == output.size();
+        result = result && tempFile.flush();
+#ifdef Q_OS_UNIX
+        result = result && (fsync(tempFile.handle()) == 0);
+#endif
+        tempFile.close();
+
+        result = result && PadderCommon::replaceFile(tempFileName, targetFileName);
+        if (!result)
+        {
+            QFile::remove(tempFileName);
+        }
     }
+
+    return result;
 }
 
 void XMLConfigWriter::setFileName(QString filename)
 {
-    QFile *temp = new QFile(filename);
     fileName = filename;
-    configFile = temp;
 }
 
 bool XMLConfigWriter::hasError()
@@ -19,7 +19,7 @@
 #define XMLCONFIGWRITER_H
 
 #include <QObject>
-#include <QFile>
+#include <QByteArray>
 #include <QXmlStreamWriter>
 
 #include "inputdevice.h"
@@ -35,14 +35,21 @@ public:
     bool hasError();
     QString getErrorString();
 
+    static const int DEFAULTBUFFERSIZE;
+
 protected:
+    bool commitFile(const QByteArray &output);
+
     QXmlStreamWriter *xml;
     QString fileName;
-    QFile *configFile;
     InputDevice* joystick;
     bool writerError;
     QString writerErrorString;
 
+    // Size of the last written profile. Used to size the output buffer
+    // of the next save.
+    static int bufferSizeHint;
+
 signals:
     
 public slots:
@@ -0,0 +1,206 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include <QtTest>
+#include <QMap>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <SDL2/SDL_version.h>
+#include <SDL2/SDL_joystick.h>
+#include <SDL2/SDL_events.h>
+
+#include "inputdaemon.h"
+#include "antimicrosettings.h"
+#include "logger.h"
+
+// Allocations made with operator new while counting is enabled. Qt
+// containers allocate with malloc and are not counted.
+static QBasicAtomicInt allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+static QBasicAtomicInt countAllocations = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations.load())
+    {
+        allocationCount.ref();
+    }
+
+    void *result = std::malloc(size > 0 ? size : 1);
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+
+    return result;
+}
+
+void operator delete(void *ptr) Q_DECL_NOTHROW
+{
+    std::free(ptr);
+}
+
+/**
+ * @brief Daemon that is not driven by the SDL worker thread. Lets the
+ *     test handle the waiting events directly.
+ */
+class TestInputDaemon : public InputDaemon
+{
+public:
+    TestInputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks,
+                    AntiMicroSettings *settings) :
+        InputDaemon(joysticks, settings, false)
+    {
+    }
+
+    using InputDaemon::processPendingEvents;
+
+    bool isGameController(SDL_JoystickID joystickID)
+    {
+        return trackcontrollers.contains(joystickID);
+    }
+
+    static int bufferSize()
+    {
+        return EVENTBUFFERSIZE;
+    }
+};
+
+/**
+ * @brief Check that handling events in the input daemon does not
+ *     allocate once a device has been seen. Events are pushed for a
+ *     virtual joystick and stay inside the dead zone so assignments, and
+ *     the timers they start, are not involved.
+ */
+class TestInputDaemonAllocations : public QObject
+{
+    Q_OBJECT
+
+private:
+    void pushAxisEvents(SDL_JoystickID joystickID, bool gameController,
+                        int count, int value);
+
+    QTextStream logStream;
+    Logger *logger;
+    QTemporaryDir settingsDir;
+    AntiMicroSettings *settings;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void pollDoesNotAllocate();
+};
+
+void TestInputDaemonAllocations::initTestCase()
+{
+    logStream.setString(new QString());
+    logger = new Logger(&logStream, Logger::LOG_NONE);
+    QVERIFY(settingsDir.isValid());
+    settings = new AntiMicroSettings(settingsDir.path() + "/antimicro_settings.ini",
+                                     QSettings::IniFormat);
+}
+
+void TestInputDaemonAllocations::cleanupTestCase()
+{
+    delete settings;
+    delete logger;
+    delete logStream.string();
+}
+
+/**
+ * @brief Queue axis motion events in SDL. Only the first four axes are
+ *     used so game controller triggers are left alone.
+ * @param Instance ID of the device
+ * @param Whether the device was opened as a game controller
+ * @param Number of events to queue
+ * @param Axis value of the last event. Earlier events alternate signs.
+ */
+void TestInputDaemonAllocations::pushAxisEvents(SDL_JoystickID joystickID,
+                                                bool gameController,
+                                                int count, int value)
+{
+    for (int i=0; i < count; i++)
+    {
+        int tempValue = ((count - 1 - i) % 2 == 0) ? value : -value;
+        SDL_Event event;
+        SDL_memset(&event, 0, sizeof(event));
+        if (gameController)
+        {
+            event.type = SDL_CONTROLLERAXISMOTION;
+            event.caxis.which = joystickID;
+            event.caxis.axis = i % 4;
+            event.caxis.value = tempValue;
+        }
+        else
+        {
+            event.type = SDL_JOYAXISMOTION;
+            event.jaxis.which = joystickID;
+            event.jaxis.axis = i % 4;
+            event.jaxis.value = tempValue;
+        }
+
+        SDL_PushEvent(&event);
+    }
+}
+
+void TestInputDaemonAllocations::pollDoesNotAllocate()
+{
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    QMap<SDL_JoystickID, InputDevice*> joysticks;
+    TestInputDaemon daemon(&joysticks, settings);
+
+    int deviceIndex = SDL_JoystickAttachVirtual(SDL_JOYSTICK_TYPE_UNKNOWN, 6, 16, 1);
+    if (deviceIndex < 0)
+    {
+        QSKIP("Could not attach a virtual joystick.");
+    }
+
+    daemon.refreshJoysticks();
+    SDL_JoystickID joystickID = SDL_JoystickGetDeviceInstanceID(deviceIndex);
+    QVERIFY(joysticks.contains(joystickID));
+    bool gameController = daemon.isGameController(joystickID);
+
+    // More events than fit in one batch so the batch loop is used.
+    int eventCount = (TestInputDaemon::bufferSize() * 2) + 8;
+
+    // The first poll handles the events from attaching the device and
+    // creates the status entries of the device.
+    pushAxisEvents(joystickID, gameController, eventCount, 1000);
+    daemon.processPendingEvents();
+
+    pushAxisEvents(joystickID, gameController, eventCount, 2000);
+    allocationCount.store(0);
+    countAllocations.store(1);
+    daemon.processPendingEvents();
+    countAllocations.store(0);
+
+    QCOMPARE(allocationCount.load(), 0);
+    QCOMPARE(SDL_PeepEvents(0, 0, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT), 0);
+
+    JoyAxis *axis = joysticks.value(joystickID)->getActiveSetJoystick()->getJoyAxis(3);
+    QCOMPARE(axis->getCurrentRawValue(), 2000);
+#else
+    QSKIP("Virtual joysticks require SDL 2.0.14.");
+#endif
+}
+
+QTEST_GUILESS_MAIN(TestInputDaemonAllocations)
+
+#include "testinputdaemonallocations.moc"
@@ -0,0 +1,99 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TESTINPUTDEVICE_H
+#define TESTINPUTDEVICE_H
+
+#include "inputdevice.h"
+#include "joystick.h"
+
+/**
+ * @brief Input device that is not backed by SDL. Used by tests to build
+ *     a device with any number of elements.
+ */
+class TestInputDevice : public InputDevice
+{
+public:
+    TestInputDevice(int numAxes, int numButtons, int numHats,
+                    AntiMicroSettings *settings, QObject *parent=0) :
+        InputDevice(0, settings, parent)
+    {
+        this->numAxes = numAxes;
+        this->numButtons = numButtons;
+        this->numHats = numHats;
+
+        for (int i=0; i < NUMBER_JOYSETS; i++)
+        {
+            SetJoystick *setstick = new SetJoystick(this, i, this);
+            joystick_sets.insert(i, setstick);
+            enableSetConnections(setstick);
+        }
+    }
+
+    virtual QString getName()
+    {
+        return QString("Test Device");
+    }
+
+    virtual QString getSDLName()
+    {
+        return getName();
+    }
+
+    virtual QString getGUIDString()
+    {
+        return QString("03000000000000000000000000000000");
+    }
+
+    virtual QString getXmlName()
+    {
+        return Joystick::xmlName;
+    }
+
+    virtual void closeSDLDevice()
+    {
+    }
+
+#ifdef USE_SDL_2
+    virtual SDL_JoystickID getSDLJoystickID()
+    {
+        return joystickID;
+    }
+#endif
+
+    virtual int getNumberRawButtons()
+    {
+        return numButtons;
+    }
+
+    virtual int getNumberRawAxes()
+    {
+        return numAxes;
+    }
+
+    virtual int getNumberRawHats()
+    {
+        return numHats;
+    }
+
+protected:
+    int numAxes;
+    int numButtons;
+    int numHats;
+};
+
+#endif // TESTINPUTDEVICE_H
@@ -0,0 +1,283 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include <QtTest>
+#include <QVector>
+
+#include "joyextraacceleration.h"
+
+/**
+ * @brief Check the easing curves and that extra acceleration does not
+ *     depend on the mouse refresh rate.
+ */
+class TestJoyExtraAcceleration : public QObject
+{
+    Q_OBJECT
+
+private:
+    typedef struct _TickResult
+    {
+        int time;
+        double multiplier;
+    } TickResult;
+
+    QVector<TickResult> simulate(int tickInterval);
+
+    static const int POLLINTERVAL;
+    static const int RAMPEND;
+
+private slots:
+    void ease_data();
+    void ease();
+    void multiplierDuringTravel_data();
+    void multiplierDuringTravel();
+    void multiplierAfterTravel_data();
+    void multiplierAfterTravel();
+};
+
+// Gamepad poll interval in ms.
+const int TestJoyExtraAcceleration::POLLINTERVAL = 10;
+// Time in ms when the simulated stick stops moving.
+const int TestJoyExtraAcceleration::RAMPEND = 120;
+
+static JoyExtraAcceleration::Parameters testParameters()
+{
+    JoyExtraAcceleration::Parameters params;
+    params.multiplier = 2.0;
+    params.minThreshold = 2.0;
+    params.maxThreshold = 8.0;
+    params.startMultiplier = 0.0;
+    params.duration = 0.1;
+    params.curve = JoyExtraAcceleration::LinearCurve;
+    return params;
+}
+
+/**
+ * @brief Multiplier of the linear curve for the test parameters.
+ * @param Travel used for the multiplier
+ * @return Expected multiplier
+ */
+static double linearMultiplier(double travel)
+{
+    return 1.0 + ((travel - 0.02) / 0.06);
+}
+
+/**
+ * @brief Drive the acceleration state the way JoyButton does. The gamepad
+ *     is polled every POLLINTERVAL ms and the mouse is updated every
+ *     tickInterval ms. The stick moves 0.05 per poll until RAMPEND and
+ *     then holds its position.
+ * @param Mouse refresh interval in ms
+ * @return Multiplier found on every mouse tick
+ */
+QVector<TestJoyExtraAcceleration::TickResult> TestJoyExtraAcceleration::simulate(int tickInterval)
+{
+    QVector<TickResult> results;
+    JoyExtraAcceleration::Parameters params = testParameters();
+    JoyExtraAcceleration::State state;
+    JoyExtraAcceleration::resetState(state, 0);
+
+    double lastDistance = 0.0;
+    double currentDistance = 0.0;
+    double startingDistance = 0.0;
+    qint64 currentDistanceTime = 0;
+    bool updateLastDistance = false;
+    bool updateStartingDistance = true;
+
+    for (int time=0; time <= 300; time++)
+    {
+        qint64 now = time * static_cast<qint64>(1000000);
+
+        if (time % POLLINTERVAL == 0)
+        {
+            // Matches JoyButton::resetAccelerationDistances.
+            if (updateLastDistance)
+            {
+                lastDistance = currentDistance;
+                state.lastDistanceTime = currentDistanceTime;
+                updateLastDistance = false;
+            }
+
+            if (updateStartingDistance)
+            {
+                startingDistance = lastDistance;
+                updateStartingDistance = false;
+            }
+
+            JoyExtraAcceleration::advancePoll(state);
+            currentDistance = 0.005 * qMin(time, RAMPEND);
+            currentDistanceTime = now;
+        }
+
+        if (time % tickInterval == 0)
+        {
+            // Matches the start of JoyButton::mouseEvent.
+            updateLastDistance = true;
+            updateStartingDistance = true;
+
+            TickResult result;
+            result.time = time;
+            result.multiplier = JoyExtraAcceleration::calculateMultiplier(
+                        params, state, currentDistance, lastDistance, startingDistance,
+                        currentDistanceTime - state.lastDistanceTime, now,
+                        updateStartingDistance);
+            results.append(result);
+        }
+    }
+
+    return results;
+}
+
+void TestJoyExtraAcceleration::ease_data()
+{
+    QTest::addColumn<int>("curve");
+    QTest::addColumn<double>("value");
+
+    const double values[] = {-0.5, 0.0, 0.001, 0.1, 0.25, 1.0 / 3.0, 0.5,
+                             0.618, 0.75, 0.9, 0.999, 1.0, 1.5};
+    const char *curveNames[] = {"linear", "sine", "quad", "cubic"};
+
+    for (int curve=JoyExtraAcceleration::LinearCurve;
+         curve <= JoyExtraAcceleration::EaseOutCubicCurve; curve++)
+    {
+        for (unsigned int i=0; i < sizeof(values) / sizeof(values[0]); i++)
+        {
+            QTest::newRow(QString("%1 %2").arg(curveNames[curve]).arg(values[i])
+                          .toUtf8().constData()) << curve << values[i];
+        }
+    }
+}
+
+void TestJoyExtraAcceleration::ease()
+{
+    QFETCH(int, curve);
+    QFETCH(double, value);
+
+    double x = qBound(0.0, value, 1.0);
+    double expected = x;
+    switch (curve)
+    {
+        case JoyExtraAcceleration::EaseOutSineCurve:
+        {
+            expected = sin(x * (acos(-1.0) / 2.0));
+            break;
+        }
+        case JoyExtraAcceleration::EaseOutQuadCurve:
+        {
+            expected = -(x * (x - 2));
+            break;
+        }
+        case JoyExtraAcceleration::EaseOutCubicCurve:
+        {
+            expected = ((x - 1) * (x - 1) * (x - 1)) + 1;
+            break;
+        }
+    }
+
+    double result = JoyExtraAcceleration::ease(
+                static_cast<JoyExtraAcceleration::EasingCurve>(curve), value);
+
+    // Linear interpolation between 256 samples stays well within this
+    // error for all curves.
+    QVERIFY2(fabs(result - expected) < 0.00002,
+             QString("%1 != %2").arg(result, 0, 'g', 10).arg(expected, 0, 'g', 10)
+             .toUtf8().constData());
+}
+
+void TestJoyExtraAcceleration::multiplierDuringTravel_data()
+{
+    QTest::addColumn<int>("tickInterval");
+
+    QTest::newRow("1 ms") << 1;
+    QTest::newRow("4 ms") << 4;
+    QTest::newRow("16 ms") << 16;
+}
+
+void TestJoyExtraAcceleration::multiplierDuringTravel()
+{
+    QFETCH(int, tickInterval);
+
+    QVector<TickResult> results = simulate(tickInterval);
+    for (int i=0; i < results.size(); i++)
+    {
+        const TickResult &result = results.at(i);
+        double expected = 1.0;
+        if (result.time >= POLLINTERVAL && result.time < POLLINTERVAL * 2)
+        {
+            // The poll where travel is first seen gets the boost.
+            expected = linearMultiplier(0.07);
+        }
+        else if (result.time >= POLLINTERVAL * 2 && result.time < RAMPEND + POLLINTERVAL)
+        {
+            expected = linearMultiplier(0.05);
+        }
+        else if (result.time >= RAMPEND + POLLINTERVAL)
+        {
+            break;
+        }
+
+        QVERIFY2(fabs(result.multiplier - expected) < 0.000001,
+                 QString("%1 ms: %2 != %3").arg(result.time).arg(result.multiplier)
+                 .arg(expected).toUtf8().constData());
+    }
+}
+
+void TestJoyExtraAcceleration::multiplierAfterTravel_data()
+{
+    QTest::addColumn<int>("tickInterval");
+
+    QTest::newRow("1 ms") << 1;
+    QTest::newRow("4 ms") << 4;
+    QTest::newRow("16 ms") << 16;
+}
+
+void TestJoyExtraAcceleration::multiplierAfterTravel()
+{
+    QFETCH(int, tickInterval);
+
+    // Ease out is timed from the poll that sampled the last travel. The
+    // travel of 0.05 gives half of the 100 ms duration.
+    double peak = linearMultiplier(0.05);
+    double easeDuration = 50.0;
+
+    QVector<TickResult> results = simulate(tickInterval);
+    for (int i=0; i < results.size(); i++)
+    {
+        const TickResult &result = results.at(i);
+        if (result.time < RAMPEND + POLLINTERVAL)
+        {
+            continue;
+        }
+
+        double expected = 1.0;
+        double elapsed = (result.time - RAMPEND) / easeDuration;
+        if (elapsed < 1.0)
+        {
+            expected = (1.0 - peak) * (elapsed * elapsed * elapsed) + peak;
+        }
+
+        QVERIFY2(fabs(result.multiplier - expected) < 0.000001,
+                 QString("%1 ms: %2 != %3").arg(result.time).arg(result.multiplier)
+                 .arg(expected).toUtf8().constData());
+    }
+}
+
+QTEST_GUILESS_MAIN(TestJoyExtraAcceleration)
+
+#include "testjoyextraacceleration.moc"
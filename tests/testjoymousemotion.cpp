@@ -0,0 +1,110 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include <QtTest>
+
+#include "joymousemotion.h"
+
+/**
+ * @brief Check that cursor movement does not depend on the mouse
+ *     refresh rate.
+ */
+class TestJoyMouseMotion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void refreshRateSweep_data();
+    void refreshRateSweep();
+    void directionChangeDropsRemainder();
+};
+
+void TestJoyMouseMotion::refreshRateSweep_data()
+{
+    QTest::addColumn<int>("tickInterval");
+    QTest::addColumn<double>("velocity");
+
+    for (int interval=1; interval <= 16; interval++)
+    {
+        QTest::newRow(QString("%1 ms right").arg(interval).toUtf8().constData())
+                << interval << 733.3;
+        QTest::newRow(QString("%1 ms left").arg(interval).toUtf8().constData())
+                << interval << -733.3;
+    }
+}
+
+/**
+ * @brief Move the cursor at a constant velocity for one second the way
+ *     JoyButton::moveMouseCursor does without smoothing. Ticks are moved
+ *     around their nominal time to mimic timer jitter. The whole pixels
+ *     sent plus the remainder have to match the velocity.
+ */
+void TestJoyMouseMotion::refreshRateSweep()
+{
+    QFETCH(int, tickInterval);
+    QFETCH(double, velocity);
+
+    const qint64 duration = 1000000000;
+    qint64 interval = tickInterval * static_cast<qint64>(1000000);
+    qint64 lastTickTime = 0;
+    double remainder = 0.0;
+    int moved = 0;
+    int tick = 1;
+
+    while (lastTickTime < duration)
+    {
+        // Up to 0.3 ms early or late.
+        qint64 jitter = ((tick * 7919) % 601 - 300) * static_cast<qint64>(1000);
+        qint64 tickTime = qMin(duration, (tick * interval) + jitter);
+        tickTime = qMax(tickTime, lastTickTime);
+
+        double displacement = JoyMouseMotion::displacement(velocity, tickTime - lastTickTime);
+        displacement = JoyMouseMotion::carryRemainder(displacement, remainder);
+        remainder = 0.0;
+        if (fabs(displacement) > 0)
+        {
+            moved += JoyMouseMotion::takeWholePixels(displacement, remainder);
+        }
+
+        lastTickTime = tickTime;
+        tick++;
+    }
+
+    QVERIFY2(fabs((moved + remainder) - velocity) < 0.000001,
+             QString("%1 + %2 != %3").arg(moved).arg(remainder).arg(velocity)
+             .toUtf8().constData());
+    QCOMPARE(moved, static_cast<int>(velocity));
+}
+
+void TestJoyMouseMotion::directionChangeDropsRemainder()
+{
+    double remainder = 0.0;
+    QCOMPARE(JoyMouseMotion::takeWholePixels(2.75, remainder), 2);
+    QCOMPARE(remainder, 0.75);
+
+    QCOMPARE(JoyMouseMotion::carryRemainder(0.5, remainder), 1.25);
+    QCOMPARE(JoyMouseMotion::carryRemainder(-0.5, remainder), -0.5);
+
+    QCOMPARE(JoyMouseMotion::takeWholePixels(-2.75, remainder), -2);
+    QCOMPARE(remainder, -0.75);
+}
+
+QTEST_GUILESS_MAIN(TestJoyMouseMotion)
+
+#include "testjoymousemotion.moc"
@@ -0,0 +1,110 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "testinputdevice.h"
+#include "antimicrosettings.h"
+#include "logger.h"
+
+/**
+ * @brief Time set changes on a device with 8 sets. Every set holds its
+ *     own copy of each element, so the cost of a switch still grows with
+ *     the number of elements of the device.
+ */
+class TestSetSwitching : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTextStream logStream;
+    Logger *logger;
+    QTemporaryDir settingsDir;
+    AntiMicroSettings *settings;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void switchCopiesAxisValues();
+    void switchSets_data();
+    void switchSets();
+};
+
+void TestSetSwitching::initTestCase()
+{
+    logStream.setString(new QString());
+    logger = new Logger(&logStream, Logger::LOG_NONE);
+    QVERIFY(settingsDir.isValid());
+    settings = new AntiMicroSettings(settingsDir.path() + "/antimicro_settings.ini",
+                                     QSettings::IniFormat);
+}
+
+void TestSetSwitching::cleanupTestCase()
+{
+    delete settings;
+    delete logger;
+    delete logStream.string();
+}
+
+void TestSetSwitching::switchCopiesAxisValues()
+{
+    TestInputDevice testDevice(6, 16, 1, settings);
+    // Stay inside the dead zone so no assignments are triggered.
+    testDevice.getActiveSetJoystick()->getJoyAxis(2)->joyEvent(2000, true);
+
+    testDevice.setActiveSetNumber(3);
+    QCOMPARE(testDevice.getActiveSetNumber(), 3);
+    QCOMPARE(testDevice.getActiveSetJoystick()->getJoyAxis(2)->getCurrentRawValue(), 2000);
+
+    testDevice.setActiveSetNumber(0);
+    QCOMPARE(testDevice.getActiveSetNumber(), 0);
+    QCOMPARE(testDevice.getActiveSetJoystick()->getJoyAxis(2)->getCurrentRawValue(), 2000);
+}
+
+void TestSetSwitching::switchSets_data()
+{
+    QTest::addColumn<int>("axes");
+    QTest::addColumn<int>("buttons");
+    QTest::addColumn<int>("hats");
+
+    QTest::newRow("gamepad") << 6 << 16 << 1;
+    QTest::newRow("large device") << 64 << 128 << 4;
+}
+
+void TestSetSwitching::switchSets()
+{
+    QFETCH(int, axes);
+    QFETCH(int, buttons);
+    QFETCH(int, hats);
+
+    TestInputDevice testDevice(axes, buttons, hats, settings);
+    int nextSet = 1;
+
+    QBENCHMARK
+    {
+        testDevice.setActiveSetNumber(nextSet);
+        nextSet = (nextSet + 1) % InputDevice::NUMBER_JOYSETS;
+    }
+
+    QVERIFY(testDevice.getActiveSetNumber() >= 0);
+}
+
+QTEST_GUILESS_MAIN(TestSetSwitching)
+
+#include "testsetswitching.moc"
@@ -0,0 +1,181 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "testinputdevice.h"
+#include "xmlconfigwriter.h"
+#include "antimicrosettings.h"
+#include "logger.h"
+
+/**
+ * @brief Check how profiles replace the file on disk and time the save
+ *     of a large profile.
+ */
+class TestXMLConfigWriter : public QObject
+{
+    Q_OBJECT
+
+private:
+    void assignAllButtons(InputDevice *device);
+    QByteArray readFile(const QString &fileName);
+
+    QTextStream logStream;
+    Logger *logger;
+    QTemporaryDir tempDir;
+    AntiMicroSettings *settings;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void writeKeepsSymlink();
+    void writeKeepsPermissions();
+    void writeLargeProfile();
+};
+
+void TestXMLConfigWriter::initTestCase()
+{
+    logStream.setString(new QString());
+    logger = new Logger(&logStream, Logger::LOG_NONE);
+    QVERIFY(tempDir.isValid());
+    settings = new AntiMicroSettings(tempDir.path() + "/antimicro_settings.ini",
+                                     QSettings::IniFormat);
+}
+
+void TestXMLConfigWriter::cleanupTestCase()
+{
+    delete settings;
+    delete logger;
+    delete logStream.string();
+}
+
+/**
+ * @brief Assign a mouse button to every button of every set so that no
+ *     element is skipped as default when the profile is written.
+ * @param Device to change
+ */
+void TestXMLConfigWriter::assignAllButtons(InputDevice *device)
+{
+    for (int i=0; i < InputDevice::NUMBER_JOYSETS; i++)
+    {
+        SetJoystick *setstick = device->getSetJoystick(i);
+        for (int j=0; j < setstick->getNumberButtons(); j++)
+        {
+            setstick->getJoyButton(j)->setAssignedSlot((j % 3) + 1, JoyButtonSlot::JoyMouseButton);
+        }
+
+        for (int j=0; j < setstick->getNumberAxes(); j++)
+        {
+            JoyAxis *axis = setstick->getJoyAxis(j);
+            axis->getPAxisButton()->setAssignedSlot(1, JoyButtonSlot::JoyMouseButton);
+            axis->getNAxisButton()->setAssignedSlot(2, JoyButtonSlot::JoyMouseButton);
+        }
+    }
+}
+
+QByteArray TestXMLConfigWriter::readFile(const QString &fileName)
+{
+    QByteArray result;
+    QFile file(fileName);
+    if (file.open(QFile::ReadOnly))
+    {
+        result = file.readAll();
+    }
+
+    return result;
+}
+
+void TestXMLConfigWriter::writeKeepsSymlink()
+{
+#ifdef Q_OS_UNIX
+    QString realFileName = tempDir.path() + "/real.amgp";
+    QString linkFileName = tempDir.path() + "/link.amgp";
+
+    TestInputDevice device(4, 8, 1, settings);
+    XMLConfigWriter writer;
+    writer.setFileName(realFileName);
+    writer.write(&device);
+    QVERIFY(!writer.hasError());
+    QVERIFY(QFile::link(realFileName, linkFileName));
+
+    assignAllButtons(&device);
+    writer.setFileName(linkFileName);
+    writer.write(&device);
+    QVERIFY(!writer.hasError());
+
+    QVERIFY(QFileInfo(linkFileName).isSymLink());
+    QCOMPARE(QFileInfo(linkFileName).canonicalFilePath(),
+             QFileInfo(realFileName).canonicalFilePath());
+    QCOMPARE(readFile(linkFileName), readFile(realFileName));
+    QVERIFY(readFile(realFileName).contains("<slot>"));
+    QVERIFY(!QFile::exists(realFileName + ".tmp"));
+    QVERIFY(!QFile::exists(linkFileName + ".tmp"));
+#else
+    QSKIP("Symbolic links are only checked on Unix.");
+#endif
+}
+
+void TestXMLConfigWriter::writeKeepsPermissions()
+{
+#ifdef Q_OS_UNIX
+    QString fileName = tempDir.path() + "/private.amgp";
+    QFile::Permissions permissions = QFile::ReadOwner | QFile::WriteOwner |
+                                     QFile::ReadUser | QFile::WriteUser;
+
+    TestInputDevice device(4, 8, 1, settings);
+    XMLConfigWriter writer;
+    writer.setFileName(fileName);
+    writer.write(&device);
+    QVERIFY(!writer.hasError());
+    QVERIFY(QFile::setPermissions(fileName, permissions));
+
+    writer.write(&device);
+    QVERIFY(!writer.hasError());
+    QCOMPARE(QFile::permissions(fileName), permissions);
+#else
+    QSKIP("File modes are only checked on Unix.");
+#endif
+}
+
+/**
+ * @brief Time the save of a profile with 8 sets of 200 elements each.
+ *     Every button is assigned so the whole profile is written.
+ */
+void TestXMLConfigWriter::writeLargeProfile()
+{
+    // 40 axes, 150 buttons and 10 hats.
+    TestInputDevice device(40, 150, 10, settings);
+    assignAllButtons(&device);
+
+    XMLConfigWriter writer;
+    writer.setFileName(tempDir.path() + "/large.amgp");
+
+    QBENCHMARK
+    {
+        writer.write(&device);
+    }
+
+    QVERIFY(!writer.hasError());
+}
+
+QTEST_GUILESS_MAIN(TestXMLConfigWriter)
+
+#include "testxmlconfigwriter.moc"